@@ -0,0 +1,30 @@
+#ifndef XSPARSE_BENCHMARK_ALLOCATIONS_HPP
+#define XSPARSE_BENCHMARK_ALLOCATIONS_HPP
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+namespace xsparse::benchmarks
+{
+    /**
+     * @brief The number of calls to the global `operator new` so far in this process.
+     *
+     * @details Counted by the replacement allocation functions in `allocations.cpp`.
+     */
+    std::size_t allocation_count() noexcept;
+
+    /**
+     * @brief Reports the heap allocations per iteration made since `allocations_before`.
+     *
+     * @details Call with the value of `allocation_count()` taken right before the timed loop.
+     */
+    inline void set_allocation_counter(benchmark::State& state, std::size_t allocations_before)
+    {
+        state.counters["allocs/iter"] = benchmark::Counter(
+            static_cast<double>(allocation_count() - allocations_before),
+            benchmark::Counter::kAvgIterations);
+    }
+}
+
+#endif  // XSPARSE_BENCHMARK_ALLOCATIONS_HPP
@@ -0,0 +1,327 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+
+#include <xsparse/coiterate.hpp>
+#include <xsparse/levels/bitmap.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/flat_hashed.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/level_capabilities/co_iteration.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+
+#include "allocations.hpp"
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    constexpr uint8_t ZERO = 0;
+
+    constexpr auto conjunction = [](std::tuple<bool, bool> t) constexpr
+    { return std::get<0>(t) && std::get<1>(t); };
+    constexpr auto disjunction = [](std::tuple<bool, bool> t) constexpr
+    { return std::get<0>(t) || std::get<1>(t); };
+
+    using dense_level = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using compressed_level = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    using hashed_level = xsparse::levels::hashed<
+        std::tuple<>,
+        uintptr_t,
+        uintptr_t,
+        xsparse::util::container_traits<std::vector, std::unordered_set, std::unordered_map>,
+        xsparse::level_properties<false, false, false, false, false>>;
+    using flat_hashed_level = xsparse::levels::flat_hashed<std::tuple<>, uintptr_t, uintptr_t>;
+    using bitmap_level = xsparse::levels::bitmap<std::tuple<>, uintptr_t, uintptr_t>;
+
+    template <class Fn, class... Levels>
+    using coiterate_t
+        = xsparse::level_capabilities::Coiterate<xsparse::util::LambdaWrapper<Fn>::template apply,
+                                                 Fn,
+                                                 uintptr_t,
+                                                 uintptr_t,
+                                                 std::tuple<Levels...>,
+                                                 std::tuple<>,
+                                                 std::tuple<uintptr_t, uintptr_t>>;
+
+    // {dimension, density of the larger operand in per mille, nnz ratio between the operands}
+    void merge_args(benchmark::internal::Benchmark* b)
+    {
+        b->ArgsProduct({ { 1 << 12, 1 << 16, 1 << 20 }, { 10, 100, 500 }, { 1, 10, 100 } });
+    }
+
+    compressed_level make_compressed(std::vector<uintptr_t> const& crd, uintptr_t dim)
+    {
+        return compressed_level{ dim, { 0, crd.size() }, crd };
+    }
+
+    bitmap_level make_bitmap(std::vector<uintptr_t> const& crd, uintptr_t dim)
+    {
+        return bitmap_level{ dim, { 0, crd.size() }, crd };
+    }
+
+    template <class Coiter>
+    void run_merge(benchmark::State& state, Coiter& coiter, std::size_t nnz)
+    {
+        auto const allocations_before = allocation_count();
+        for (auto _ : state)
+        {
+            uintptr_t sum = 0;
+            for (auto const [ik, pk_tuple] :
+                 coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+            {
+                sum += ik + std::get<0>(pk_tuple).value_or(0) + std::get<1>(pk_tuple).value_or(0);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        set_nnz_counters(state, nnz);
+        set_allocation_counter(state, allocations_before);
+    }
+}
+
+static void BM_Coiterate_Compressed_Compressed_Conjunctive(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    auto const crd1 = make_fiber(dim, density, 1);
+    auto const crd2 = make_fiber(dim, density / state.range(2), 2);
+    auto c1 = make_compressed(crd1, dim);
+    auto c2 = make_compressed(crd2, dim);
+
+    coiterate_t<decltype(conjunction), compressed_level, compressed_level> coiter(
+        conjunction, c1, c2);
+    run_merge(state, coiter, crd1.size() + crd2.size());
+}
+BENCHMARK(BM_Coiterate_Compressed_Compressed_Conjunctive)->Apply(merge_args);
+
+static void BM_Coiterate_Compressed_Compressed_Disjunctive(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    auto const crd1 = make_fiber(dim, density, 1);
+    auto const crd2 = make_fiber(dim, density / state.range(2), 2);
+    auto c1 = make_compressed(crd1, dim);
+    auto c2 = make_compressed(crd2, dim);
+
+    coiterate_t<decltype(disjunction), compressed_level, compressed_level> coiter(
+        disjunction, c1, c2);
+    run_merge(state, coiter, crd1.size() + crd2.size());
+}
+BENCHMARK(BM_Coiterate_Compressed_Compressed_Disjunctive)->Apply(merge_args);
+
+static void BM_Coiterate_Dense_Compressed_Conjunctive(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const crd = make_fiber(dim, state.range(1) / 1000.0, 1);
+    dense_level d{ dim };
+    auto c = make_compressed(crd, dim);
+
+    coiterate_t<decltype(conjunction), dense_level, compressed_level> coiter(conjunction, d, c);
+    run_merge(state, coiter, dim + crd.size());
+}
+BENCHMARK(BM_Coiterate_Dense_Compressed_Conjunctive)
+    ->ArgsProduct({ { 1 << 12, 1 << 16, 1 << 20 }, { 10, 100, 500 } });
+
+static void BM_Coiterate_Dense_Hashed_Conjunctive(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const crd = make_fiber(dim, state.range(1) / 1000.0, 1);
+    std::unordered_map<uintptr_t, uintptr_t> map;
+    for (uintptr_t p = 0; p < crd.size(); ++p)
+    {
+        map.emplace(crd[p], p);
+    }
+    dense_level d{ dim };
+    hashed_level h{ dim, { map } };
+
+    coiterate_t<decltype(conjunction), dense_level, hashed_level> coiter(conjunction, d, h);
+    run_merge(state, coiter, dim + crd.size());
+}
+BENCHMARK(BM_Coiterate_Dense_Hashed_Conjunctive)
+    ->ArgsProduct({ { 1 << 12, 1 << 16, 1 << 20 }, { 10, 100, 500 } });
+
+static void BM_Coiterate_Compressed_Hashed_Conjunctive(benchmark::State& state)
+{
+    // the compressed operand is `ratio` times sparser than the hashed one and leads the merge
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    auto const crd1 = make_fiber(dim, density / state.range(2), 1);
+    auto const crd2 = make_fiber(dim, density, 2);
+    std::unordered_map<uintptr_t, uintptr_t> map;
+    for (uintptr_t p = 0; p < crd2.size(); ++p)
+    {
+        map.emplace(crd2[p], p);
+    }
+    auto c = make_compressed(crd1, dim);
+    hashed_level h{ dim, { map } };
+
+    coiterate_t<decltype(conjunction), compressed_level, hashed_level> coiter(conjunction, c, h);
+    run_merge(state, coiter, crd1.size() + crd2.size());
+}
+BENCHMARK(BM_Coiterate_Compressed_Hashed_Conjunctive)->Apply(merge_args);
+
+static void BM_Coiterate_Compressed_Hashed_Disjunctive(benchmark::State& state)
+{
+    // through the ordered view of the hashed level, whose fiber is sorted in the first
+    // iteration and reused by the others
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    auto const crd1 = make_fiber(dim, density, 1);
+    auto const crd2 = make_fiber(dim, density / state.range(2), 2);
+    std::unordered_map<uintptr_t, uintptr_t> map;
+    for (uintptr_t p = 0; p < crd2.size(); ++p)
+    {
+        map.emplace(crd2[p], p);
+    }
+    auto c = make_compressed(crd1, dim);
+    hashed_level h{ dim, { map } };
+    auto view = h.ordered();
+
+    coiterate_t<decltype(disjunction), compressed_level, decltype(view)> coiter(
+        disjunction, c, view);
+    run_merge(state, coiter, crd1.size() + crd2.size());
+}
+BENCHMARK(BM_Coiterate_Compressed_Hashed_Disjunctive)->Apply(merge_args);
+
+static void BM_Coiterate_Compressed_FlatHashed_Conjunctive(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    auto const crd1 = make_fiber(dim, density / state.range(2), 1);
+    auto const crd2 = make_fiber(dim, density, 2);
+    std::unordered_map<uintptr_t, uintptr_t> map;
+    for (uintptr_t p = 0; p < crd2.size(); ++p)
+    {
+        map.emplace(crd2[p], p);
+    }
+    auto c = make_compressed(crd1, dim);
+    flat_hashed_level h{ dim, { map } };
+
+    coiterate_t<decltype(conjunction), compressed_level, flat_hashed_level> coiter(
+        conjunction, c, h);
+    run_merge(state, coiter, crd1.size() + crd2.size());
+}
+BENCHMARK(BM_Coiterate_Compressed_FlatHashed_Conjunctive)->Apply(merge_args);
+
+static void BM_Coiterate_Bitmap_Bitmap_Conjunctive(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    auto const crd1 = make_fiber(dim, density, 1);
+    auto const crd2 = make_fiber(dim, density / state.range(2), 2);
+    auto b1 = make_bitmap(crd1, dim);
+    auto b2 = make_bitmap(crd2, dim);
+
+    coiterate_t<decltype(conjunction), bitmap_level, bitmap_level> coiter(conjunction, b1, b2);
+    run_merge(state, coiter, crd1.size() + crd2.size());
+}
+BENCHMARK(BM_Coiterate_Bitmap_Bitmap_Conjunctive)->Apply(merge_args);
+
+static void BM_Coiterate_Bitmap_Bitmap_Disjunctive(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    auto const crd1 = make_fiber(dim, density, 1);
+    auto const crd2 = make_fiber(dim, density / state.range(2), 2);
+    auto b1 = make_bitmap(crd1, dim);
+    auto b2 = make_bitmap(crd2, dim);
+
+    coiterate_t<decltype(disjunction), bitmap_level, bitmap_level> coiter(disjunction, b1, b2);
+    run_merge(state, coiter, crd1.size() + crd2.size());
+}
+BENCHMARK(BM_Coiterate_Bitmap_Bitmap_Disjunctive)->Apply(merge_args);
+
+namespace
+{
+    using csr_level = xsparse::levels::compressed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+    using csr_tensor = xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>>;
+
+    // {rows and columns, density in per mille}
+    void matrix_merge_args(benchmark::internal::Benchmark* b)
+    {
+        b->ArgsProduct({ { 1 << 10, 1 << 12 }, { 1, 10, 50 } });
+    }
+
+    struct csr_operand
+    {
+        csr_data m;
+        dense_level rows;
+        csr_level cols;
+        std::vector<double> data;
+
+        csr_operand(uintptr_t n, double density, std::uint64_t seed)
+            : m(make_csr(n, n, density, 0.0, seed))
+            , rows{ n }
+            , cols{ n, m.pos, m.crd }
+            , data(m.nnz(), 1.0)
+        {
+        }
+    };
+}
+
+static void BM_Coiterate_Tensor_CSR_Add(benchmark::State& state)
+{
+    auto const n = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    csr_operand a(n, density, 1), b(n, density, 2);
+    csr_tensor A(a.rows, a.cols, a.data);
+    csr_tensor B(b.rows, b.cols, b.data);
+
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        xsparse::coiterate(disjunction,
+                           [&](auto const& ij, auto const& values)
+                           {
+                               auto const& [va, vb] = values;
+                               sum += static_cast<double>(std::get<1>(ij))
+                                      + (va ? va->get() : 0.0) + (vb ? vb->get() : 0.0);
+                           },
+                           A,
+                           B);
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, a.m.nnz() + b.m.nnz());
+}
+BENCHMARK(BM_Coiterate_Tensor_CSR_Add)->Apply(matrix_merge_args);
+
+static void BM_Coiterate_Levels_CSR_Add(benchmark::State& state)
+{
+    // the same merge, threading the rows into a `Coiterate` of the column levels by hand
+    auto const n = static_cast<uintptr_t>(state.range(0));
+    double const density = state.range(1) / 1000.0;
+    csr_operand a(n, density, 1), b(n, density, 2);
+
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(disjunction)>::template apply,
+        decltype(disjunction),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<csr_level, csr_level>,
+        std::tuple<uintptr_t>,
+        std::tuple<uintptr_t, uintptr_t>>
+        coiter(disjunction, a.cols, b.cols);
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (uintptr_t r = 0; r < n; ++r)
+        {
+            for (auto const [ik, pk_tuple] :
+                 coiter.coiter_helper(std::make_tuple(r), std::make_tuple(r, r)))
+            {
+                auto const& [pa, pb] = pk_tuple;
+                sum += static_cast<double>(ik) + (pa ? a.data[*pa] : 0.0)
+                       + (pb ? b.data[*pb] : 0.0);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, a.m.nnz() + b.m.nnz());
+}
+BENCHMARK(BM_Coiterate_Levels_CSR_Add)->Apply(matrix_merge_args);
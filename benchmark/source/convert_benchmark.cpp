@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <xsparse/convert.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    using dense_level = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_level = xsparse::levels::compressed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+    using hashed_level = xsparse::levels::hashed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+    using csr_tensor = xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>>;
+}
+
+// {dimension, nonzeros per row, threads}; a transpose, whose keys are radix sorted
+static void BM_Convert_CSR_CSC(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = static_cast<double>(state.range(1)) / static_cast<double>(dim);
+    auto const m = make_csr(dim, dim, density, 0.0, 42);
+    std::vector<double> data(m.nnz(), 1.0);
+    dense_level rows{ m.rows };
+    csr_level cols{ m.cols, m.pos, m.crd };
+    csr_tensor A(rows, cols, data);
+    xsparse::util::work_stealing_pool pool(static_cast<std::size_t>(state.range(2)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        dense_level cols_t{ m.cols };
+        csr_level rows_t{ m.rows };
+        std::vector<double> data_t;
+        csr_tensor AT(cols_t, rows_t, data_t);
+        state.ResumeTiming();
+
+        xsparse::convert(A, AT, { 1, 0 }, pool);
+        benchmark::DoNotOptimize(data_t.data());
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_Convert_CSR_CSC)
+    ->ArgsProduct({ { 1 << 12, 1 << 16 }, { 4, 32 }, { 1, 4 } })
+    ->UseRealTime();
+
+// {dimension, nonzeros per row}; the columns of every row are sorted on the way
+static void BM_Convert_Hashed_CSR(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = static_cast<double>(state.range(1)) / static_cast<double>(dim);
+    auto const m = make_csr(dim, dim, density, 0.0, 42);
+    std::vector<std::unordered_map<uintptr_t, uintptr_t>> maps(m.rows);
+    for (uintptr_t r = 0; r < m.rows; ++r)
+    {
+        for (auto p = m.pos[r]; p < m.pos[r + 1]; ++p)
+        {
+            maps[r].emplace(m.crd[p], p);
+        }
+    }
+    std::vector<double> data(m.nnz(), 1.0);
+    dense_level rows{ m.rows };
+    hashed_level cols{ m.cols, maps };
+    xsparse::Tensor<std::tuple<dense_level, hashed_level>, std::vector<double>> H(rows, cols, data);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        dense_level rows_c{ m.rows };
+        csr_level cols_c{ m.cols };
+        std::vector<double> data_c;
+        csr_tensor C(rows_c, cols_c, data_c);
+        state.ResumeTiming();
+
+        xsparse::convert(H, C);
+        benchmark::DoNotOptimize(data_c.data());
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_Convert_Hashed_CSR)->ArgsProduct({ { 1 << 12, 1 << 16 }, { 4, 32 } });
@@ -0,0 +1,154 @@
+#ifndef XSPARSE_BENCHMARK_GENERATORS_HPP
+#define XSPARSE_BENCHMARK_GENERATORS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace xsparse::benchmarks
+{
+    /**
+     * @brief Draws `k` distinct coordinates from `[0, n)` and returns them sorted.
+     *
+     * @details Uses Floyd's sampling algorithm over a bitmap, so the cost is `O(k + n)`
+     * rather than a sort.
+     */
+    inline std::vector<uintptr_t> sample_sorted(uintptr_t n, uintptr_t k, std::mt19937_64& rng)
+    {
+        k = std::min(k, n);
+        std::vector<bool> mark(n, false);
+        for (uintptr_t j = n - k; j < n; ++j)
+        {
+            uintptr_t t = std::uniform_int_distribution<uintptr_t>(0, j)(rng);
+            mark[mark[t] ? j : t] = true;
+        }
+
+        std::vector<uintptr_t> crd;
+        crd.reserve(k);
+        for (uintptr_t i = 0; i < n; ++i)
+        {
+            if (mark[i])
+            {
+                crd.push_back(i);
+            }
+        }
+        return crd;
+    }
+
+    /**
+     * @brief A sorted sparse fiber of size `n` with roughly `density * n` nonzeros.
+     *
+     * @details The last coordinate `n - 1` is always present, so that all operands of a merge
+     * are exhausted on the same step and every merge runs over the full fibers.
+     */
+    inline std::vector<uintptr_t> make_fiber(uintptr_t n, double density, std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        auto nnz = static_cast<uintptr_t>(std::max(1.0, std::round(density * n)));
+        auto crd = sample_sorted(n - 1, nnz - 1, rng);
+        crd.push_back(n - 1);
+        return crd;
+    }
+
+    struct csr_data
+    {
+        uintptr_t rows, cols;
+        std::vector<uintptr_t> pos, crd;
+
+        inline uintptr_t nnz() const noexcept
+        {
+            return pos.back();
+        }
+    };
+
+    /**
+     * @brief Builds a random `rows x cols` CSR matrix with `density * rows * cols` nonzeros.
+     *
+     * @details Row `r` receives nonzeros proportional to `(r + 1)^(-skew)`, so a skew of `0`
+     * gives uniform rows while larger values concentrate the nonzeros in a few rows.
+     */
+    inline csr_data make_csr(
+        uintptr_t rows, uintptr_t cols, double density, double skew, std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<double> weights(rows);
+        for (uintptr_t r = 0; r < rows; ++r)
+        {
+            weights[r] = std::pow(static_cast<double>(r + 1), -skew);
+        }
+        double const total_weight = std::accumulate(weights.begin(), weights.end(), 0.0);
+        double const total_nnz = density * static_cast<double>(rows) * static_cast<double>(cols);
+
+        csr_data m{ rows, cols, { 0 }, {} };
+        m.pos.reserve(rows + 1);
+        for (uintptr_t r = 0; r < rows; ++r)
+        {
+            auto len = static_cast<uintptr_t>(std::round(total_nnz * weights[r] / total_weight));
+            auto row = sample_sorted(cols, std::min(len, cols), rng);
+            m.crd.insert(m.crd.end(), row.begin(), row.end());
+            m.pos.push_back(m.crd.size());
+        }
+        return m;
+    }
+
+    /**
+     * @brief The rows of a CSR matrix in a random order, so that the long rows of a skewed
+     * matrix are scattered as in an unordered graph.
+     */
+    inline csr_data shuffle_rows(csr_data const& m, std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<uintptr_t> order(m.rows);
+        std::iota(order.begin(), order.end(), uintptr_t{ 0 });
+        std::shuffle(order.begin(), order.end(), rng);
+
+        csr_data shuffled{ m.rows, m.cols, { 0 }, {} };
+        shuffled.pos.reserve(m.rows + 1);
+        shuffled.crd.reserve(m.nnz());
+        for (auto const r : order)
+        {
+            shuffled.crd.insert(shuffled.crd.end(),
+                                m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[r]),
+                                m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[r + 1]));
+            shuffled.pos.push_back(shuffled.crd.size());
+        }
+        return shuffled;
+    }
+
+    /**
+     * @brief Converts the rows of a CSR matrix into the per-fiber maps of a `hashed` level.
+     */
+    inline std::vector<std::unordered_map<uintptr_t, uintptr_t>> to_hash_maps(csr_data const& m)
+    {
+        std::vector<std::unordered_map<uintptr_t, uintptr_t>> maps(m.rows);
+        for (uintptr_t r = 0; r < m.rows; ++r)
+        {
+            for (uintptr_t p = m.pos[r]; p < m.pos[r + 1]; ++p)
+            {
+                maps[r].emplace(m.crd[p], p);
+            }
+        }
+        return maps;
+    }
+
+    /**
+     * @brief Reports the cost per visited nonzero next to the usual per-iteration timings.
+     */
+    inline void set_nnz_counters(benchmark::State& state, std::size_t nnz)
+    {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nnz));
+        state.counters["nnz"] = static_cast<double>(nnz);
+        state.counters["time/nnz"]
+            = benchmark::Counter(static_cast<double>(nnz),
+                                 benchmark::Counter::kIsIterationInvariantRate
+                                     | benchmark::Counter::kInvert);
+    }
+}
+
+#endif  // XSPARSE_BENCHMARK_GENERATORS_HPP
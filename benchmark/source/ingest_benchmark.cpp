@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/ingest.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    using dense_level = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_level = xsparse::levels::compressed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+    using csr_tensor = xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>>;
+
+    // `nnz` entries at uniformly random coordinates of a square matrix, in no order
+    struct random_triples
+    {
+        std::vector<uint32_t> rows, cols;
+        std::vector<double> values;
+
+        random_triples(std::size_t nnz, uint32_t dim)
+            : rows(nnz)
+            , cols(nnz)
+            , values(nnz, 1.0)
+        {
+            std::mt19937_64 rng(42);
+            std::uniform_int_distribution<uint32_t> coord(0, dim - 1);
+            for (std::size_t e = 0; e < nnz; ++e)
+            {
+                rows[e] = coord(rng);
+                cols[e] = coord(rng);
+            }
+        }
+    };
+}
+
+// {nonzeros, threads}; a CSR matrix of dimension 2^20 built from unsorted triples
+static void BM_Ingest_CSR(benchmark::State& state)
+{
+    constexpr uint32_t DIM = 1 << 20;
+    auto const nnz = static_cast<std::size_t>(state.range(0));
+    random_triples const input(nnz, DIM);
+    xsparse::util::work_stealing_pool pool(static_cast<std::size_t>(state.range(1)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        dense_level rows{ DIM };
+        csr_level cols{ DIM };
+        std::vector<double> data;
+        csr_tensor A(rows, cols, data);
+        state.ResumeTiming();
+
+        xsparse::ingest(A, input.rows, input.cols, input.values, std::plus<>{}, pool);
+        benchmark::DoNotOptimize(data.data());
+    }
+    set_nnz_counters(state, nnz);
+}
+BENCHMARK(BM_Ingest_CSR)
+    ->ArgsProduct({ { 1 << 16, 1 << 22 }, { 1, 4 } })
+    ->UseRealTime();
+
+// the same triples sorted with `std::sort` and appended through `Tensor::assemble`
+static void BM_Ingest_CSR_StdSort(benchmark::State& state)
+{
+    constexpr uint32_t DIM = 1 << 20;
+    auto const nnz = static_cast<std::size_t>(state.range(0));
+    random_triples const input(nnz, DIM);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        dense_level rows{ DIM };
+        csr_level cols{ DIM };
+        std::vector<double> data;
+        csr_tensor A(rows, cols, data);
+        state.ResumeTiming();
+
+        std::vector<std::tuple<uintptr_t, uintptr_t, double>> triples(nnz);
+        for (std::size_t e = 0; e < nnz; ++e)
+        {
+            triples[e] = { input.rows[e], input.cols[e], input.values[e] };
+        }
+        std::sort(triples.begin(), triples.end());
+        A.assemble(triples.begin(), triples.end());
+        benchmark::DoNotOptimize(data.data());
+    }
+    set_nnz_counters(state, nnz);
+}
+BENCHMARK(BM_Ingest_CSR_StdSort)->Arg(1 << 16)->Arg(1 << 22);
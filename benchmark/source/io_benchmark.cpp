@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <xsparse/io/binary.hpp>
+#include <xsparse/io/text.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/util/mapped_vector.hpp>
+
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    using dense_level = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_level = xsparse::levels::compressed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+    using mapped_csr_level = xsparse::levels::compressed<
+        std::tuple<dense_level>,
+        uintptr_t,
+        uintptr_t,
+        xsparse::util::
+            container_traits<xsparse::util::mapped_vector, std::unordered_set, std::unordered_map>>;
+
+    std::string save_csr(uintptr_t dim)
+    {
+        auto const m = make_csr(dim, dim, 0.05, 0.0, 42);
+        std::vector<double> data(m.nnz(), 1.0);
+        dense_level d1{ m.rows };
+        csr_level c2{ m.cols, m.pos, m.crd };
+        std::string const path = "xsparse_io_benchmark_" + std::to_string(dim) + ".bin";
+        xsparse::io::save(path,
+                          xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>>(
+                              d1, c2, data));
+        return path;
+    }
+
+    std::string matrix_market_text(uintptr_t dim)
+    {
+        auto const m = make_csr(dim, dim, 0.05, 0.0, 42);
+        std::string text = "%%MatrixMarket matrix coordinate real general\n"
+                           + std::to_string(m.rows) + " " + std::to_string(m.cols) + " "
+                           + std::to_string(m.nnz()) + "\n";
+        for (uintptr_t i = 0; i < m.rows; ++i)
+        {
+            for (uintptr_t p = m.pos[i]; p < m.pos[i + 1]; ++p)
+            {
+                text += std::to_string(i + 1) + " " + std::to_string(m.crd[p] + 1) + " "
+                        + std::to_string(0.5 * static_cast<double>(p)) + "\n";
+            }
+        }
+        return text;
+    }
+}
+
+// opening a saved CSR matrix, either mapping its arrays or copying them into vectors
+template <class Compressed, class Data>
+static void BM_Load_CSR(benchmark::State& state)
+{
+    auto const path = save_csr(static_cast<uintptr_t>(state.range(0)));
+    std::size_t nnz = 0;
+    for (auto _ : state)
+    {
+        auto loaded = xsparse::io::load<std::tuple<dense_level, Compressed>, Data>(path);
+        nnz = loaded.data.size();
+        benchmark::DoNotOptimize(loaded.data.data());
+    }
+    set_nnz_counters(state, nnz);
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_Load_CSR<mapped_csr_level, xsparse::util::mapped_vector<double>>)
+    ->Arg(1 << 10)
+    ->Arg(1 << 13);
+BENCHMARK(BM_Load_CSR<csr_level, std::vector<double>>)->Arg(1 << 10)->Arg(1 << 13);
+
+// parsing the entries of a MatrixMarket file with an iostream, line by line
+static void BM_Parse_MatrixMarket_Stream(benchmark::State& state)
+{
+    auto const text = matrix_market_text(static_cast<uintptr_t>(state.range(0)));
+    std::size_t nnz = 0;
+    for (auto _ : state)
+    {
+        std::istringstream in(text);
+        std::string line;
+        std::getline(in, line);
+        uintptr_t rows, cols;
+        in >> rows >> cols >> nnz;
+        std::vector<std::tuple<uintptr_t, uintptr_t, double>> entries(nnz);
+        for (auto& [i, j, v] : entries)
+        {
+            in >> i >> j >> v;
+            --i;
+            --j;
+        }
+        benchmark::DoNotOptimize(entries.data());
+    }
+    set_nnz_counters(state, nnz);
+}
+BENCHMARK(BM_Parse_MatrixMarket_Stream)->Arg(1 << 10)->Arg(1 << 12);
+
+// the same with `io::parse_matrix_market`, on the default pool
+static void BM_Parse_MatrixMarket(benchmark::State& state)
+{
+    auto const text = matrix_market_text(static_cast<uintptr_t>(state.range(0)));
+    std::size_t nnz = 0;
+    for (auto _ : state)
+    {
+        auto const list = xsparse::io::parse_matrix_market<uintptr_t, double>(text);
+        nnz = list.entries.size();
+        benchmark::DoNotOptimize(list.entries.data());
+    }
+    set_nnz_counters(state, nnz);
+}
+BENCHMARK(BM_Parse_MatrixMarket)->Arg(1 << 10)->Arg(1 << 12);
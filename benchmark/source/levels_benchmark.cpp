@@ -0,0 +1,290 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <xsparse/levels/bitmap.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/flat_hashed.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/levels/offset.hpp>
+#include <xsparse/levels/range.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/levels/static_dense.hpp>
+#include <xsparse/tensor.hpp>
+
+#include "allocations.hpp"
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    constexpr uint8_t ZERO = 0;
+
+    // {dimension, density in percent, skew in tenths}
+    void sparse_matrix_args(benchmark::internal::Benchmark* b)
+    {
+        for (int64_t dim : { 1 << 8, 1 << 10, 1 << 12 })
+        {
+            for (int64_t density : { 1, 10, 50 })
+            {
+                for (int64_t skew : { 0, 10 })
+                {
+                    b->Args({ dim, density, skew });
+                }
+            }
+        }
+    }
+
+    csr_data csr_from_args(benchmark::State const& state)
+    {
+        auto const dim = static_cast<uintptr_t>(state.range(0));
+        return make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42);
+    }
+}
+
+static void BM_Dense_Dense(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ dim };
+    xsparse::levels::dense<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> d2{ dim };
+
+    for (auto _ : state)
+    {
+        uintptr_t sum = 0;
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : d2.iter_helper(std::make_tuple(i1), p1))
+            {
+                sum += i2 + p2;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, dim * dim);
+}
+BENCHMARK(BM_Dense_Dense)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+static void BM_Dense_Compressed(benchmark::State& state)
+{
+    auto const m = csr_from_args(state);
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ m.rows };
+    xsparse::levels::compressed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> c2{ m.cols,
+                                                                                    m.pos,
+                                                                                    m.crd };
+
+    for (auto _ : state)
+    {
+        uintptr_t sum = 0;
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : c2.iter_helper(std::make_tuple(i1), p1))
+            {
+                sum += i2 + p2;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_Dense_Compressed)->Apply(sparse_matrix_args);
+
+static void BM_Compressed_Singleton(benchmark::State& state)
+{
+    auto const m = csr_from_args(state);
+    std::vector<uintptr_t> const pos{ 0, m.nnz() };
+    std::vector<uintptr_t> rows(m.nnz());
+    for (uintptr_t r = 0; r < m.rows; ++r)
+    {
+        std::fill(rows.begin() + m.pos[r], rows.begin() + m.pos[r + 1], r);
+    }
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> c1{ m.rows, pos, rows };
+    xsparse::levels::singleton<std::tuple<decltype(c1)>, uintptr_t, uintptr_t> s2{ m.cols,
+                                                                                   m.crd };
+
+    for (auto _ : state)
+    {
+        uintptr_t sum = 0;
+        for (auto const [i1, p1] : c1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : s2.iter_helper(std::make_tuple(i1), p1))
+            {
+                sum += i2 + p2;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_Compressed_Singleton)->Apply(sparse_matrix_args);
+
+static void BM_Dense_Hashed(benchmark::State& state)
+{
+    auto const m = csr_from_args(state);
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ m.rows };
+    xsparse::levels::hashed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> h2{ m.cols,
+                                                                                 to_hash_maps(m) };
+
+    auto const allocations_before = allocation_count();
+    for (auto _ : state)
+    {
+        uintptr_t sum = 0;
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : h2.iter_helper(std::make_tuple(i1), p1))
+            {
+                sum += i2 + p2;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, m.nnz());
+    set_allocation_counter(state, allocations_before);
+}
+BENCHMARK(BM_Dense_Hashed)->Apply(sparse_matrix_args);
+
+static void BM_Dense_FlatHashed(benchmark::State& state)
+{
+    auto const m = csr_from_args(state);
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ m.rows };
+    xsparse::levels::flat_hashed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> h2{
+        m.cols, to_hash_maps(m)
+    };
+
+    auto const allocations_before = allocation_count();
+    for (auto _ : state)
+    {
+        uintptr_t sum = 0;
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : h2.iter_helper(std::make_tuple(i1), p1))
+            {
+                sum += i2 + p2;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, m.nnz());
+    set_allocation_counter(state, allocations_before);
+}
+BENCHMARK(BM_Dense_FlatHashed)->Apply(sparse_matrix_args);
+
+static void BM_Dense_Bitmap(benchmark::State& state)
+{
+    auto const m = csr_from_args(state);
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ m.rows };
+    xsparse::levels::bitmap<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> b2{ m.cols,
+                                                                                 m.pos,
+                                                                                 m.crd };
+
+    for (auto _ : state)
+    {
+        uintptr_t sum = 0;
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : b2.iter_helper(std::make_tuple(i1), p1))
+            {
+                sum += i2 + p2;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_Dense_Bitmap)->Apply(sparse_matrix_args);
+
+static void BM_Dense_Range_Offset(benchmark::State& state)
+{
+    // a square DIA matrix: `density * dim` diagonals drawn from all `2 * dim - 1` of them
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    std::mt19937_64 rng(42);
+    auto const ndiag = std::max<uintptr_t>(1, dim * state.range(1) / 100);
+    std::vector<int32_t> offsets;
+    for (auto const d : sample_sorted(2 * dim - 1, ndiag, rng))
+    {
+        offsets.push_back(static_cast<int32_t>(d) - static_cast<int32_t>(dim - 1));
+    }
+
+    uintptr_t nnz = 0;
+    for (auto const o : offsets)
+    {
+        nnz += dim - static_cast<uintptr_t>(std::abs(o));
+    }
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ offsets.size() };
+    xsparse::levels::range<std::tuple<decltype(d1)>, uintptr_t, int32_t> r2{ dim, dim, offsets };
+    xsparse::levels::offset<std::tuple<decltype(r2), decltype(d1)>, uintptr_t, int32_t> o3{
+        dim, offsets
+    };
+
+    for (auto _ : state)
+    {
+        uintptr_t sum = 0;
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : r2.iter_helper(std::make_tuple(i1), p1))
+            {
+                for (auto const [i3, p3] : o3.iter_helper(std::make_tuple(i2, i1), p2))
+                {
+                    sum += i3 + static_cast<uintptr_t>(p3);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, nnz);
+}
+BENCHMARK(BM_Dense_Range_Offset)
+    ->ArgsProduct({ { 1 << 8, 1 << 10, 1 << 12 }, { 1, 10, 50 } });
+
+// a point cloud: `n` points of 4 components each, summed with `Tensor::for_each`
+template <class Components>
+static void points_for_each(benchmark::State& state, Components& l2)
+{
+    using points_level = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+
+    auto const n = static_cast<uintptr_t>(state.range(0));
+    std::vector<uintptr_t> const pos{ 0, n };
+    std::vector<uintptr_t> crd(n);
+    for (uintptr_t k = 0; k < n; ++k)
+    {
+        crd[k] = 2 * k;
+    }
+    points_level l1{ 2 * n, pos, crd };
+    std::vector<double> data(4 * n, 1.0);
+    xsparse::Tensor<std::tuple<points_level, Components>, std::vector<double>> A(l1, l2, data);
+
+    for (auto _ : state)
+    {
+        double sum = 0;
+        A.for_each([&](auto const& ij, double v)
+                   { sum += v * static_cast<double>(std::get<1>(ij)); });
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, 4 * n);
+}
+
+static void BM_Compressed_Dense4(benchmark::State& state)
+{
+    using points_level = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    xsparse::levels::dense<std::tuple<points_level>, uintptr_t, uintptr_t> l2{ 4 };
+    points_for_each(state, l2);
+}
+BENCHMARK(BM_Compressed_Dense4)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+static void BM_Compressed_StaticDense4(benchmark::State& state)
+{
+    using points_level = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    xsparse::levels::static_dense<std::tuple<points_level>,
+                                  uintptr_t,
+                                  uintptr_t,
+                                  std::integral_constant<std::size_t, 4>>
+        l2;
+    points_for_each(state, l2);
+}
+BENCHMARK(BM_Compressed_StaticDense4)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
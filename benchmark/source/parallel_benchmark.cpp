@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/parallel.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    using dense_level = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_level = xsparse::levels::compressed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+}
+
+// {dimension, skew in tenths, threads}; the rows of a skewed matrix hold very different numbers
+// of nonzeros, which the nnz-balanced chunks and work stealing have to even out
+static void BM_ParallelForEachNonzero_CSR(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, 0.01, state.range(1) / 10.0, 42);
+    std::vector<double> data(m.nnz(), 1.0);
+    dense_level d1{ m.rows };
+    csr_level c2{ m.cols, m.pos, m.crd };
+    xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>> t(d1, c2, data);
+    xsparse::util::work_stealing_pool pool(static_cast<std::size_t>(state.range(2)));
+
+    for (auto _ : state)
+    {
+        xsparse::parallel_for_each_nonzero(
+            t,
+            [](std::tuple<uintptr_t, uintptr_t> const& coords, double& value)
+            { value += static_cast<double>(std::get<0>(coords) + std::get<1>(coords)); },
+            pool);
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_ParallelForEachNonzero_CSR)
+    ->ArgsProduct({ { 1 << 12, 1 << 14 }, { 0, 10 }, { 1, 2, 4, 8, 16, 64 } })
+    ->UseRealTime();
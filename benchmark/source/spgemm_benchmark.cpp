@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/kernels/spgemm.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+#include <xsparse/util/workspace.hpp>
+
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    using dense_level = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_level = xsparse::levels::compressed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+    using csr_tensor = xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>>;
+}
+
+// {dimension, nonzeros per row, skew in tenths, threads}; rows with few products compared to
+// the dimension are merged in hash tables, the others in a dense accumulator
+static void BM_SpGEMM_CSR(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    double const density = static_cast<double>(state.range(1)) / static_cast<double>(dim);
+    auto const m = make_csr(dim, dim, density, state.range(2) / 10.0, 42);
+    std::vector<double> data(m.nnz(), 1.0);
+    dense_level rows{ m.rows };
+    csr_level cols{ m.cols, m.pos, m.crd };
+    csr_tensor A(rows, cols, data);
+    xsparse::util::work_stealing_pool pool(static_cast<std::size_t>(state.range(3)));
+
+    std::size_t nnz = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        dense_level rows_c{ m.rows };
+        csr_level cols_c{ m.cols };
+        std::vector<double> data_c;
+        csr_tensor C(rows_c, cols_c, data_c);
+        state.ResumeTiming();
+
+        xsparse::kernels::spgemm(A, A, C, pool);
+        nnz = data_c.size();
+        benchmark::DoNotOptimize(data_c.data());
+    }
+    set_nnz_counters(state, m.nnz());
+    state.counters["nnz_C"] = static_cast<double>(nnz);
+}
+BENCHMARK(BM_SpGEMM_CSR)
+    ->ArgsProduct({ { 1 << 12, 1 << 16 }, { 4, 32 }, { 0, 10 }, { 1, 4 } })
+    ->UseRealTime();
+
+// {dimension}; every row of a matrix with 8 nonzeros per row is scattered into one dense
+// accumulator and gathered back sorted, with a workspace that only clears what was written and
+// with a vector that is cleared and scanned in full for every row
+static void BM_Workspace_Rows(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, 8.0 / static_cast<double>(dim), 0.0, 42);
+    csr_level cols{ m.cols, m.pos, m.crd };
+    xsparse::util::workspace<uintptr_t, double> w(dim);
+
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (uintptr_t r = 0; r < m.rows; ++r)
+        {
+            w.scatter(cols.iter_helper(std::make_tuple(r), r),
+                      [](auto const& e) { return static_cast<double>(std::get<1>(e)); });
+            w.gather([&](uintptr_t ik, double v) { sum += static_cast<double>(ik) * v; });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_Workspace_Rows)->Arg(1 << 12)->Arg(1 << 16);
+
+static void BM_DenseVector_Rows(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, 8.0 / static_cast<double>(dim), 0.0, 42);
+    csr_level cols{ m.cols, m.pos, m.crd };
+    std::vector<double> values(dim);
+    std::vector<std::uint8_t> occupied(dim);
+
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (uintptr_t r = 0; r < m.rows; ++r)
+        {
+            std::fill(values.begin(), values.end(), 0.0);
+            std::fill(occupied.begin(), occupied.end(), std::uint8_t{ 0 });
+            for (auto const [ik, pk] : cols.iter_helper(std::make_tuple(r), r))
+            {
+                values[ik] += static_cast<double>(pk);
+                occupied[ik] = 1;
+            }
+            for (uintptr_t ik = 0; ik < dim; ++ik)
+            {
+                if (occupied[ik])
+                {
+                    sum += static_cast<double>(ik) * values[ik];
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_DenseVector_Rows)->Arg(1 << 12)->Arg(1 << 16);
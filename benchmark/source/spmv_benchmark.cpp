@@ -0,0 +1,347 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/kernels/spmv.hpp>
+#include <xsparse/levels/blocked.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/packed.hpp>
+#include <xsparse/levels/sell.hpp>
+#include <xsparse/tensor.hpp>
+
+#include "generators.hpp"
+
+using namespace xsparse::benchmarks;
+
+namespace
+{
+    constexpr uint8_t ZERO = 0;
+
+    using dense_level = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_level = xsparse::levels::compressed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+
+    // {dimension, density in percent, skew in tenths}
+    void spmv_args(benchmark::internal::Benchmark* b)
+    {
+        b->ArgsProduct({ { 1 << 10, 1 << 12, 1 << 14 }, { 1, 10 }, { 0, 10 } });
+    }
+
+    std::vector<double> random_values(std::size_t n, std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        std::vector<double> v(n);
+        for (auto& e : v)
+        {
+            e = dist(rng);
+        }
+        return v;
+    }
+}
+
+static void BM_SpMV_IterHelper(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42);
+    auto const data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense_level d1{ m.rows };
+    csr_level c2{ m.cols, m.pos, m.crd };
+
+    for (auto _ : state)
+    {
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            double sum = 0;
+            for (auto const [i2, p2] : c2.iter_helper(std::make_tuple(i1), p1))
+            {
+                sum += data[p2] * x[i2];
+            }
+            y[i1] = sum;
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_SpMV_IterHelper)->Apply(spmv_args);
+
+// the loops one writes by hand for CSR
+static void BM_SpMV_HandWritten(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42);
+    auto const data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+
+    for (auto _ : state)
+    {
+        for (uintptr_t i = 0; i < m.rows; ++i)
+        {
+            double sum = 0;
+            for (uintptr_t p = m.pos[i]; p < m.pos[i + 1]; ++p)
+            {
+                sum += data[p] * x[m.crd[p]];
+            }
+            y[i] = sum;
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_SpMV_HandWritten)->Apply(spmv_args);
+
+static void BM_SpMV_ForEach(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42);
+    auto data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense_level d1{ m.rows };
+    csr_level c2{ m.cols, m.pos, m.crd };
+    xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>> A(d1, c2, data);
+
+    for (auto _ : state)
+    {
+        std::fill(y.begin(), y.end(), 0.0);
+        A.for_each([&](auto const& ij, double const a)
+                   { y[std::get<0>(ij)] += a * x[std::get<1>(ij)]; });
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_SpMV_ForEach)->Apply(spmv_args);
+
+static void BM_SpMV_Kernel(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42);
+    auto data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense_level d1{ m.rows };
+    csr_level c2{ m.cols, m.pos, m.crd };
+    xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>> A(d1, c2, data);
+
+    for (auto _ : state)
+    {
+        xsparse::kernels::spmv(A, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_SpMV_Kernel)->Apply(spmv_args);
+
+static void BM_SpMV_Kernel_Narrow(benchmark::State& state)
+{
+    using dense32_level = xsparse::levels::dense<std::tuple<>, uint32_t, uint32_t>;
+    using csr32_level = xsparse::levels::compressed<std::tuple<dense32_level>, uint32_t, uint32_t>;
+
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42);
+    std::vector<uint32_t> const pos(m.pos.begin(), m.pos.end());
+    std::vector<uint32_t> const crd(m.crd.begin(), m.crd.end());
+    auto data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense32_level d1{ static_cast<uint32_t>(m.rows) };
+    csr32_level c2{ static_cast<uint32_t>(m.cols), pos, crd };
+    xsparse::Tensor<std::tuple<dense32_level, csr32_level>, std::vector<double>> A(d1, c2, data);
+
+    for (auto _ : state)
+    {
+        xsparse::kernels::spmv(A, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_SpMV_Kernel_Narrow)->Apply(spmv_args);
+
+static void BM_SpMV_Packed(benchmark::State& state)
+{
+    using packed_level
+        = xsparse::levels::packed<std::tuple<dense_level>, uintptr_t, uintptr_t>;
+
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42);
+    auto data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense_level d1{ m.rows };
+    packed_level p2{ m.cols, m.pos, m.crd };
+    xsparse::Tensor<std::tuple<dense_level, packed_level>, std::vector<double>> A(d1, p2, data);
+
+    for (auto _ : state)
+    {
+        xsparse::kernels::spmv(A, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+    state.counters["crd_bytes"] = static_cast<double>(p2.get_words().size() * sizeof(uint64_t));
+}
+BENCHMARK(BM_SpMV_Packed)->Apply(spmv_args);
+
+namespace
+{
+    constexpr uintptr_t BLOCK = 3;
+    using blocked_level = xsparse::levels::blocked<std::tuple<dense_level>,
+                                                   uintptr_t,
+                                                   uintptr_t,
+                                                   std::integral_constant<std::size_t, BLOCK>>;
+    using block_inner_level
+        = xsparse::levels::dense<std::tuple<blocked_level, dense_level>, uintptr_t, uintptr_t>;
+
+    // {dimension, density of the blocks in percent}
+    void block_args(benchmark::internal::Benchmark* b)
+    {
+        b->ArgsProduct({ { 3 << 9, 3 << 11 }, { 1, 10 } });
+    }
+
+    // the nonzeros of a matrix of 3 x 3 blocks, as CSR
+    csr_data expand_blocks(csr_data const& blocks)
+    {
+        csr_data m{ blocks.rows * BLOCK, blocks.cols * BLOCK, { 0 }, {} };
+        for (uintptr_t br = 0; br < blocks.rows; ++br)
+        {
+            for (uintptr_t r = 0; r < BLOCK; ++r)
+            {
+                for (uintptr_t b = blocks.pos[br]; b < blocks.pos[br + 1]; ++b)
+                {
+                    for (uintptr_t c = 0; c < BLOCK; ++c)
+                    {
+                        m.crd.push_back(blocks.crd[b] * BLOCK + c);
+                    }
+                }
+                m.pos.push_back(m.crd.size());
+            }
+        }
+        return m;
+    }
+}
+
+// a matrix of dense 3 x 3 blocks, as is common for FEM, stored as CSR
+static void BM_SpMV_Blocks_CSR(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const m = expand_blocks(make_csr(dim / BLOCK, dim / BLOCK, state.range(1) / 100.0, 0, 42));
+    auto data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense_level d1{ m.rows };
+    csr_level c2{ m.cols, m.pos, m.crd };
+    xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>> A(d1, c2, data);
+
+    for (auto _ : state)
+    {
+        xsparse::kernels::spmv(A, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_SpMV_Blocks_CSR)->Apply(block_args);
+
+// the same matrix as BCSR
+static void BM_SpMV_Blocks_BCSR(benchmark::State& state)
+{
+    auto const dim = static_cast<uintptr_t>(state.range(0));
+    auto const blocks = make_csr(dim / BLOCK, dim / BLOCK, state.range(1) / 100.0, 0, 42);
+    auto data = random_values(blocks.nnz() * BLOCK * BLOCK, 1);
+    auto const x = random_values(dim, 2);
+    std::vector<double> y(dim);
+    dense_level d1{ blocks.rows };
+    blocked_level b2{ dim, blocks.pos, blocks.crd };
+    block_inner_level d3{ BLOCK };
+    xsparse::Tensor<std::tuple<dense_level, blocked_level, block_inner_level>,
+                    std::vector<double>>
+        A(d1, b2, d3, data);
+
+    for (auto _ : state)
+    {
+        xsparse::kernels::spmv(A, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, data.size());
+}
+BENCHMARK(BM_SpMV_Blocks_BCSR)->Apply(block_args);
+
+namespace
+{
+    constexpr std::size_t LANES = 8;
+    using sell_level = xsparse::levels::sell<std::tuple<dense_level>,
+                                             uintptr_t,
+                                             uintptr_t,
+                                             std::integral_constant<std::size_t, LANES>>;
+
+    // {dimension, density in percent, skew in tenths}, with the rows shuffled
+    void irregular_args(benchmark::internal::Benchmark* b)
+    {
+        b->ArgsProduct({ { 1 << 12, 1 << 14 }, { 1, 10 }, { 5, 10 } });
+    }
+
+    csr_data make_irregular(benchmark::State const& state)
+    {
+        auto const dim = static_cast<uintptr_t>(state.range(0));
+        return shuffle_rows(
+            make_csr(dim, dim, state.range(1) / 100.0, state.range(2) / 10.0, 42), 7);
+    }
+}
+
+// a skewed matrix with its rows in random order, like the adjacency matrix of a graph
+static void BM_SpMV_Irregular_CSR(benchmark::State& state)
+{
+    auto const m = make_irregular(state);
+    auto data = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense_level d1{ m.rows };
+    csr_level c2{ m.cols, m.pos, m.crd };
+    xsparse::Tensor<std::tuple<dense_level, csr_level>, std::vector<double>> A(d1, c2, data);
+
+    for (auto _ : state)
+    {
+        xsparse::kernels::spmv(A, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+}
+BENCHMARK(BM_SpMV_Irregular_CSR)->Apply(irregular_args);
+
+// the same matrix as SELL-8-sigma, with sigma from the fourth argument
+static void BM_SpMV_Irregular_SELL(benchmark::State& state)
+{
+    auto const m = make_irregular(state);
+    auto const csr_values = random_values(m.nnz(), 1);
+    auto const x = random_values(m.cols, 2);
+    std::vector<double> y(m.rows);
+    dense_level d1{ m.rows };
+    sell_level s2{ m.cols, m.pos, m.crd, static_cast<std::size_t>(state.range(3)) };
+    auto data = s2.pack(csr_values);
+    xsparse::Tensor<std::tuple<dense_level, sell_level>, std::vector<double>> A(d1, s2, data);
+
+    for (auto _ : state)
+    {
+        xsparse::kernels::spmv(A, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_nnz_counters(state, m.nnz());
+    state.counters["padding"] = static_cast<double>(data.size() - m.nnz());
+}
+BENCHMARK(BM_SpMV_Irregular_SELL)
+    ->ArgsProduct({ { 1 << 12, 1 << 14 }, { 1, 10 }, { 5, 10 }, { 1, 8 * LANES, 1 << 14 } });
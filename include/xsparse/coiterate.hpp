@@ -0,0 +1,377 @@
+#ifndef XSPARSE_COITERATE_HPP
+#define XSPARSE_COITERATE_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <xsparse/level_capabilities/co_iteration.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+
+namespace xsparse
+{
+    namespace detail
+    {
+        template <std::size_t Mask, std::size_t J>
+        inline constexpr std::size_t nth_set_bit() noexcept
+        {
+            std::size_t mask = Mask;
+            for (std::size_t j = 0; j < J; ++j)
+            {
+                mask &= mask - 1;
+            }
+            return static_cast<std::size_t>(std::countr_zero(mask));
+        }
+
+        template <std::size_t Mask, std::size_t... J>
+        inline constexpr auto mask_indices_impl([[maybe_unused]] std::index_sequence<J...> j)
+        {
+            return std::index_sequence<nth_set_bit<Mask, J>()...>{};
+        }
+
+        /**
+         * @brief The indices of the set bits of `Mask`, in increasing order.
+         */
+        template <std::size_t Mask>
+        using mask_indices = decltype(mask_indices_impl<Mask>(
+            std::make_index_sequence<static_cast<std::size_t>(std::popcount(Mask))>{}));
+
+        /**
+         * @brief The boolean function `Fn` of `N` operands, as a function of only the operands
+         * in `Mask`, with the others fixed to false.
+         *
+         * @details Operands drop out of a disjunctive merge below the coordinates they do not
+         * have, and the levels of the remaining operands are merged with this function.
+         */
+        template <class Fn, std::size_t N, std::size_t Mask>
+        struct masked_predicate
+        {
+            template <class... B>
+            constexpr bool operator()(std::tuple<B...> const& present) const noexcept
+            {
+                return expand(present, std::make_index_sequence<N>{});
+            }
+
+        private:
+            template <std::size_t T, class Present>
+            static constexpr bool arg(Present const& present) noexcept
+            {
+                if constexpr (((Mask >> T) & 1) == 1)
+                {
+                    constexpr auto rank = static_cast<std::size_t>(
+                        std::popcount(Mask & ((std::size_t{ 1 } << T) - 1)));
+                    return static_cast<bool>(std::get<rank>(present));
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            template <class Present, std::size_t... T>
+            static constexpr bool expand(Present const& present,
+                                         [[maybe_unused]] std::index_sequence<T...> t) noexcept
+            {
+                constexpr Fn fn{};
+                return fn(std::tuple<decltype(T, true)...>(arg<T>(present)...));
+            }
+        };
+
+        template <class Fn, std::size_t N, std::size_t Mask, std::size_t... J>
+        inline constexpr bool can_hold_impl([[maybe_unused]] std::index_sequence<J...> j)
+        {
+            return masked_predicate<Fn, N, Mask>{}(std::make_tuple(((void) J, true)...));
+        }
+
+        /**
+         * @brief Whether `Fn` can hold with only the operands in `Mask` present, which is
+         * checked with all of them present; e.g. never for a conjunction with a missing
+         * operand.
+         */
+        template <class Fn, std::size_t N, std::size_t Mask>
+        inline constexpr bool can_hold
+            = Mask != 0
+              && can_hold_impl<Fn, N, Mask>(
+                  std::make_index_sequence<static_cast<std::size_t>(std::popcount(Mask))>{});
+
+        template <class Tensor>
+        using levels_of = std::remove_cv_t<
+            std::remove_reference_t<decltype(std::declval<Tensor const&>().get_levels())>>;
+
+        template <std::size_t K, class Tensor>
+        using level_at
+            = std::remove_cv_t<std::remove_reference_t<std::tuple_element_t<K, levels_of<Tensor>>>>;
+
+        template <class Tensor>
+        using value_of
+            = std::remove_reference_t<decltype(std::declval<Tensor const&>().get_data()[0])>;
+
+        template <std::size_t Mask, std::size_t S, class G>
+        inline void call_with_submask(G& g)
+        {
+            if constexpr ((S & ~Mask) == 0)
+            {
+                g(std::integral_constant<std::size_t, S>{});
+            }
+        }
+
+        template <std::size_t Mask, class G>
+        inline void dispatch_mask(std::size_t mask, G& g)
+        /**
+         * @brief Calls `g` with the runtime `mask`, a subset of `Mask`, as a compile-time
+         * constant.
+         *
+         * @details A `switch` over the masks of up to 4 operands, which compiles to a jump
+         * table into the inlined calls; the cases that are not subsets of `Mask` are empty.
+         */
+        {
+            static_assert(Mask < 16, "Masks of up to 4 operands");
+            switch (mask)
+            {
+                case 1:
+                    return call_with_submask<Mask, 1>(g);
+                case 2:
+                    return call_with_submask<Mask, 2>(g);
+                case 3:
+                    return call_with_submask<Mask, 3>(g);
+                case 4:
+                    return call_with_submask<Mask, 4>(g);
+                case 5:
+                    return call_with_submask<Mask, 5>(g);
+                case 6:
+                    return call_with_submask<Mask, 6>(g);
+                case 7:
+                    return call_with_submask<Mask, 7>(g);
+                case 8:
+                    return call_with_submask<Mask, 8>(g);
+                case 9:
+                    return call_with_submask<Mask, 9>(g);
+                case 10:
+                    return call_with_submask<Mask, 10>(g);
+                case 11:
+                    return call_with_submask<Mask, 11>(g);
+                case 12:
+                    return call_with_submask<Mask, 12>(g);
+                case 13:
+                    return call_with_submask<Mask, 13>(g);
+                case 14:
+                    return call_with_submask<Mask, 14>(g);
+                case 15:
+                    return call_with_submask<Mask, 15>(g);
+                default:
+                    // no operand has the coordinate, which a merge never yields
+                    return;
+            }
+        }
+
+        template <std::size_t Mask, std::size_t T, class Tensors, std::size_t N>
+        inline std::optional<std::reference_wrapper<value_of<std::tuple_element_t<T, Tensors>>>>
+        value_at(Tensors const& tensors, std::array<std::size_t, N> const& pk) noexcept
+        {
+            if constexpr (((Mask >> T) & 1) == 1)
+            {
+                return std::ref(std::get<T>(tensors).get_data()[pk[T]]);
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        template <std::size_t Mask, class Tensors, std::size_t N, std::size_t... T>
+        inline auto values_at(Tensors const& tensors,
+                              std::array<std::size_t, N> const& pk,
+                              [[maybe_unused]] std::index_sequence<T...> t) noexcept
+        /**
+         * @brief References to the values at positions `pk` of the operands in `Mask`, and
+         * `std::nullopt` for the others.
+         */
+        {
+            return std::make_tuple(value_at<Mask, T>(tensors, pk)...);
+        }
+
+        template <std::size_t N, class PKs, std::size_t... P, std::size_t... J>
+        inline std::size_t present_positions(PKs const& pks,
+                                             std::array<std::size_t, N>& pk,
+                                             [[maybe_unused]] std::index_sequence<P...> p,
+                                             [[maybe_unused]] std::index_sequence<J...> j) noexcept
+        /**
+         * @brief Stores the positions `pks` of the operands `P...` that have the current
+         * coordinate into `pk` and returns the mask of these operands.
+         */
+        {
+            std::size_t mask = 0;
+            (
+                [&]
+                {
+                    if (auto const& pk_j = std::get<J>(pks); pk_j.has_value())
+                    {
+                        pk[P] = static_cast<std::size_t>(*pk_j);
+                        mask |= std::size_t{ 1 } << P;
+                    }
+                }(),
+                ...);
+            return mask;
+        }
+
+        template <std::size_t K,
+                  std::size_t Mask,
+                  class Fn,
+                  class Tensors,
+                  class F,
+                  std::size_t N,
+                  class... Coords>
+        inline void coiterate_below(Tensors const& tensors,
+                                    F& f,
+                                    std::array<std::size_t, N> const& pkm1,
+                                    Coords const... coords);
+
+        template <std::size_t K,
+                  std::size_t Mask,
+                  class Fn,
+                  class Tensors,
+                  class F,
+                  std::size_t N,
+                  std::size_t... P,
+                  class... Coords>
+        inline void coiterate_level(Tensors const& tensors,
+                                    F& f,
+                                    std::array<std::size_t, N> const& pkm1,
+                                    [[maybe_unused]] std::index_sequence<P...> p,
+                                    Coords const... coords)
+        /**
+         * @brief Merges level `K` of the operands `P...` below their positions `pkm1` and
+         * descends into the next level with the operands that have each merged coordinate.
+         */
+        {
+            constexpr std::size_t first
+                = std::get<0>(std::array<std::size_t, sizeof...(P)>{ P... });
+            using FirstTraits =
+                typename level_at<K, std::tuple_element_t<first, Tensors>>::BaseTraits;
+            using IKK = typename level_at<K, std::tuple_element_t<0, Tensors>>::BaseTraits::IK;
+            using Predicate = masked_predicate<Fn, N, Mask>;
+
+            level_capabilities::Coiterate<
+                util::LambdaWrapper<Predicate>::template apply,
+                Predicate,
+                typename FirstTraits::IK,
+                typename FirstTraits::PK,
+                std::tuple<level_at<K, std::tuple_element_t<P, Tensors>>...>,
+                typename FirstTraits::I,
+                std::tuple<
+                    typename level_at<K, std::tuple_element_t<P, Tensors>>::BaseTraits::PKM1...>>
+                coiter(Predicate{}, std::get<K>(std::get<P>(tensors).get_levels())...);
+
+            auto const i = lower_coords<typename FirstTraits::I>(std::forward_as_tuple(coords...),
+                                                                  std::make_index_sequence<K>{});
+            auto const parents = std::make_tuple(
+                static_cast<
+                    typename level_at<K, std::tuple_element_t<P, Tensors>>::BaseTraits::PKM1>(
+                    pkm1[P])...);
+
+            for (auto const [ik, pks] : coiter.coiter_helper(i, parents))
+            {
+                std::array<std::size_t, N> pk{};
+                auto const mask = present_positions(pks,
+                                                    pk,
+                                                    std::index_sequence<P...>{},
+                                                    std::index_sequence_for<decltype(P)...>{});
+                auto descend = [&](auto present)
+                {
+                    coiterate_below<K + 1, decltype(present)::value, Fn>(
+                        tensors, f, pk, coords..., static_cast<IKK>(ik));
+                };
+                if constexpr (std::popcount(Mask) == 1)
+                {
+                    // a single operand has every coordinate it yields
+                    descend(std::integral_constant<std::size_t, Mask>{});
+                }
+                else
+                {
+                    dispatch_mask<Mask>(mask, descend);
+                }
+            }
+        }
+
+        template <std::size_t K,
+                  std::size_t Mask,
+                  class Fn,
+                  class Tensors,
+                  class F,
+                  std::size_t N,
+                  class... Coords>
+        inline void coiterate_below(Tensors const& tensors,
+                                    F& f,
+                                    std::array<std::size_t, N> const& pkm1,
+                                    Coords const... coords)
+        /**
+         * @brief Calls `f(coords, values)` for every merged entry below the positions `pkm1`
+         * of the operands in `Mask` at level `K - 1`, whose coordinates are `coords`.
+         *
+         * @details `Mask` is a compile-time constant, so that each combination of operands is
+         * merged by its own instantiation of `Coiterate`, and combinations for which `Fn`
+         * cannot hold (e.g. any but all of them for a conjunction) are never visited.
+         */
+        {
+            if constexpr (!can_hold<Fn, N, Mask>)
+            {
+                return;
+            }
+            else if constexpr (K == std::tuple_size_v<levels_of<std::tuple_element_t<0, Tensors>>>)
+            {
+                f(std::tuple<Coords...>(coords...),
+                  values_at<Mask>(tensors, pkm1, std::make_index_sequence<N>{}));
+            }
+            else
+            {
+                coiterate_level<K, Mask, Fn>(tensors, f, pkm1, mask_indices<Mask>{}, coords...);
+            }
+        }
+    }
+
+    template <class Fn, class F, class... Tensors>
+    inline void coiterate([[maybe_unused]] Fn fn, F&& f, Tensors const&... tensors)
+    /**
+     * @brief Calls `f(coords, values)` for every coordinate of the merge of `tensors` for
+     * which the boolean function `fn` of the operands that have it holds, in the order of the
+     * levels.
+     *
+     * @details `fn` takes a tuple of one boolean per tensor, as for
+     * `level_capabilities::Coiterate`, e.g. `std::get<0>(t) || std::get<1>(t)` to add and
+     * `std::get<0>(t) && std::get<1>(t)` to multiply two tensors elementwise. It must be
+     * constexpr and capture nothing.
+     *
+     * The tensors must have the same number of levels, of the same sizes, in the same mode
+     * order. Level `K` of all the operands present at the coordinates of levels `0..K-1` is
+     * merged with `Coiterate`, and the positions it yields are the parent positions of level
+     * `K + 1`; an operand missing at a coordinate is left out of the merges below it. `coords`
+     * is a tuple with one coordinate per level, of the coordinate types of the first tensor,
+     * and `values` a tuple with a `std::optional<std::reference_wrapper<V>>` per tensor,
+     * empty for the tensors without an entry at `coords`.
+     *
+     * At most 4 tensors can be merged: every combination of operands that can be present
+     * below a coordinate is merged by its own instantiation, which makes about `3^N`
+     * instantiations of the levels below the first for a disjunction of `N` tensors.
+     */
+    {
+        constexpr std::size_t N = sizeof...(Tensors);
+        static_assert(N > 0 && N <= 4, "Coiterate over 1 to 4 tensors");
+        static_assert(((std::tuple_size_v<detail::levels_of<Tensors>>
+                        == std::tuple_size_v<detail::levels_of<
+                            std::tuple_element_t<0, std::tuple<Tensors...>>>>)
+                       && ...),
+                      "The tensors must have the same number of levels");
+
+        std::array<std::size_t, N> const root{};
+        detail::coiterate_below<0, (std::size_t{ 1 } << N) - 1, Fn>(
+            std::forward_as_tuple(tensors...), f, root);
+    }
+}
+
+#endif  // XSPARSE_COITERATE_HPP
@@ -0,0 +1,223 @@
+#ifndef XSPARSE_CONVERT_HPP
+#define XSPARSE_CONVERT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xsparse/level_capabilities/assembly.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/base_traits.hpp>
+#include <xsparse/util/radix_sort.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+namespace xsparse
+{
+    namespace detail
+    {
+        template <std::size_t N, class Coords, std::size_t... J>
+        inline std::array<std::size_t, N> coords_array(
+            Coords const& coords, [[maybe_unused]] std::index_sequence<J...> j) noexcept
+        {
+            return { static_cast<std::size_t>(std::get<J>(coords))... };
+        }
+
+        template <class Coordinates, std::size_t N, std::size_t... K>
+        inline Coordinates permuted_coords(std::array<std::size_t, N> const& coords,
+                                           std::array<std::size_t, N> const& modes,
+                                           [[maybe_unused]] std::index_sequence<K...> k) noexcept
+        /**
+         * @brief The coordinates of a destination entry, whose level `K` takes the
+         * coordinate of mode `modes[K]` of the source entry `coords`.
+         */
+        {
+            return Coordinates(
+                static_cast<std::tuple_element_t<K, Coordinates>>(coords[modes[K]])...);
+        }
+
+        template <class Coordinates, std::size_t N, std::size_t... K>
+        inline Coordinates unpacked_coords(std::uint64_t key,
+                                           std::array<unsigned, N> const& shift,
+                                           std::array<std::uint64_t, N> const& mask,
+                                           [[maybe_unused]] std::index_sequence<K...> k) noexcept
+        {
+            return Coordinates(
+                static_cast<std::tuple_element_t<K, Coordinates>>((key >> shift[K]) & mask[K])...);
+        }
+    }
+
+    /**
+     * @brief Converts the tensor `src` to the format of `dst`, whose level `k` holds mode
+     * `modes[k]` of `src`, e.g. `{ 1, 0 }` turns a CSR matrix into a CSC one.
+     *
+     * @details The entries of `src` are visited with `Tensor::for_each` and handed to the
+     * levels of `dst` through `level_capabilities::Assemble`, in the lexicographic order of
+     * their destination coordinates. They are only sorted if `dst` has a level that is
+     * appended to, unless `src` is ordered in every level and keeps its modes in place, since
+     * it is then visited in that order already. If the destination coordinates fit together
+     * in 64 bits, every entry is packed into one key, with the coordinate of the outermost
+     * level in the highest bits, and the keys are sorted with the parallel
+     * `util::radix_sort` over `pool`; otherwise the entries are sorted with
+     * `std::stable_sort`. When `src` is ordered, the entries already come sorted by the
+     * trailing levels of `dst` whose modes are increasing, e.g. the rows of a CSR matrix
+     * that becomes CSC, and the radix sort only passes over the bits of the other levels.
+     *
+     * The levels of `dst` must be constructed with their sizes and be otherwise empty, as
+     * for `Tensor::assemble`.
+     *
+     * @param src - the tensor to convert.
+     * @param dst - the empty result, whose level `k` has the size of mode `modes[k]` of
+     * `src`.
+     * @param modes - a permutation of the modes of `src`.
+     *
+     * @throws std::invalid_argument if `modes` is not a permutation, the shapes do not match
+     * or the data of `dst` is not empty.
+     */
+    template <class... SrcLevels, class SrcData, class... DstLevels, class DstData>
+    inline void convert(Tensor<std::tuple<SrcLevels...>, SrcData> const& src,
+                        Tensor<std::tuple<DstLevels...>, DstData>& dst,
+                        std::array<std::size_t, sizeof...(SrcLevels)> const& modes,
+                        util::work_stealing_pool& pool = util::default_pool())
+    {
+        constexpr std::size_t N = sizeof...(SrcLevels);
+        static_assert(sizeof...(DstLevels) == N,
+                      "The tensors must have the same number of levels");
+        using Coordinates = std::tuple<util::coordinate_t<DstLevels>...>;
+        using V = typename DstData::value_type;
+        using Assembler = level_capabilities::Assemble<std::tuple<DstLevels...>, DstData>;
+        constexpr auto levels = std::make_index_sequence<N>{};
+
+        std::array<bool, N> seen{};
+        for (auto const mode : modes)
+        {
+            if (mode >= N || seen[mode])
+            {
+                throw std::invalid_argument("`modes` must be a permutation of the modes");
+            }
+            seen[mode] = true;
+        }
+        auto const src_shape = detail::coords_array<N>(src.shape(), levels);
+        auto const dst_shape = detail::coords_array<N>(dst.shape(), levels);
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            if (dst_shape[k] != src_shape[modes[k]])
+            {
+                throw std::invalid_argument("Level `k` of `dst` must have the size of mode "
+                                            "`modes[k]` of `src`");
+            }
+        }
+        if (!dst.get_data().empty())
+        {
+            throw std::invalid_argument("`dst` must be empty");
+        }
+
+        auto& data = dst.get_data();
+        auto assembler = std::apply([&](auto&... dst_levels)
+                                    { return Assembler(dst_levels..., data); },
+                                    dst.get_levels());
+        auto const dst_coords = [&](auto const& coords)
+        {
+            return detail::permuted_coords<Coordinates>(
+                detail::coords_array<N>(coords, levels), modes, levels);
+        };
+
+        std::array<std::size_t, N> identity;
+        std::iota(identity.begin(), identity.end(), std::size_t{ 0 });
+        constexpr bool appends = (has_append_coord_v<DstLevels> || ...);
+        constexpr bool src_ordered = (SrcLevels::LevelProperties::is_ordered && ...);
+        if (!appends || (src_ordered && modes == identity))
+        {
+            src.for_each([&](auto const& coords, auto const& value)
+                         { assembler.append(dst_coords(coords), static_cast<V>(value)); });
+            assembler.finalize();
+            return;
+        }
+
+        // the bits of every destination coordinate within a packed key; coordinates that are
+        // always zero take no bits, and their shift is only kept in range
+        std::array<unsigned, N> shift{};
+        std::array<std::uint64_t, N> mask{};
+        unsigned bits = 0;
+        for (std::size_t k = N; k-- > 0;)
+        {
+            auto const largest = std::max<std::size_t>(dst_shape[k], 1) - 1;
+            auto const width
+                = static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(largest)));
+            shift[k] = std::min(bits, 63u);
+            mask[k] = width == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << width) - 1;
+            bits += width;
+        }
+
+        if (bits <= 64)
+        {
+            // the trailing levels whose modes are increasing are visited in order in `src`
+            std::size_t sorted_from = N;
+            while (src_ordered && sorted_from > 0
+                   && (sorted_from == N || modes[sorted_from - 1] < modes[sorted_from]))
+            {
+                --sorted_from;
+            }
+            unsigned const low_bit = sorted_from == 0 ? bits : shift[sorted_from - 1];
+
+            std::vector<std::uint64_t> keys;
+            std::vector<V> values;
+            keys.reserve(src.get_data().size());
+            values.reserve(src.get_data().size());
+            src.for_each(
+                [&](auto const& coords, auto const& value)
+                {
+                    auto const c = detail::coords_array<N>(coords, levels);
+                    std::uint64_t key = 0;
+                    for (std::size_t k = 0; k < N; ++k)
+                    {
+                        key |= static_cast<std::uint64_t>(c[modes[k]]) << shift[k];
+                    }
+                    keys.push_back(key);
+                    values.push_back(static_cast<V>(value));
+                });
+            util::radix_sort(keys, values, low_bit, bits, pool);
+            for (std::size_t e = 0; e < keys.size(); ++e)
+            {
+                assembler.append(
+                    detail::unpacked_coords<Coordinates>(keys[e], shift, mask, levels),
+                    values[e]);
+            }
+        }
+        else
+        {
+            std::vector<std::pair<Coordinates, V>> entries;
+            src.for_each([&](auto const& coords, auto const& value)
+                         { entries.emplace_back(dst_coords(coords), static_cast<V>(value)); });
+            std::stable_sort(entries.begin(),
+                             entries.end(),
+                             [](auto const& a, auto const& b) { return a.first < b.first; });
+            for (auto const& [coords, value] : entries)
+            {
+                assembler.append(coords, value);
+            }
+        }
+        assembler.finalize();
+    }
+
+    template <class... SrcLevels, class SrcData, class... DstLevels, class DstData>
+    inline void convert(Tensor<std::tuple<SrcLevels...>, SrcData> const& src,
+                        Tensor<std::tuple<DstLevels...>, DstData>& dst,
+                        util::work_stealing_pool& pool = util::default_pool())
+    /**
+     * @brief Converts the tensor `src` to the format of `dst`, keeping the modes in place.
+     */
+    {
+        std::array<std::size_t, sizeof...(SrcLevels)> modes;
+        std::iota(modes.begin(), modes.end(), std::size_t{ 0 });
+        convert(src, dst, modes, pool);
+    }
+}
+
+#endif  // XSPARSE_CONVERT_HPP
@@ -0,0 +1,241 @@
+#ifndef XSPARSE_INGEST_HPP
+#define XSPARSE_INGEST_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/radix_sort.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+namespace xsparse
+{
+    namespace detail
+    {
+        template <class F>
+        inline void parallel_chunks(std::size_t n, util::work_stealing_pool& pool, F&& f)
+        /**
+         * @brief Calls `f(begin, end)` for a few chunks per thread of `pool` that split
+         * `[0, n)`.
+         */
+        {
+            // chunks smaller than this are not worth a task
+            constexpr std::size_t MIN_CHUNK = std::size_t{ 1 } << 14;
+            std::size_t const num_chunks
+                = std::max<std::size_t>(1, std::min(n / MIN_CHUNK, 4 * pool.size()));
+            pool.parallel_for(num_chunks,
+                              [&](std::size_t c)
+                              { f(c * n / num_chunks, (c + 1) * n / num_chunks); });
+        }
+
+        template <class Container>
+        inline Container container_of_size(std::size_t n)
+        {
+            Container c;
+            c.resize(n);
+            return c;
+        }
+    }
+
+    /**
+     * @brief Builds the empty matrix `dst` from the unsorted entries
+     * `(rows[e], cols[e], values[e])`, in COO `(compressed, singleton)` or CSR
+     * `(dense, compressed)` format.
+     *
+     * @details Every entry is packed into a 64-bit key, with its row in the high bits, and the
+     * keys are sorted together with the values by the parallel `util::radix_sort` over `pool`.
+     * Entries with the same coordinates are then merged into one, whose value is
+     * `reduce(reduce(v0, v1), v2)...` in the order in which they were given. Finally the
+     * `pos` and `crd` arrays of the levels are written directly, in parallel, and the levels
+     * of `dst` are replaced by levels constructed from them, so no level is appended to entry
+     * by entry.
+     *
+     * The radix sort needs a second buffer of keys and values, and the caller's arrays can be
+     * released as soon as this returns.
+     *
+     * @param dst - the matrix to build, whose levels have their sizes and are otherwise empty.
+     * @param rows - the row of every entry, e.g. a `std::vector`.
+     * @param cols - the column of every entry.
+     * @param values - the value of every entry.
+     * @param reduce - merges the values of entries with the same coordinates.
+     *
+     * @throws std::invalid_argument if the arrays do not have the same length, a coordinate
+     * is out of range, the row and column do not fit together in 64 bits or `dst` is not
+     * empty.
+     */
+    template <class Outer,
+              class Inner,
+              class Data,
+              class Rows,
+              class Cols,
+              class Values,
+              class Reduce = std::plus<>>
+    inline void ingest(Tensor<std::tuple<Outer, Inner>, Data>& dst,
+                       Rows const& rows,
+                       Cols const& cols,
+                       Values const& values,
+                       Reduce reduce = {},
+                       util::work_stealing_pool& pool = util::default_pool())
+    {
+        constexpr bool is_coo = util::is_specialization_of_v<Outer, levels::compressed>
+                                && util::is_specialization_of_v<Inner, levels::singleton>;
+        constexpr bool is_csr = util::is_specialization_of_v<Outer, levels::dense>
+                                && util::is_specialization_of_v<Inner, levels::compressed>;
+        static_assert(is_coo || is_csr,
+                      "The levels must be (compressed, singleton) or (dense, compressed)");
+        using V = typename Data::value_type;
+
+        auto [outer, inner] = dst.get_levels();
+        auto& data = dst.get_data();
+        std::size_t const n = rows.size();
+        if (cols.size() != n || values.size() != n)
+        {
+            throw std::invalid_argument("`rows`, `cols` and `values` must have the same length");
+        }
+        if (!data.empty() || !inner.get_crd().empty())
+        {
+            throw std::invalid_argument("`dst` must be empty");
+        }
+
+        auto const num_rows = static_cast<std::uint64_t>(outer.size());
+        auto const num_cols = static_cast<std::uint64_t>(inner.size());
+        auto const bits_for = [](std::uint64_t size)
+        { return static_cast<unsigned>(std::bit_width(std::max<std::uint64_t>(size, 1) - 1)); };
+        unsigned const row_bits = bits_for(num_rows);
+        unsigned const col_bits = bits_for(num_cols);
+        if (row_bits + col_bits > 64)
+        {
+            throw std::invalid_argument("The rows and columns must fit together in 64 bits");
+        }
+        // the rows of a matrix with a single row take no bits, and their shift is only kept
+        // in range
+        unsigned const row_shift = row_bits == 0 ? 0 : col_bits;
+
+        std::vector<std::uint64_t> keys(n);
+        std::vector<V> vals(n);
+        detail::parallel_chunks(n,
+                                pool,
+                                [&](std::size_t begin, std::size_t end)
+                                {
+                                    for (auto e = begin; e < end; ++e)
+                                    {
+                                        auto const r = static_cast<std::uint64_t>(rows[e]);
+                                        auto const c = static_cast<std::uint64_t>(cols[e]);
+                                        if (r >= num_rows || c >= num_cols)
+                                        {
+                                            throw std::invalid_argument(
+                                                "Coordinates must be less than the sizes of "
+                                                "the levels");
+                                        }
+                                        keys[e] = r << row_shift | c;
+                                        vals[e] = static_cast<V>(values[e]);
+                                    }
+                                });
+        util::radix_sort(keys, vals, 0, row_bits + col_bits, pool);
+
+        // merge the entries with the same coordinates, which are now next to each other
+        std::size_t m = 0;
+        for (std::size_t e = 0; e < n; ++e)
+        {
+            if (m > 0 && keys[m - 1] == keys[e])
+            {
+                vals[m - 1] = reduce(std::move(vals[m - 1]), std::move(vals[e]));
+            }
+            else
+            {
+                if (m != e)
+                {
+                    keys[m] = keys[e];
+                    vals[m] = std::move(vals[e]);
+                }
+                ++m;
+            }
+        }
+        keys.resize(m);
+        vals.resize(m);
+
+        std::uint64_t const col_mask
+            = col_bits == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << col_bits) - 1;
+        auto const row_of
+            = [&](std::size_t e) { return row_bits == 0 ? 0 : keys[e] >> row_shift; };
+        auto const col_of = [&](std::size_t e) { return keys[e] & col_mask; };
+
+        if constexpr (is_coo)
+        {
+            using Pos = std::remove_cvref_t<decltype(outer.get_pos())>;
+            using OuterCrd = std::remove_cvref_t<decltype(outer.get_crd())>;
+            using InnerCrd = std::remove_cvref_t<decltype(inner.get_crd())>;
+            auto outer_crd = detail::container_of_size<OuterCrd>(m);
+            auto inner_crd = detail::container_of_size<InnerCrd>(m);
+            detail::parallel_chunks(
+                m,
+                pool,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (auto e = begin; e < end; ++e)
+                    {
+                        outer_crd[e] = static_cast<typename OuterCrd::value_type>(row_of(e));
+                        inner_crd[e] = static_cast<typename InnerCrd::value_type>(col_of(e));
+                    }
+                });
+            Pos pos;
+            pos.push_back(0);
+            pos.push_back(static_cast<typename Pos::value_type>(m));
+            outer = Outer{ outer.size(), std::move(pos), std::move(outer_crd) };
+            inner = Inner{ inner.size(), std::move(inner_crd) };
+        }
+        else
+        {
+            using Pos = std::remove_cvref_t<decltype(inner.get_pos())>;
+            using Crd = std::remove_cvref_t<decltype(inner.get_crd())>;
+            using P = typename Pos::value_type;
+            auto crd = detail::container_of_size<Crd>(m);
+            auto pos = detail::container_of_size<Pos>(static_cast<std::size_t>(num_rows) + 1);
+            // every entry that starts a row is the first position of the empty rows before it,
+            // so every row is written by exactly one entry
+            detail::parallel_chunks(
+                m,
+                pool,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (auto e = begin; e < end; ++e)
+                    {
+                        crd[e] = static_cast<typename Crd::value_type>(col_of(e));
+                        std::uint64_t const first = e == 0 ? 0 : row_of(e - 1) + 1;
+                        for (auto r = first; r <= row_of(e); ++r)
+                        {
+                            pos[static_cast<std::size_t>(r)] = static_cast<P>(e);
+                        }
+                    }
+                });
+            for (auto r = m == 0 ? 0 : row_of(m - 1) + 1; r <= num_rows; ++r)
+            {
+                pos[static_cast<std::size_t>(r)] = static_cast<P>(m);
+            }
+            inner = Inner{ inner.size(), std::move(pos), std::move(crd) };
+        }
+
+        if constexpr (std::is_same_v<Data, std::vector<V>>)
+        {
+            data = std::move(vals);
+        }
+        else
+        {
+            data.assign(vals.begin(), vals.end());
+        }
+    }
+}
+
+#endif  // XSPARSE_INGEST_HPP
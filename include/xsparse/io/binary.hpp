@@ -0,0 +1,757 @@
+#ifndef XSPARSE_IO_BINARY_HPP
+#define XSPARSE_IO_BINARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xsparse/io/mapped_region.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/offset.hpp>
+#include <xsparse/levels/range.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/mapped_vector.hpp>
+#include <xsparse/util/template_utils.hpp>
+
+/**
+ * @brief A versioned binary file format for the arrays of a tensor's levels and its data.
+ *
+ * @details The file starts with a 64 byte `file_header`, followed by one `level_record` per
+ * level, one `array_record` per array and then the arrays themselves. Every array starts at a
+ * multiple of `ALIGNMENT` bytes from the start of the file, so that a memory-mapped file can be
+ * read in place through `util::mapped_vector`. The arrays of a level are
+ *
+ * - `dense`: none,
+ * - `compressed`: `pos`, then `crd`,
+ * - `singleton`: `crd`,
+ * - `offset`: `offset`,
+ * - `range`: `offset`, with the second size of the level in `level_record::size_M`,
+ *
+ * and the data of the tensor is the last array of the file. All values are stored in the byte
+ * order of the machine that wrote the file, which readers check.
+ */
+namespace xsparse::io
+{
+    inline constexpr char MAGIC[8] = { 'X', 'S', 'P', 'A', 'R', 'S', 'E', '\0' };
+    inline constexpr std::uint32_t FORMAT_VERSION = 1;
+    inline constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    inline constexpr std::size_t ALIGNMENT = 64;
+
+    enum class level_kind : std::uint32_t
+    {
+        dense = 1,
+        compressed = 2,
+        singleton = 3,
+        offset = 4,
+        range = 5,
+    };
+
+    enum class element_kind : std::uint32_t
+    {
+        unsigned_integer = 1,
+        signed_integer = 2,
+        floating_point = 3,
+        other = 4,
+    };
+
+    struct file_header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t alignment;
+        std::uint32_t num_levels;
+        std::uint64_t num_arrays;
+        std::uint64_t level_table_offset;
+        std::uint64_t array_table_offset;
+        std::uint64_t file_size;
+        std::uint64_t reserved;
+    };
+
+    struct level_record
+    {
+        std::uint32_t kind;
+        std::uint32_t num_arrays;
+        std::uint64_t size;
+        std::uint64_t first_array;
+        std::uint64_t size_M;
+    };
+
+    struct array_record
+    {
+        std::uint64_t offset;
+        std::uint64_t count;
+        std::uint32_t element_size;
+        std::uint32_t element_kind;
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(file_header) == 64);
+    static_assert(sizeof(level_record) == 32);
+    static_assert(sizeof(array_record) == 32);
+
+    namespace detail
+    {
+        template <class T>
+        inline constexpr element_kind element_kind_of() noexcept
+        {
+            if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+            {
+                return element_kind::unsigned_integer;
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                return element_kind::signed_integer;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return element_kind::floating_point;
+            }
+            else
+            {
+                return element_kind::other;
+            }
+        }
+
+        template <class Level>
+        inline constexpr level_kind level_kind_of() noexcept
+        {
+            if constexpr (util::is_specialization_of_v<Level, levels::dense>)
+            {
+                return level_kind::dense;
+            }
+            else if constexpr (util::is_specialization_of_v<Level, levels::compressed>)
+            {
+                return level_kind::compressed;
+            }
+            else if constexpr (util::is_specialization_of_v<Level, levels::singleton>)
+            {
+                return level_kind::singleton;
+            }
+            else if constexpr (util::is_specialization_of_v<Level, levels::offset>)
+            {
+                return level_kind::offset;
+            }
+            else
+            {
+                static_assert(util::is_specialization_of_v<Level, levels::range>,
+                              "Only dense, compressed, singleton, offset and range levels can be "
+                              "stored");
+                return level_kind::range;
+            }
+        }
+
+        template <class Level>
+        inline auto level_arrays(Level const& level) noexcept
+        /**
+         * @brief References to the arrays of `level`, in the order they are stored.
+         */
+        {
+            if constexpr (level_kind_of<Level>() == level_kind::dense)
+            {
+                return std::tuple<>();
+            }
+            else if constexpr (level_kind_of<Level>() == level_kind::compressed)
+            {
+                return std::tie(level.get_pos(), level.get_crd());
+            }
+            else if constexpr (level_kind_of<Level>() == level_kind::singleton)
+            {
+                return std::tie(level.get_crd());
+            }
+            else
+            {
+                return std::tie(level.get_offset());
+            }
+        }
+
+        inline std::uint64_t align_up(std::uint64_t offset) noexcept
+        {
+            return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        }
+
+        inline bool fits(std::uint64_t offset,
+                         std::uint64_t count,
+                         std::uint64_t element_size,
+                         std::uint64_t size) noexcept
+        /**
+         * @brief Whether `count` elements of `element_size` bytes from `offset` end within
+         * `size` bytes, without overflowing on the way.
+         */
+        {
+            return offset <= size && count <= (size - offset) / element_size;
+        }
+
+        inline bool holds(array_record const& record, element_kind kind) noexcept
+        {
+            return record.element_kind == static_cast<std::uint32_t>(kind);
+        }
+
+        inline bool holds_integers(array_record const& record) noexcept
+        {
+            return holds(record, element_kind::unsigned_integer)
+                   || holds(record, element_kind::signed_integer);
+        }
+
+        class writer
+        {
+        private:
+            std::vector<level_record> m_levels;
+            std::vector<array_record> m_arrays;
+            std::vector<std::pair<void const*, std::size_t>> m_bytes;
+            std::vector<std::vector<char>> m_copies;
+
+        public:
+            template <class Container>
+            inline void add_array(Container const& container)
+            {
+                using T = typename Container::value_type;
+                static_assert(std::is_trivially_copyable_v<T>,
+                              "Only arrays of trivially copyable values can be stored");
+
+                array_record record{};
+                record.count = container.size();
+                record.element_size = sizeof(T);
+                record.element_kind = static_cast<std::uint32_t>(element_kind_of<T>());
+                m_arrays.push_back(record);
+
+                if constexpr (requires { container.data(); })
+                {
+                    m_bytes.emplace_back(container.data(), container.size() * sizeof(T));
+                }
+                else
+                {
+                    auto& copy = m_copies.emplace_back(container.size() * sizeof(T));
+                    std::size_t n = 0;
+                    for (auto const& value : container)
+                    {
+                        T const element = value;
+                        std::memcpy(copy.data() + sizeof(T) * n++, &element, sizeof(T));
+                    }
+                    m_bytes.emplace_back(copy.data(), copy.size());
+                }
+            }
+
+            template <class Level>
+            inline void add_level(Level const& level)
+            {
+                level_record record{};
+                record.kind = static_cast<std::uint32_t>(level_kind_of<Level>());
+                record.size = static_cast<std::uint64_t>(level.size());
+                record.first_array = m_arrays.size();
+                if constexpr (level_kind_of<Level>() == level_kind::range)
+                {
+                    record.size_M = static_cast<std::uint64_t>(level.get_size_M());
+                }
+                std::apply([&](auto const&... arrays) { (add_array(arrays), ...); },
+                           level_arrays(level));
+                record.num_arrays
+                    = static_cast<std::uint32_t>(m_arrays.size() - record.first_array);
+                m_levels.push_back(record);
+            }
+
+            inline void write(std::string const& path)
+            {
+                file_header header{};
+                std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+                header.version = FORMAT_VERSION;
+                header.byte_order = BYTE_ORDER_MARK;
+                header.alignment = ALIGNMENT;
+                header.num_levels = static_cast<std::uint32_t>(m_levels.size());
+                header.num_arrays = m_arrays.size();
+                header.level_table_offset = sizeof(file_header);
+                header.array_table_offset
+                    = header.level_table_offset + m_levels.size() * sizeof(level_record);
+
+                std::uint64_t offset
+                    = header.array_table_offset + m_arrays.size() * sizeof(array_record);
+                for (auto& array : m_arrays)
+                {
+                    offset = align_up(offset);
+                    array.offset = offset;
+                    offset += array.count * array.element_size;
+                }
+                header.file_size = offset;
+
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                if (!out)
+                {
+                    throw std::runtime_error("cannot open " + path + " for writing");
+                }
+                out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+                out.write(reinterpret_cast<char const*>(m_levels.data()),
+                          m_levels.size() * sizeof(level_record));
+                out.write(reinterpret_cast<char const*>(m_arrays.data()),
+                          m_arrays.size() * sizeof(array_record));
+
+                char const padding[ALIGNMENT] = {};
+                std::uint64_t written
+                    = header.array_table_offset + m_arrays.size() * sizeof(array_record);
+                for (std::size_t a = 0; a < m_arrays.size(); ++a)
+                {
+                    out.write(padding, m_arrays[a].offset - written);
+                    out.write(static_cast<char const*>(m_bytes[a].first), m_bytes[a].second);
+                    written = m_arrays[a].offset + m_bytes[a].second;
+                }
+                if (!out)
+                {
+                    throw std::runtime_error("cannot write " + path);
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief A memory-mapped file in the binary format, with its header and tables validated.
+     */
+    class mapped_file
+    {
+    private:
+        std::shared_ptr<mapped_region> m_region;
+        file_header m_header;
+
+        template <class T>
+        inline T read_record(std::uint64_t offset) const noexcept
+        {
+            T record;
+            std::memcpy(&record, m_region->data() + offset, sizeof(T));
+            return record;
+        }
+
+        template <class F>
+        inline bool for_each_index(array_record const& record, F&& f) const
+        /**
+         * @brief Calls `f` with every element of an array of integers as a `std::uint64_t`,
+         * until it returns false. Returns false if it did, or if the array does not hold
+         * integers or holds a negative one.
+         */
+        {
+            auto const visit = [&](auto const* type)
+            {
+                using T = std::remove_cvref_t<decltype(*type)>;
+                auto const* const first = m_region->data() + record.offset;
+                for (std::uint64_t n = 0; n < record.count; ++n)
+                {
+                    T value;
+                    std::memcpy(&value, first + n * sizeof(T), sizeof(T));
+                    if constexpr (std::is_signed_v<T>)
+                    {
+                        if (value < 0)
+                        {
+                            return false;
+                        }
+                    }
+                    if (!f(static_cast<std::uint64_t>(value)))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            if (!detail::holds_integers(record))
+            {
+                return false;
+            }
+            bool const is_signed = detail::holds(record, element_kind::signed_integer);
+            switch (record.element_size)
+            {
+                case 1:
+                    return is_signed ? visit(static_cast<std::int8_t const*>(nullptr))
+                                     : visit(static_cast<std::uint8_t const*>(nullptr));
+                case 2:
+                    return is_signed ? visit(static_cast<std::int16_t const*>(nullptr))
+                                     : visit(static_cast<std::uint16_t const*>(nullptr));
+                case 4:
+                    return is_signed ? visit(static_cast<std::int32_t const*>(nullptr))
+                                     : visit(static_cast<std::uint32_t const*>(nullptr));
+                case 8:
+                    return is_signed ? visit(static_cast<std::int64_t const*>(nullptr))
+                                     : visit(static_cast<std::uint64_t const*>(nullptr));
+                default:
+                    return false;
+            }
+        }
+
+    public:
+        explicit inline mapped_file(std::string const& path)
+            : m_region(std::make_shared<mapped_region>(path))
+        {
+            if (m_region->size() < sizeof(file_header))
+            {
+                throw std::runtime_error(path + " is not an xsparse file");
+            }
+            m_header = read_record<file_header>(0);
+            if (std::memcmp(m_header.magic, MAGIC, sizeof(MAGIC)) != 0)
+            {
+                throw std::runtime_error(path + " is not an xsparse file");
+            }
+            if (m_header.byte_order != BYTE_ORDER_MARK)
+            {
+                throw std::runtime_error(path + " was written with a different byte order");
+            }
+            if (m_header.version != FORMAT_VERSION)
+            {
+                throw std::runtime_error(path + " has unsupported format version "
+                                         + std::to_string(m_header.version));
+            }
+            auto const size = static_cast<std::uint64_t>(m_region->size());
+            if (m_header.file_size != size
+                || !detail::fits(
+                    m_header.level_table_offset, m_header.num_levels, sizeof(level_record), size)
+                || !detail::fits(
+                    m_header.array_table_offset, m_header.num_arrays, sizeof(array_record), size))
+            {
+                throw std::runtime_error(path + " is truncated");
+            }
+            // the data of the tensor is the last array
+            if (m_header.num_arrays == 0)
+            {
+                throw std::runtime_error(path + " has a corrupt array table");
+            }
+            for (std::size_t a = 0; a < m_header.num_arrays; ++a)
+            {
+                auto const record = array(a);
+                if (record.offset % ALIGNMENT != 0 || record.element_size == 0
+                    || !detail::fits(record.offset, record.count, record.element_size, size))
+                {
+                    throw std::runtime_error(path + " has a corrupt array table");
+                }
+            }
+            for (std::size_t k = 0; k < m_header.num_levels; ++k)
+            {
+                auto const record = level(k);
+                if (record.first_array > m_header.num_arrays
+                    || record.num_arrays > m_header.num_arrays - record.first_array)
+                {
+                    throw std::runtime_error(path + " has a corrupt level table");
+                }
+            }
+        }
+
+        inline std::size_t num_levels() const noexcept
+        {
+            return m_header.num_levels;
+        }
+
+        inline std::size_t num_arrays() const noexcept
+        {
+            return m_header.num_arrays;
+        }
+
+        inline void check_contents() const
+        /**
+         * @brief Checks that the arrays of every level are consistent with its format and with
+         * the levels above it, so that iterating over the tensor stays within its arrays.
+         *
+         * @details Reads every `pos` and `crd` array once: `pos` has one more element than
+         * its parent has positions, starts at 0, never decreases and ends at the size of
+         * `crd`, a `singleton` has one coordinate per parent position, every coordinate is
+         * less than the size of its level, the offsets of `range` and `offset` levels cover
+         * the coordinates of the levels they are indexed by, and the data has a value for
+         * every position of the last level.
+         */
+        {
+            constexpr std::uint64_t MAX = std::numeric_limits<std::uint64_t>::max();
+            auto const corrupt = [](std::size_t k)
+            { return std::runtime_error("level " + std::to_string(k) + " has corrupt arrays"); };
+            auto const check_crd
+                = [&](std::size_t k, array_record const& crd, std::uint64_t size)
+            {
+                if (!for_each_index(crd, [&](std::uint64_t c) { return c < size; }))
+                {
+                    throw corrupt(k);
+                }
+            };
+
+            // the number of positions of the level above, and the sizes of the two levels
+            // above, which index the offsets of `range` and `offset` levels
+            std::uint64_t positions = 1;
+            std::uint64_t parent_size = 1;
+            std::uint64_t grandparent_size = 1;
+            for (std::size_t k = 0; k < num_levels(); ++k)
+            {
+                auto const record = level(k);
+                auto const a = static_cast<std::size_t>(record.first_array);
+                switch (static_cast<level_kind>(record.kind))
+                {
+                    case level_kind::dense:
+                    {
+                        if (record.num_arrays != 0
+                            || (record.size != 0 && positions > MAX / record.size))
+                        {
+                            throw corrupt(k);
+                        }
+                        positions *= record.size;
+                        break;
+                    }
+                    case level_kind::range:
+                    {
+                        if (record.num_arrays != 1 || !detail::holds_integers(array(a))
+                            || array(a).count < parent_size
+                            || (record.size != 0 && positions > MAX / record.size))
+                        {
+                            throw corrupt(k);
+                        }
+                        positions *= record.size;
+                        break;
+                    }
+                    case level_kind::compressed:
+                    {
+                        if (record.num_arrays != 2)
+                        {
+                            throw corrupt(k);
+                        }
+                        auto const pos = array(a);
+                        auto const crd = array(a + 1);
+                        std::uint64_t n = 0;
+                        std::uint64_t previous = 0;
+                        if (pos.count == 0 || pos.count - 1 != positions
+                            || !for_each_index(pos,
+                                               [&](std::uint64_t p)
+                                               {
+                                                   bool const valid
+                                                       = n++ == 0 ? p == 0 : p >= previous;
+                                                   previous = p;
+                                                   return valid;
+                                               })
+                            || previous != crd.count)
+                        {
+                            throw corrupt(k);
+                        }
+                        check_crd(k, crd, record.size);
+                        positions = crd.count;
+                        break;
+                    }
+                    case level_kind::singleton:
+                    {
+                        if (record.num_arrays != 1 || array(a).count != positions)
+                        {
+                            throw corrupt(k);
+                        }
+                        check_crd(k, array(a), record.size);
+                        break;
+                    }
+                    case level_kind::offset:
+                    {
+                        if (record.num_arrays != 1 || !detail::holds_integers(array(a))
+                            || array(a).count < grandparent_size)
+                        {
+                            throw corrupt(k);
+                        }
+                        break;
+                    }
+                    default:
+                        throw std::runtime_error("level " + std::to_string(k)
+                                                 + " has an unknown format");
+                }
+                grandparent_size = parent_size;
+                parent_size = record.size;
+            }
+            if (array(num_arrays() - 1).count < positions)
+            {
+                throw std::runtime_error("the data has fewer values than the tensor has positions");
+            }
+        }
+
+        inline level_record level(std::size_t k) const noexcept
+        {
+            return read_record<level_record>(m_header.level_table_offset
+                                             + k * sizeof(level_record));
+        }
+
+        inline array_record array(std::size_t a) const noexcept
+        {
+            return read_record<array_record>(m_header.array_table_offset
+                                             + a * sizeof(array_record));
+        }
+
+        template <class Container>
+        inline Container load_array(std::size_t a) const
+        /**
+         * @brief Array `a` as a `Container`: a view into the mapping for `util::mapped_vector`,
+         * and a copy for any other container.
+         */
+        {
+            using T = typename Container::value_type;
+            if (a >= num_arrays())
+            {
+                throw std::runtime_error("array " + std::to_string(a) + " is not in the file");
+            }
+            auto const record = array(a);
+            if (record.element_size != sizeof(T)
+                || record.element_kind != static_cast<std::uint32_t>(detail::element_kind_of<T>()))
+            {
+                throw std::runtime_error("array " + std::to_string(a)
+                                         + " does not hold values of the requested type");
+            }
+
+            auto* const first = reinterpret_cast<T*>(m_region->data() + record.offset);
+            if constexpr (std::is_same_v<Container, util::mapped_vector<T>>)
+            {
+                return Container(m_region, first, static_cast<std::size_t>(record.count));
+            }
+            else
+            {
+                return Container(first, first + record.count);
+            }
+        }
+    };
+
+    namespace detail
+    {
+        template <class Level>
+        inline Level load_level(mapped_file const& file, std::size_t k)
+        {
+            using IK = typename Level::BaseTraits::IK;
+            auto const record = file.level(k);
+            if (record.kind != static_cast<std::uint32_t>(level_kind_of<Level>()))
+            {
+                throw std::runtime_error("level " + std::to_string(k)
+                                         + " is stored in a different format");
+            }
+            using Arrays = decltype(level_arrays(std::declval<Level const&>()));
+            if (record.num_arrays != std::tuple_size_v<Arrays>)
+            {
+                throw std::runtime_error("level " + std::to_string(k)
+                                         + " does not have the arrays of its format");
+            }
+
+            auto const size = static_cast<IK>(record.size);
+            auto const a = static_cast<std::size_t>(record.first_array);
+            if constexpr (level_kind_of<Level>() == level_kind::dense)
+            {
+                return Level(size);
+            }
+            else if constexpr (level_kind_of<Level>() == level_kind::compressed)
+            {
+                using Pos = std::remove_cvref_t<decltype(std::declval<Level const&>().get_pos())>;
+                using Crd = std::remove_cvref_t<decltype(std::declval<Level const&>().get_crd())>;
+                return Level(size, file.load_array<Pos>(a), file.load_array<Crd>(a + 1));
+            }
+            else if constexpr (level_kind_of<Level>() == level_kind::singleton)
+            {
+                using Crd = std::remove_cvref_t<decltype(std::declval<Level const&>().get_crd())>;
+                return Level(size, file.load_array<Crd>(a));
+            }
+            else
+            {
+                using Offset
+                    = std::remove_cvref_t<decltype(std::declval<Level const&>().get_offset())>;
+                if constexpr (level_kind_of<Level>() == level_kind::range)
+                {
+                    return Level(size, static_cast<IK>(record.size_M), file.load_array<Offset>(a));
+                }
+                else
+                {
+                    return Level(size, file.load_array<Offset>(a));
+                }
+            }
+        }
+
+        template <class LevelsTuple>
+        struct level_loader;
+
+        template <class... Levels>
+        struct level_loader<std::tuple<Levels...>>
+        {
+            template <std::size_t... K>
+            static inline std::tuple<Levels...> load(mapped_file const& file,
+                                                     [[maybe_unused]] std::index_sequence<K...> k)
+            {
+                return std::tuple<Levels...>(load_level<Levels>(file, K)...);
+            }
+        };
+    }
+
+    template <class... Levels, class Data>
+    inline void save(std::string const& path, Tensor<std::tuple<Levels...>, Data> const& tensor)
+    /**
+     * @brief Write the levels and data of `tensor` to `path` in the binary format.
+     */
+    {
+        detail::writer writer;
+        std::apply([&](auto const&... levels) { (writer.add_level(levels), ...); },
+                   tensor.get_levels());
+        writer.add_array(tensor.get_data());
+        writer.write(path);
+    }
+
+    template <class LevelsTuple, class Data>
+    struct loaded_tensor;
+
+    /**
+     * @brief The levels and data of a tensor read by `load`, which a `Tensor` can refer to.
+     */
+    template <class... Levels, class Data>
+    struct loaded_tensor<std::tuple<Levels...>, Data>
+    {
+        std::tuple<Levels...> levels;
+        Data data;
+
+        inline Tensor<std::tuple<Levels...>, Data> tensor() noexcept
+        {
+            return std::apply([&](auto&... l)
+                              { return Tensor<std::tuple<Levels...>, Data>(l..., data); },
+                              levels);
+        }
+    };
+
+    template <class LevelsTuple, class Data>
+    inline loaded_tensor<LevelsTuple, Data> load(std::string const& path, bool trusted = false)
+    /**
+     * @brief Read a tensor written by `save`.
+     *
+     * @details The level types must be of the same formats as the ones that were saved, with
+     * arrays of the same value types. Levels and data whose containers are
+     * `util::mapped_vector` refer to the mapped file instead of copying it, and keep it mapped
+     * for as long as they exist.
+     *
+     * The header and tables are always validated, and so are the contents of the arrays with
+     * `mapped_file::check_contents`, which reads every `pos` and `crd` array once. A file
+     * that is `trusted`, e.g. one this program wrote itself, skips that check, so that a
+     * mapped tensor is not read before it is used; a corrupt one can then make iterating over
+     * it read out of bounds.
+     *
+     * @throws std::runtime_error if the file cannot be read, is malformed or does not hold a
+     * tensor of these types.
+     */
+    {
+        mapped_file const file(path);
+        constexpr std::size_t N = std::tuple_size_v<LevelsTuple>;
+        if (file.num_levels() != N)
+        {
+            throw std::runtime_error(path + " holds a tensor with "
+                                     + std::to_string(file.num_levels()) + " levels");
+        }
+        if (!trusted)
+        {
+            try
+            {
+                file.check_contents();
+            }
+            catch (std::runtime_error const& e)
+            {
+                throw std::runtime_error(path + ": " + e.what());
+            }
+        }
+
+        return loaded_tensor<LevelsTuple, Data>{
+            detail::level_loader<LevelsTuple>::load(file, std::make_index_sequence<N>{}),
+            file.load_array<Data>(file.num_arrays() - 1)
+        };
+    }
+}
+
+#endif  // XSPARSE_IO_BINARY_HPP
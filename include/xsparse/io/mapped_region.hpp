@@ -0,0 +1,142 @@
+#ifndef XSPARSE_IO_MAPPED_REGION_HPP
+#define XSPARSE_IO_MAPPED_REGION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace xsparse::io
+{
+    /**
+     * @brief A file mapped privately into memory: pages are copied on write, and changes are
+     * never written back to the file.
+     */
+    class mapped_region
+    {
+    private:
+        void* m_address = nullptr;
+        std::size_t m_length = 0;
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+
+        inline void release() noexcept
+        /**
+         * @brief Unmaps the file and closes its handles, also those of a half-built region,
+         * whose destructor does not run when its constructor throws.
+         */
+        {
+#if defined(_WIN32)
+            if (m_address)
+            {
+                UnmapViewOfFile(m_address);
+            }
+            if (m_mapping)
+            {
+                CloseHandle(m_mapping);
+            }
+            if (m_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_file);
+            }
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_address)
+            {
+                ::munmap(m_address, m_length);
+            }
+#endif
+            m_address = nullptr;
+        }
+
+    public:
+        explicit inline mapped_region(std::string const& path)
+        {
+#if defined(_WIN32)
+            m_file = CreateFileA(path.c_str(),
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ,
+                                 nullptr,
+                                 OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL,
+                                 nullptr);
+            LARGE_INTEGER size;
+            if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size))
+            {
+                release();
+                throw std::runtime_error("cannot open " + path);
+            }
+            m_length = static_cast<std::size_t>(size.QuadPart);
+            if (m_length == 0)
+            {
+                return;
+            }
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            m_address = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+            if (m_address == nullptr)
+            {
+                release();
+                throw std::runtime_error("cannot map " + path);
+            }
+#else
+            int const fd = ::open(path.c_str(), O_RDONLY);
+            struct stat st;
+            if (fd < 0 || ::fstat(fd, &st) != 0)
+            {
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+                throw std::runtime_error("cannot open " + path);
+            }
+            m_length = static_cast<std::size_t>(st.st_size);
+            if (m_length == 0)
+            {
+                ::close(fd);
+                return;
+            }
+            m_address = ::mmap(nullptr, m_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (m_address == MAP_FAILED)
+            {
+                m_address = nullptr;
+                throw std::runtime_error("cannot map " + path);
+            }
+#endif
+        }
+
+        mapped_region(mapped_region const&) = delete;
+        mapped_region& operator=(mapped_region const&) = delete;
+
+        inline ~mapped_region()
+        {
+            release();
+        }
+
+        inline std::byte* data() const noexcept
+        {
+            return static_cast<std::byte*>(m_address);
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return m_length;
+        }
+    };
+}
+
+#endif  // XSPARSE_IO_MAPPED_REGION_HPP
@@ -0,0 +1,554 @@
+#ifndef XSPARSE_IO_TEXT_HPP
+#define XSPARSE_IO_TEXT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xsparse/io/mapped_region.hpp>
+#include <xsparse/level_capabilities/assembly.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+/**
+ * @brief Readers for the text formats in which sparse tensors are usually distributed:
+ * MatrixMarket (`.mtx`, e.g. the SuiteSparse collection) and FROSTT (`.tns`).
+ *
+ * @details Both formats list one nonzero per line as 1-based coordinates followed by a value.
+ * The file is mapped into memory and its lines are split into a few chunks per thread of a
+ * `util::work_stealing_pool`, which are parsed concurrently with `std::from_chars`, without
+ * streams or locales. The entries are gathered into a `coordinate_list`, in file order and with
+ * 0-based coordinates, from which `assemble` builds any tensor through the assembly protocol
+ * of its levels.
+ *
+ * The entries are not fed to the `append_` and `insert_` hooks of the levels while the file is
+ * parsed: the chunks are parsed in parallel, out of order, and appended levels need their
+ * entries sorted. The whole `coordinate_list` is therefore held at once, next to the mapped
+ * file, and `assemble` may sort it with `std::stable_sort`, which takes a buffer of up to the
+ * size of the list again. The peak memory is thus up to twice the entries on top of the file
+ * and the assembled tensor.
+ */
+namespace xsparse::io
+{
+    namespace detail
+    {
+        template <std::size_t, class T>
+        using repeat_t = T;
+
+        template <class IK, class V, class Seq>
+        struct coordinate_entry;
+
+        template <class IK, class V, std::size_t... J>
+        struct coordinate_entry<IK, V, std::index_sequence<J...>>
+        {
+            using type = std::tuple<repeat_t<J, IK>..., V>;
+        };
+    }
+
+    /**
+     * @brief The entries of a tensor read from a text file.
+     *
+     * @details `entries` holds `(coordinates..., value)` tuples with 0-based coordinates, in
+     * the order of the file, which is the input expected by `Tensor::assemble`.
+     */
+    template <std::size_t N, class IK, class V>
+    struct coordinate_list
+    {
+        static_assert(N > 0, "A tensor has at least one dimension");
+        static_assert(std::is_integral_v<IK>, "Coordinates must be integral");
+
+        using entry_type =
+            typename detail::coordinate_entry<IK, V, std::make_index_sequence<N>>::type;
+
+        std::array<IK, N> shape{};
+        std::vector<entry_type> entries;
+    };
+
+    namespace detail
+    {
+        // the smallest chunk of lines worth handing to a thread
+        inline constexpr std::size_t CHUNK_BYTES = std::size_t{ 1 } << 16;
+
+        enum class symmetry
+        {
+            general,
+            symmetric,
+            skew_symmetric
+        };
+
+        /**
+         * @brief How the lines of a file are to be parsed.
+         */
+        template <std::size_t N, class IK>
+        struct line_format
+        {
+            // whether lines have no value, which is then 1
+            bool pattern = false;
+            // whether the coordinates are checked against `shape`
+            bool bounded = false;
+            std::array<IK, N> shape{};
+            // whether every off-diagonal entry of a matrix stands for its transpose as well
+            symmetry sym = symmetry::general;
+        };
+
+        template <std::size_t N, class IK, class V>
+        struct chunk_result
+        {
+            // where the entries of the chunk are written, and how many there are
+            typename coordinate_list<N, IK, V>::entry_type* entries = nullptr;
+            std::size_t num_entries = 0;
+            // the largest 1-based coordinate seen in every dimension
+            std::array<IK, N> extent{};
+            std::size_t num_lines = 0;
+            std::size_t error_offset = std::string_view::npos;
+            char const* error = nullptr;
+        };
+
+        inline bool is_blank(char const c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        inline char const* skip_blanks(char const* first, char const* last) noexcept
+        {
+            while (first != last && is_blank(*first))
+            {
+                ++first;
+            }
+            return first;
+        }
+
+        template <class T>
+        inline bool parse_number(char const*& first, char const* last, T& value) noexcept
+        /**
+         * @brief Parse the number at the start of `[first, last)`, after any blanks, and move
+         * `first` past it.
+         */
+        {
+            first = skip_blanks(first, last);
+            // `from_chars` does not accept an explicit plus sign
+            if (first != last && *first == '+')
+            {
+                ++first;
+            }
+            auto const [end, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc{} || (end != last && !is_blank(*end)))
+            {
+                return false;
+            }
+            first = end;
+            return true;
+        }
+
+        inline std::size_t next_line(std::string_view text,
+                                     std::size_t pos,
+                                     std::string_view& line) noexcept
+        /**
+         * @brief Store the line starting at `pos` in `line`, without its end of line, and
+         * return the position of the next line.
+         */
+        {
+            auto const end = std::min(text.find('\n', pos), text.size());
+            line = text.substr(pos, end - pos);
+            return end == text.size() ? end : end + 1;
+        }
+
+        inline std::size_t line_number(std::string_view text, std::size_t offset) noexcept
+        {
+            return 1
+                   + static_cast<std::size_t>(
+                       std::count(text.begin(), text.begin() + offset, '\n'));
+        }
+
+        template <std::size_t N, class IK, class V, std::size_t... J>
+        inline void parse_lines(char const* first,
+                                char const* last,
+                                char const* text,
+                                line_format<N, IK> const& format,
+                                chunk_result<N, IK, V>& result,
+                                [[maybe_unused]] std::index_sequence<J...> j)
+        /**
+         * @brief Parse the entries on the lines of `[first, last)`, skipping blank and comment
+         * lines, and write them to `result.entries`, which has room for two entries per line.
+         * Stops at the first malformed line, recording its offset from `text`.
+         */
+        {
+            std::array<IK, N> coords;
+            while (first != last)
+            {
+                auto const* const end = static_cast<char const*>(
+                    std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+                auto const* const line_end = end ? end : last;
+                auto const* p = skip_blanks(first, line_end);
+                auto const* const line = first;
+                first = end ? end + 1 : last;
+                if (p == line_end || *p == '%' || *p == '#')
+                {
+                    continue;
+                }
+
+                auto const fail = [&](char const* error)
+                {
+                    result.error_offset = static_cast<std::size_t>(line - text);
+                    result.error = error;
+                };
+
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    if (!parse_number(p, line_end, coords[k]))
+                    {
+                        return fail("expected a coordinate for every dimension");
+                    }
+                    if (coords[k] < 1 || (format.bounded && coords[k] > format.shape[k]))
+                    {
+                        return fail("coordinate out of range");
+                    }
+                    result.extent[k] = std::max(result.extent[k], coords[k]);
+                    --coords[k];
+                }
+
+                V value{ 1 };
+                if (!format.pattern && !parse_number(p, line_end, value))
+                {
+                    return fail("expected a value");
+                }
+                if (skip_blanks(p, line_end) != line_end)
+                {
+                    return fail("unexpected characters at the end of the line");
+                }
+
+                ++result.num_lines;
+                result.entries[result.num_entries++] = { coords[J]..., value };
+                if constexpr (N == 2)
+                {
+                    if (format.sym != symmetry::general && coords[0] != coords[1])
+                    {
+                        result.entries[result.num_entries++]
+                            = { coords[1],
+                                coords[0],
+                                format.sym == symmetry::skew_symmetric ? static_cast<V>(-value)
+                                                                       : value };
+                    }
+                }
+            }
+        }
+
+        template <std::size_t N, class IK, class V>
+        inline std::size_t parse_body(std::string_view text,
+                                      std::size_t body,
+                                      line_format<N, IK> const& format,
+                                      coordinate_list<N, IK, V>& list,
+                                      util::work_stealing_pool& pool)
+        /**
+         * @brief Parse the lines of `text` from offset `body` on in parallel, appending their
+         * entries to `list` in file order, and return the number of entries in the file.
+         *
+         * @details The lines are cut into chunks at the first line break after equally spaced
+         * offsets. `list` is grown once by as many entries as the chunks have lines (twice as
+         * many for a symmetric matrix), which bounds the number of entries by the text rather
+         * than by what it claims, and every chunk is parsed in place into its share of it.
+         * The entries are then moved down over the room left by blank and comment lines, so
+         * they are never held twice. The extent of every dimension of the tensor is raised
+         * to its largest coordinate.
+         */
+        {
+            auto const length = text.size() - body;
+            std::size_t const num_chunks
+                = std::max<std::size_t>(1,
+                                        std::min(4 * pool.size(),
+                                                 (length + CHUNK_BYTES - 1) / CHUNK_BYTES));
+            std::vector<std::size_t> bounds(num_chunks + 1, text.size());
+            bounds[0] = body;
+            for (std::size_t c = 1; c < num_chunks; ++c)
+            {
+                // move every cut to the start of the next line
+                auto const cut = std::max(body + c * length / num_chunks, bounds[c - 1]);
+                if (cut == body)
+                {
+                    bounds[c] = body;
+                    continue;
+                }
+                auto const end = text.find('\n', cut - 1);
+                bounds[c] = end == std::string_view::npos ? text.size() : end + 1;
+            }
+
+            // every line holds at most one entry, or two for a symmetric matrix
+            std::size_t const per_line = format.sym == symmetry::general ? 1 : 2;
+            std::vector<std::size_t> room(num_chunks + 1, list.entries.size());
+            pool.parallel_for(num_chunks,
+                              [&](std::size_t c)
+                              {
+                                  auto const lines = bounds[c] == bounds[c + 1]
+                                                         ? 0
+                                                         : std::count(text.begin() + bounds[c],
+                                                                      text.begin() + bounds[c + 1],
+                                                                      '\n')
+                                                               + 1;
+                                  room[c + 1] = per_line * static_cast<std::size_t>(lines);
+                              });
+            for (std::size_t c = 0; c < num_chunks; ++c)
+            {
+                room[c + 1] += room[c];
+            }
+            list.entries.resize(room[num_chunks]);
+
+            std::vector<chunk_result<N, IK, V>> chunks(num_chunks);
+            pool.parallel_for(num_chunks,
+                              [&](std::size_t c)
+                              {
+                                  chunks[c].entries = list.entries.data() + room[c];
+                                  parse_lines(text.data() + bounds[c],
+                                              text.data() + bounds[c + 1],
+                                              text.data(),
+                                              format,
+                                              chunks[c],
+                                              std::make_index_sequence<N>{});
+                              });
+
+            std::size_t size = room[0];
+            std::size_t num_lines = 0;
+            for (std::size_t c = 0; c < num_chunks; ++c)
+            {
+                if (chunks[c].error)
+                {
+                    throw std::runtime_error(
+                        "line " + std::to_string(line_number(text, chunks[c].error_offset))
+                        + ": " + chunks[c].error);
+                }
+                // the entries before the chunk never reach past its first entry
+                auto* const first = chunks[c].entries;
+                if (list.entries.data() + size != first)
+                {
+                    std::move(first, first + chunks[c].num_entries, list.entries.data() + size);
+                }
+                size += chunks[c].num_entries;
+                num_lines += chunks[c].num_lines;
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    list.shape[k] = std::max(list.shape[k], chunks[c].extent[k]);
+                }
+            }
+            list.entries.resize(size);
+            return num_lines;
+        }
+
+        inline std::vector<std::string> split_words(std::string_view line)
+        {
+            std::vector<std::string> words;
+            auto const* p = line.data();
+            auto const* const last = line.data() + line.size();
+            while ((p = skip_blanks(p, last)) != last)
+            {
+                auto const* const word = p;
+                while (p != last && !is_blank(*p))
+                {
+                    ++p;
+                }
+                words.emplace_back(word, p);
+                std::transform(words.back().begin(),
+                               words.back().end(),
+                               words.back().begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            }
+            return words;
+        }
+
+        template <class F>
+        inline auto read_file(std::string const& path, F&& parse)
+        /**
+         * @brief Map `path` into memory and parse its contents, naming the file in errors.
+         */
+        {
+            mapped_region const region(path);
+            try
+            {
+                return parse(std::string_view(reinterpret_cast<char const*>(region.data()),
+                                              region.size()));
+            }
+            catch (std::runtime_error const& e)
+            {
+                throw std::runtime_error(path + ": " + e.what());
+            }
+        }
+
+        template <class Entry, std::size_t... J>
+        inline bool coordinates_less(Entry const& a,
+                                     Entry const& b,
+                                     [[maybe_unused]] std::index_sequence<J...> j) noexcept
+        {
+            return std::tie(std::get<J>(a)...) < std::tie(std::get<J>(b)...);
+        }
+    }
+
+    template <class IK, class V>
+    inline coordinate_list<2, IK, V> parse_matrix_market(
+        std::string_view text, util::work_stealing_pool& pool = util::default_pool())
+    /**
+     * @brief Parse a sparse matrix in the MatrixMarket coordinate format.
+     *
+     * @details The `real`, `double`, `integer` and `pattern` fields are supported, the latter
+     * with values of 1. The entries of `symmetric` and `skew-symmetric` (or, for real fields,
+     * `hermitian`) matrices are expanded: every off-diagonal entry is followed by its
+     * transpose. The shape is the one of the size line, which must also give the number of
+     * entries in the file. Throws `std::runtime_error` if the text is malformed.
+     */
+    {
+        std::string_view line;
+        std::size_t pos = detail::next_line(text, 0, line);
+        auto const banner = detail::split_words(line);
+        if (banner.size() != 5 || banner[0] != "%%matrixmarket" || banner[1] != "matrix")
+        {
+            throw std::runtime_error("line 1: expected a MatrixMarket matrix banner");
+        }
+        if (banner[2] != "coordinate")
+        {
+            throw std::runtime_error("line 1: only the coordinate format is supported");
+        }
+
+        detail::line_format<2, IK> format;
+        if (banner[3] == "pattern")
+        {
+            format.pattern = true;
+        }
+        else if (banner[3] != "real" && banner[3] != "double" && banner[3] != "integer")
+        {
+            throw std::runtime_error("line 1: unsupported field " + banner[3]);
+        }
+        if (banner[4] == "symmetric" || banner[4] == "hermitian")
+        {
+            format.sym = detail::symmetry::symmetric;
+        }
+        else if (banner[4] == "skew-symmetric" && !format.pattern)
+        {
+            format.sym = detail::symmetry::skew_symmetric;
+        }
+        else if (banner[4] != "general")
+        {
+            throw std::runtime_error("line 1: unsupported symmetry " + banner[4]);
+        }
+
+        // the size line is the first one that is not empty or a comment
+        std::size_t size_line = pos;
+        do
+        {
+            if (pos == text.size())
+            {
+                throw std::runtime_error("missing size line");
+            }
+            size_line = pos;
+            pos = detail::next_line(text, pos, line);
+        } while (line.find_first_not_of(" \t\r") == std::string_view::npos
+                 || line[line.find_first_not_of(" \t\r")] == '%');
+
+        std::array<std::uint64_t, 3> sizes{};
+        auto const* p = line.data();
+        auto const* const last = line.data() + line.size();
+        for (auto& size : sizes)
+        {
+            if (!detail::parse_number(p, last, size))
+            {
+                throw std::runtime_error(
+                    "line " + std::to_string(detail::line_number(text, size_line))
+                    + ": expected the number of rows, columns and entries");
+            }
+        }
+        for (std::size_t k = 0; k < 2; ++k)
+        {
+            if (sizes[k] > static_cast<std::uint64_t>(std::numeric_limits<IK>::max()))
+            {
+                throw std::runtime_error("the matrix is too large for its coordinate type");
+            }
+            format.shape[k] = static_cast<IK>(sizes[k]);
+        }
+        format.bounded = true;
+
+        coordinate_list<2, IK, V> list;
+        list.shape = format.shape;
+        if (detail::parse_body(text, pos, format, list, pool) != sizes[2])
+        {
+            throw std::runtime_error("expected " + std::to_string(sizes[2]) + " entries");
+        }
+        return list;
+    }
+
+    template <class IK, class V>
+    inline coordinate_list<2, IK, V> read_matrix_market(
+        std::string const& path, util::work_stealing_pool& pool = util::default_pool())
+    /**
+     * @brief Read a sparse matrix from a MatrixMarket (`.mtx`) file, see
+     * `parse_matrix_market`.
+     */
+    {
+        return detail::read_file(path,
+                                 [&](std::string_view text)
+                                 { return parse_matrix_market<IK, V>(text, pool); });
+    }
+
+    template <std::size_t N, class IK, class V>
+    inline coordinate_list<N, IK, V> parse_tns(
+        std::string_view text, util::work_stealing_pool& pool = util::default_pool())
+    /**
+     * @brief Parse a sparse tensor of order `N` in the FROSTT format: one entry per line, as
+     * `N` coordinates and a value, with comment lines starting with `#`.
+     *
+     * @details The format records no shape, so the extent of every dimension is its largest
+     * coordinate. Throws `std::runtime_error` if the text is malformed.
+     */
+    {
+        coordinate_list<N, IK, V> list;
+        detail::parse_body(text, 0, detail::line_format<N, IK>{}, list, pool);
+        return list;
+    }
+
+    template <std::size_t N, class IK, class V>
+    inline coordinate_list<N, IK, V> read_tns(std::string const& path,
+                                              util::work_stealing_pool& pool
+                                              = util::default_pool())
+    /**
+     * @brief Read a sparse tensor from a FROSTT (`.tns`) file, see `parse_tns`.
+     */
+    {
+        return detail::read_file(path,
+                                 [&](std::string_view text)
+                                 { return parse_tns<N, IK, V>(text, pool); });
+    }
+
+    template <class... Levels, class Data, std::size_t N, class IK, class V>
+    inline void assemble(Tensor<std::tuple<Levels...>, Data>& tensor,
+                         coordinate_list<N, IK, V>& list)
+    /**
+     * @brief Fill the empty levels and data of `tensor` with the entries of `list`.
+     *
+     * @details If any level is appended to, the entries are first sorted by their
+     * coordinates, keeping the file order of duplicates, so that the last of them is stored.
+     */
+    {
+        static_assert(sizeof...(Levels) == N, "The tensor must have one level per dimension");
+
+        if constexpr ((has_append_coord_v<Levels> || ...))
+        {
+            auto const less = [](auto const& a, auto const& b)
+            { return detail::coordinates_less(a, b, std::make_index_sequence<N>{}); };
+            if (!std::is_sorted(list.entries.begin(), list.entries.end(), less))
+            {
+                std::stable_sort(list.entries.begin(), list.entries.end(), less);
+            }
+        }
+        tensor.assemble(list.entries.begin(), list.entries.end());
+    }
+}
+
+#endif  // XSPARSE_IO_TEXT_HPP
@@ -0,0 +1,343 @@
+#ifndef XSPARSE_KERNELS_SPGEMM_HPP
+#define XSPARSE_KERNELS_SPGEMM_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/util/thread_pool.hpp>
+#include <xsparse/util/workspace.hpp>
+
+namespace xsparse::kernels
+{
+    namespace detail
+    {
+        template <class IK, class V>
+        class row_accumulator
+        /**
+         * @brief Accumulates the products that make up one row of `C = A * B` and hands them
+         * out sorted by column.
+         *
+         * @details Rows with many products compared to the number of columns go into a
+         * `util::workspace` over all columns, which is cleared in time proportional to the
+         * columns it holds. Other rows go into an open addressing hash table with at least
+         * twice as many slots as products, which stays in cache however many columns `C` has.
+         * One accumulator is reused for many rows.
+         */
+        {
+        private:
+            static constexpr IK EMPTY = std::numeric_limits<IK>::max();
+            // rows with at least `cols / DENSE_RATIO` products use the workspace
+            static constexpr std::size_t DENSE_RATIO = 16;
+
+            std::size_t m_cols;
+            bool m_dense = false;
+
+            util::workspace<IK, V> m_workspace;
+
+            std::vector<IK> m_keys;
+            std::vector<std::size_t> m_slots;
+            std::vector<std::pair<IK, V>> m_entries;
+            std::size_t m_mask = 0;
+            int m_shift = 0;
+
+            inline std::size_t slot(IK col) const noexcept
+            {
+                // Fibonacci hashing spreads consecutive columns over the table
+                return static_cast<std::size_t>(
+                    (static_cast<std::uint64_t>(col) * 0x9E3779B97F4A7C15ull) >> m_shift);
+            }
+
+        public:
+            explicit row_accumulator(std::size_t cols)
+                : m_cols(cols)
+            {
+            }
+
+            inline void start(std::size_t flops)
+            /**
+             * @brief Prepares for a row with `flops` products.
+             */
+            {
+                m_dense = flops * DENSE_RATIO >= m_cols;
+                if (m_dense)
+                {
+                    if (m_workspace.size() != m_cols)
+                    {
+                        m_workspace.resize(m_cols);
+                    }
+                }
+                else
+                {
+                    auto const capacity = std::bit_ceil(std::max<std::size_t>(2 * flops, 8));
+                    if (m_keys.size() < capacity)
+                    {
+                        m_keys.assign(capacity, EMPTY);
+                        m_slots.resize(capacity);
+                    }
+                    m_mask = capacity - 1;
+                    m_shift = 64 - std::countr_zero(capacity);
+                }
+            }
+
+            inline void add(IK col, V value)
+            {
+                if (m_dense)
+                {
+                    m_workspace.accumulate(col, value);
+                }
+                else
+                {
+                    for (std::size_t s = slot(col);; s = (s + 1) & m_mask)
+                    {
+                        if (m_keys[s] == col)
+                        {
+                            m_entries[m_slots[s]].second += value;
+                            return;
+                        }
+                        if (m_keys[s] == EMPTY)
+                        {
+                            m_keys[s] = col;
+                            m_slots[s] = m_entries.size();
+                            m_entries.emplace_back(col, value);
+                            return;
+                        }
+                    }
+                }
+            }
+
+            inline std::size_t size() const noexcept
+            {
+                return m_dense ? m_workspace.nnz() : m_entries.size();
+            }
+
+            template <class F>
+            inline void finish(F&& emit)
+            /**
+             * @brief Calls `emit(col, value)` for the columns of the row in increasing order
+             * and clears the accumulator.
+             */
+            {
+                if (m_dense)
+                {
+                    m_workspace.gather(emit);
+                    return;
+                }
+                std::sort(m_entries.begin(),
+                          m_entries.end(),
+                          [](auto const& a, auto const& b) { return a.first < b.first; });
+                for (auto const& [col, value] : m_entries)
+                {
+                    emit(col, value);
+                }
+                clear();
+            }
+
+            inline void clear() noexcept
+            {
+                if (m_dense)
+                {
+                    m_workspace.clear();
+                }
+                else
+                {
+                    std::fill(m_keys.begin(),
+                              m_keys.begin() + static_cast<std::ptrdiff_t>(m_mask + 1),
+                              EMPTY);
+                    m_entries.clear();
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief Sparse matrix-matrix product `C = A * B` of CSR matrices, with Gustavson's
+     * algorithm.
+     *
+     * @details All three matrices are `Tensor`s of a `dense` level over the rows and a
+     * `compressed` level over the columns, and the levels and data of `C` must be empty. Row
+     * `r` of `C` is the sum of the rows `B[k, :]` scaled by `A[r, k]`, which are merged in a
+     * `detail::row_accumulator`: a `util::workspace` for rows with many products compared to
+     * the columns of `C`, otherwise a hash table.
+     *
+     * The product runs in two phases: a symbolic one that counts the nonzeros of every row of
+     * `C`, and a numeric one that writes the sorted columns and values of every row at its
+     * offset in the output. Both split the rows into a few chunks per thread of `pool` with
+     * about the same number of products, and every chunk reuses one accumulator for its rows.
+     * The columns are then handed to the compressed level of `C` through its `append_*`
+     * protocol, as `level_capabilities::Assemble` does.
+     *
+     * @param A - the left operand, with as many columns as `B` has rows.
+     * @param B - the right operand.
+     * @param C - the empty result, with as many rows as `A` and as many columns as `B`.
+     *
+     * @throws std::invalid_argument if the shapes do not match or `C` is not empty.
+     */
+    template <class DenseA,
+              class InnerA,
+              class DataA,
+              class DenseB,
+              class InnerB,
+              class DataB,
+              class DenseC,
+              class InnerC,
+              class DataC>
+    inline void spgemm(Tensor<std::tuple<DenseA, InnerA>, DataA> const& A,
+                       Tensor<std::tuple<DenseB, InnerB>, DataB> const& B,
+                       Tensor<std::tuple<DenseC, InnerC>, DataC>& C,
+                       util::work_stealing_pool& pool = util::default_pool())
+    {
+        static_assert(util::is_specialization_of_v<DenseA, levels::dense>
+                          && util::is_specialization_of_v<DenseB, levels::dense>
+                          && util::is_specialization_of_v<DenseC, levels::dense>,
+                      "The outer levels must be dense");
+        static_assert(util::is_specialization_of_v<InnerA, levels::compressed>
+                          && util::is_specialization_of_v<InnerB, levels::compressed>
+                          && util::is_specialization_of_v<InnerC, levels::compressed>,
+                      "The inner levels must be compressed");
+
+        auto const [rows_a, cols_a] = A.get_levels();
+        auto const [rows_b, cols_b] = B.get_levels();
+        auto [rows_c, cols_c] = C.get_levels();
+        auto const num_rows = static_cast<std::size_t>(rows_a.size());
+        auto const num_cols = static_cast<std::size_t>(cols_b.size());
+        if (static_cast<std::size_t>(cols_a.size()) != static_cast<std::size_t>(rows_b.size()))
+        {
+            throw std::invalid_argument("The columns of `A` must match the rows of `B`");
+        }
+        if (static_cast<std::size_t>(rows_c.size()) != num_rows
+            || static_cast<std::size_t>(cols_c.size()) != num_cols)
+        {
+            throw std::invalid_argument("`C` must have the rows of `A` and the columns of `B`");
+        }
+        if (!cols_c.get_crd().empty() || !C.get_data().empty())
+        {
+            throw std::invalid_argument("`C` must be empty");
+        }
+
+        auto const& pos_a = cols_a.get_pos();
+        auto const& crd_a = cols_a.get_crd();
+        auto const& pos_b = cols_b.get_pos();
+        auto const& crd_b = cols_b.get_crd();
+        auto const& data_a = A.get_data();
+        auto const& data_b = B.get_data();
+        auto& data_c = C.get_data();
+
+        using IK = typename InnerC::BaseTraits::IK;
+        using PK = typename InnerC::BaseTraits::PK;
+        using V = typename DataC::value_type;
+        if (num_rows == 0)
+        {
+            cols_c.append_init(0);
+            cols_c.append_finalize(0);
+            return;
+        }
+
+        // the products of every row, and chunks of rows with about as many of them
+        std::vector<std::size_t> flops(num_rows + 1);
+        for (std::size_t r = 0; r < num_rows; ++r)
+        {
+            std::size_t f = 0;
+            for (auto p = static_cast<std::size_t>(pos_a[r]);
+                 p < static_cast<std::size_t>(pos_a[r + 1]);
+                 ++p)
+            {
+                auto const k = static_cast<std::size_t>(crd_a[p]);
+                f += static_cast<std::size_t>(pos_b[k + 1]) - static_cast<std::size_t>(pos_b[k]);
+            }
+            flops[r + 1] = flops[r] + f;
+        }
+        std::size_t const num_chunks = std::min(num_rows, 4 * pool.size());
+        std::vector<std::size_t> bounds(num_chunks + 1);
+        bounds[num_chunks] = num_rows;
+        for (std::size_t c = 1; c < num_chunks; ++c)
+        {
+            auto const target = c * flops[num_rows] / num_chunks;
+            bounds[c] = static_cast<std::size_t>(
+                std::lower_bound(flops.begin(), flops.end() - 1, target) - flops.begin());
+            bounds[c] = std::max(bounds[c], bounds[c - 1]);
+        }
+
+        auto const accumulate_row = [&](detail::row_accumulator<IK, V>& acc, std::size_t r)
+        {
+            acc.start(flops[r + 1] - flops[r]);
+            for (auto p = static_cast<std::size_t>(pos_a[r]);
+                 p < static_cast<std::size_t>(pos_a[r + 1]);
+                 ++p)
+            {
+                auto const k = static_cast<std::size_t>(crd_a[p]);
+                V const a = static_cast<V>(data_a[p]);
+                for (auto q = static_cast<std::size_t>(pos_b[k]);
+                     q < static_cast<std::size_t>(pos_b[k + 1]);
+                     ++q)
+                {
+                    acc.add(static_cast<IK>(crd_b[q]), a * static_cast<V>(data_b[q]));
+                }
+            }
+        };
+
+        // symbolic phase: the nonzeros of every row
+        std::vector<std::size_t> offset(num_rows + 1);
+        pool.parallel_for(num_chunks,
+                          [&](std::size_t c)
+                          {
+                              detail::row_accumulator<IK, V> acc(num_cols);
+                              for (std::size_t r = bounds[c]; r < bounds[c + 1]; ++r)
+                              {
+                                  accumulate_row(acc, r);
+                                  offset[r + 1] = acc.size();
+                                  acc.clear();
+                              }
+                          });
+        for (std::size_t r = 0; r < num_rows; ++r)
+        {
+            offset[r + 1] += offset[r];
+        }
+
+        // numeric phase: the sorted columns and values of every row at its offset
+        std::vector<IK> crd(offset[num_rows]);
+        data_c.resize(offset[num_rows]);
+        pool.parallel_for(num_chunks,
+                          [&](std::size_t c)
+                          {
+                              detail::row_accumulator<IK, V> acc(num_cols);
+                              for (std::size_t r = bounds[c]; r < bounds[c + 1]; ++r)
+                              {
+                                  accumulate_row(acc, r);
+                                  auto out = offset[r];
+                                  acc.finish(
+                                      [&](IK col, V value)
+                                      {
+                                          crd[out] = col;
+                                          data_c[out] = value;
+                                          ++out;
+                                      });
+                              }
+                          });
+
+        cols_c.append_init(num_rows);
+        for (std::size_t r = 0; r < num_rows; ++r)
+        {
+            cols_c.append_edges(static_cast<typename InnerC::BaseTraits::PKM1>(r),
+                                static_cast<PK>(offset[r]),
+                                static_cast<PK>(offset[r + 1]));
+        }
+        for (auto const col : crd)
+        {
+            cols_c.append_coord(col);
+        }
+        cols_c.append_finalize(num_rows);
+    }
+}
+
+#endif  // XSPARSE_KERNELS_SPGEMM_HPP
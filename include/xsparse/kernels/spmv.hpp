@@ -0,0 +1,392 @@
+#ifndef XSPARSE_KERNELS_SPMV_HPP
+#define XSPARSE_KERNELS_SPMV_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <xsparse/levels/blocked.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/packed.hpp>
+#include <xsparse/levels/sell.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+
+namespace xsparse::kernels
+{
+    namespace detail
+    {
+        template <class V, class IK, class X>
+        inline V dot_scalar(V const* vals, IK const* crd, X const& x, std::size_t n) noexcept
+        {
+            V sum = 0;
+            for (std::size_t p = 0; p < n; ++p)
+            {
+                sum += vals[p] * x[crd[p]];
+            }
+            return sum;
+        }
+
+#if defined(__AVX2__)
+        inline double hsum(__m256d v) noexcept
+        {
+            __m128d lo = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+        }
+
+        inline float hsum(__m256 v) noexcept
+        {
+            __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+            return _mm_cvtss_f32(_mm_add_ss(lo, _mm_movehdup_ps(lo)));
+        }
+
+        inline __m256d fmadd(__m256d a, __m256d b, __m256d c) noexcept
+        {
+#if defined(__FMA__)
+            return _mm256_fmadd_pd(a, b, c);
+#else
+            return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+        }
+
+        inline __m256 fmadd(__m256 a, __m256 b, __m256 c) noexcept
+        {
+#if defined(__FMA__)
+            return _mm256_fmadd_ps(a, b, c);
+#else
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+        }
+#endif
+
+        template <class V, class IK>
+        inline constexpr bool has_simd_dot_v
+            = (std::is_same_v<V, double> && (sizeof(IK) == 8 || sizeof(IK) == 4))
+              || (std::is_same_v<V, float> && sizeof(IK) == 4);
+
+        template <class V, class IK>
+        inline V dot_gather(V const* vals, IK const* crd, V const* x, std::size_t n) noexcept
+        /**
+         * @brief `sum(vals[p] * x[crd[p]])` over a row, gathering `x` with SIMD instructions.
+         *
+         * @details Uses AVX-512 or AVX2 gathers if the translation unit is compiled for them
+         * (e.g. with `-march=native`), and a scalar loop for the remainder of the row and on
+         * other targets. The coordinates are gathered as unsigned offsets, so they must be
+         * smaller than 2^31 for 32-bit and 2^63 for 64-bit coordinates.
+         */
+        {
+            std::size_t p = 0;
+            V sum = 0;
+#if defined(__AVX512F__)
+            if constexpr (std::is_same_v<V, double> && sizeof(IK) == 8)
+            {
+                __m512d acc0 = _mm512_setzero_pd();
+                __m512d acc1 = _mm512_setzero_pd();
+                for (; p + 16 <= n; p += 16)
+                {
+                    __m512i i0 = _mm512_loadu_si512(crd + p);
+                    __m512i i1 = _mm512_loadu_si512(crd + p + 8);
+                    acc0 = _mm512_fmadd_pd(
+                        _mm512_loadu_pd(vals + p), _mm512_i64gather_pd(i0, x, 8), acc0);
+                    acc1 = _mm512_fmadd_pd(
+                        _mm512_loadu_pd(vals + p + 8), _mm512_i64gather_pd(i1, x, 8), acc1);
+                }
+                sum = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+            }
+            else if constexpr (std::is_same_v<V, double> && sizeof(IK) == 4)
+            {
+                __m512d acc = _mm512_setzero_pd();
+                for (; p + 8 <= n; p += 8)
+                {
+                    __m256i i = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(crd + p));
+                    acc = _mm512_fmadd_pd(
+                        _mm512_loadu_pd(vals + p), _mm512_i32gather_pd(i, x, 8), acc);
+                }
+                sum = _mm512_reduce_add_pd(acc);
+            }
+            else if constexpr (std::is_same_v<V, float> && sizeof(IK) == 4)
+            {
+                __m512 acc = _mm512_setzero_ps();
+                for (; p + 16 <= n; p += 16)
+                {
+                    __m512i i = _mm512_loadu_si512(crd + p);
+                    acc = _mm512_fmadd_ps(
+                        _mm512_loadu_ps(vals + p), _mm512_i32gather_ps(i, x, 4), acc);
+                }
+                sum = _mm512_reduce_add_ps(acc);
+            }
+#elif defined(__AVX2__)
+            if constexpr (std::is_same_v<V, double> && sizeof(IK) == 8)
+            {
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                for (; p + 8 <= n; p += 8)
+                {
+                    __m256i i0 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(crd + p));
+                    __m256i i1
+                        = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(crd + p + 4));
+                    acc0 = fmadd(
+                        _mm256_loadu_pd(vals + p), _mm256_i64gather_pd(x, i0, 8), acc0);
+                    acc1 = fmadd(
+                        _mm256_loadu_pd(vals + p + 4), _mm256_i64gather_pd(x, i1, 8), acc1);
+                }
+                sum = hsum(_mm256_add_pd(acc0, acc1));
+            }
+            else if constexpr (std::is_same_v<V, double> && sizeof(IK) == 4)
+            {
+                __m256d acc = _mm256_setzero_pd();
+                for (; p + 4 <= n; p += 4)
+                {
+                    __m128i i = _mm_loadu_si128(reinterpret_cast<__m128i const*>(crd + p));
+                    acc = fmadd(_mm256_loadu_pd(vals + p), _mm256_i32gather_pd(x, i, 8), acc);
+                }
+                sum = hsum(acc);
+            }
+            else if constexpr (std::is_same_v<V, float> && sizeof(IK) == 4)
+            {
+                __m256 acc = _mm256_setzero_ps();
+                for (; p + 8 <= n; p += 8)
+                {
+                    __m256i i = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(crd + p));
+                    acc = fmadd(_mm256_loadu_ps(vals + p), _mm256_i32gather_ps(x, i, 4), acc);
+                }
+                sum = hsum(acc);
+            }
+#endif
+            return sum + dot_scalar(vals + p, crd + p, x, n - p);
+        }
+    }
+
+    namespace detail
+    {
+        template <class Dense, class Sell, class Data, class X, class Y>
+        inline void spmv_sell(Tensor<std::tuple<Dense, Sell>, Data> const& A, X const& x, Y& y)
+        /**
+         * @brief `y = A * x` for a matrix `A` with a `sell` column level.
+         *
+         * @details Keeps one sum per lane of a slice and adds a column of the slice to them
+         * at a time, which vectorizes across the lanes for the compile-time slice size.
+         * Padding holds zeros, so it needs no special treatment.
+         */
+        {
+            constexpr std::size_t C = Sell::SLICE_SIZE;
+            auto const [rows, sell] = A.get_levels();
+            auto const& crd = sell.get_crd();
+            auto const& data = A.get_data();
+            auto const num_rows = static_cast<std::size_t>(rows.size());
+
+            using V = typename Data::value_type;
+
+            for (std::size_t s = 0; s < sell.num_slices(); ++s)
+            {
+                std::array<V, C> sums{};
+                auto const [begin, end] = sell.slice_bounds(s);
+                for (auto q = static_cast<std::size_t>(begin); q < static_cast<std::size_t>(end);
+                     q += C)
+                {
+                    for (std::size_t l = 0; l < C; ++l)
+                    {
+                        sums[l] += data[q + l] * x[crd[q + l]];
+                    }
+                }
+                for (std::size_t l = 0; l < C; ++l)
+                {
+                    auto const r = static_cast<std::size_t>(sell.slice_row(s * C + l));
+                    if (r < num_rows)
+                    {
+                        y[r] = sums[l];
+                    }
+                }
+            }
+        }
+
+        template <class Dense, class Packed, class Data, class X, class Y>
+        inline void spmv_packed(Tensor<std::tuple<Dense, Packed>, Data> const& A,
+                                X const& x,
+                                Y& y)
+        /**
+         * @brief `y = A * x` for a matrix `A` with a `packed` column level.
+         *
+         * @details Decodes the coordinates of a row a block at a time into a buffer on the
+         * stack and takes the dot product of every block with the gather kernel.
+         */
+        {
+            constexpr std::size_t B = Packed::BLOCK_SIZE;
+            auto const [rows, packed] = A.get_levels();
+            auto const& data = A.get_data();
+            auto const num_rows = static_cast<std::size_t>(rows.size());
+
+            using V = typename Data::value_type;
+            using IK = typename Packed::BaseTraits::IK;
+
+            std::array<IK, B> buf;
+            for (std::size_t r = 0; r < num_rows; ++r)
+            {
+                auto const [begin, end] = packed.pos_bounds(r);
+                auto p = static_cast<std::size_t>(begin);
+                V sum = 0;
+                for (std::size_t k = 0; p < static_cast<std::size_t>(end); ++k)
+                {
+                    auto const n = packed.decode(r, k, buf.data());
+                    if constexpr (has_simd_dot_v<V, IK> && requires { data.data(), x.data(); }
+                                  && std::is_same_v<std::remove_cv_t<std::remove_reference_t<
+                                                        decltype(x[0])>>,
+                                                    V>)
+                    {
+                        sum += dot_gather(data.data() + p, buf.data(), x.data(), n);
+                    }
+                    else
+                    {
+                        sum += dot_scalar(&data[p], buf.data(), x, n);
+                    }
+                    p += n;
+                }
+                y[r] = sum;
+            }
+        }
+    }
+
+    /**
+     * @brief Sparse matrix-vector product `y = A * x` for a CSR, packed CSR or SELL-C-sigma
+     * matrix `A`.
+     *
+     * @details `A` is a `Tensor` of a `dense` row level and a `compressed`, `packed` or `sell`
+     * column level. A `sell` level is handled by a kernel that works on all lanes of a slice at
+     * once, and a `packed` level is decoded a block at a time before the gather. The
+     * kernel reads the `pos`/`crd` arrays of the compressed level and the data of `A` directly,
+     * instead of going through `iter_helper`, so that the inner loop over a row can be
+     * vectorized. If the data, coordinates and `x` are contiguous and of a supported type
+     * (double with 32 or 64-bit coordinates, float with 32-bit coordinates), the inner loop
+     * gathers `x` with AVX2/AVX-512 where available, otherwise it is a scalar loop.
+     *
+     * @param A - the CSR, packed CSR or SELL-C-sigma matrix.
+     * @param x - the dense input vector, with at least as many elements as `A` has columns.
+     * @param y - the dense output vector, with at least as many elements as `A` has rows.
+     */
+    template <class Dense, class Inner, class Data, class X, class Y>
+    inline void spmv(Tensor<std::tuple<Dense, Inner>, Data> const& A, X const& x, Y& y)
+    {
+        static_assert(util::is_specialization_of_v<Dense, levels::dense>,
+                      "The outer level of `A` must be dense");
+        static_assert(util::is_specialization_of_v<Inner, levels::compressed>
+                          || util::is_specialization_of_v<Inner, levels::packed>
+                          || util::is_specialization_of_v<Inner, levels::sell>,
+                      "The inner level of `A` must be compressed, packed or sell");
+
+        if constexpr (util::is_specialization_of_v<Inner, levels::sell>)
+        {
+            detail::spmv_sell(A, x, y);
+        }
+        else if constexpr (util::is_specialization_of_v<Inner, levels::packed>)
+        {
+            detail::spmv_packed(A, x, y);
+        }
+        else
+        {
+            auto const [rows, compressed] = A.get_levels();
+            auto const& pos = compressed.get_pos();
+            auto const& crd = compressed.get_crd();
+            auto const& data = A.get_data();
+            auto const num_rows = static_cast<std::size_t>(rows.size());
+
+            using V = typename Data::value_type;
+            using IK = std::remove_cv_t<std::remove_reference_t<decltype(crd[0])>>;
+
+            for (std::size_t r = 0; r < num_rows; ++r)
+            {
+                auto const begin = static_cast<std::size_t>(pos[r]);
+                auto const end = static_cast<std::size_t>(pos[r + 1]);
+
+                if constexpr (detail::has_simd_dot_v<V, IK>
+                              && requires { data.data(), crd.data(), x.data(); }
+                              && std::is_same_v<std::remove_cv_t<std::remove_reference_t<
+                                                    decltype(x[0])>>,
+                                                V>)
+                {
+                    y[r] = detail::dot_gather(
+                        data.data() + begin, crd.data() + begin, x.data(), end - begin);
+                }
+                else
+                {
+                    V sum = 0;
+                    for (std::size_t p = begin; p < end; ++p)
+                    {
+                        sum += data[p] * x[crd[p]];
+                    }
+                    y[r] = sum;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Sparse matrix-vector product `y = A * x` for a BCSR matrix `A` with square blocks.
+     *
+     * @details `A` is a `Tensor` of a `dense` level over the block rows, a `blocked` level over
+     * the columns and a `dense` level of size `BLOCK_SIZE` over the rows of a block, so that
+     * every block is stored column by column. The kernel keeps the `BLOCK_SIZE` sums of a block
+     * row in registers and adds every column of a block to them, scaled by one element of `x`,
+     * which the compiler unrolls and vectorizes for the compile-time block size. Only one
+     * coordinate is read per block.
+     *
+     * @param A - the BCSR matrix, whose numbers of rows and columns are multiples of the block
+     * size.
+     * @param x - the dense input vector, with at least as many elements as `A` has columns.
+     * @param y - the dense output vector, with at least as many elements as `A` has rows.
+     */
+    template <class Dense, class Blocked, class Inner, class Data, class X, class Y>
+    inline void spmv(Tensor<std::tuple<Dense, Blocked, Inner>, Data> const& A, X const& x, Y& y)
+    {
+        static_assert(util::is_specialization_of_v<Dense, levels::dense>,
+                      "The outer level of `A` must be dense");
+        static_assert(util::is_specialization_of_v<Blocked, levels::blocked>,
+                      "The middle level of `A` must be blocked");
+        static_assert(util::is_specialization_of_v<Inner, levels::dense>,
+                      "The inner level of `A` must be dense");
+
+        constexpr std::size_t B = Blocked::BLOCK_SIZE;
+        auto const [block_rows, blocked, inner] = A.get_levels();
+        if (static_cast<std::size_t>(inner.size()) != B)
+        {
+            throw std::invalid_argument("The inner level of `A` must have the block size");
+        }
+        auto const& data = A.get_data();
+        auto const num_block_rows = static_cast<std::size_t>(block_rows.size());
+
+        using V = typename Data::value_type;
+
+        for (std::size_t br = 0; br < num_block_rows; ++br)
+        {
+            std::array<V, B> sums{};
+            auto const [b_begin, b_end] = blocked.block_bounds(br);
+            for (auto b = b_begin; b < b_end; ++b)
+            {
+                auto const col = static_cast<std::size_t>(blocked.block_access(b));
+                auto const tile = static_cast<std::size_t>(b) * B * B;
+                for (std::size_t c = 0; c < B; ++c)
+                {
+                    auto const xc = x[col + c];
+                    for (std::size_t r = 0; r < B; ++r)
+                    {
+                        sums[r] += data[tile + c * B + r] * xc;
+                    }
+                }
+            }
+            for (std::size_t r = 0; r < B; ++r)
+            {
+                y[br * B + r] = sums[r];
+            }
+        }
+    }
+}
+
+#endif  // XSPARSE_KERNELS_SPMV_HPP
@@ -1,5 +1,390 @@
 #ifndef XSPARSE_ASSEMBLY_HPP
 #define XSPARSE_ASSEMBLY_HPP
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <xsparse/level_capabilities/locate.hpp>
+#include <xsparse/util/base_traits.hpp>
+
+/**
+ * @brief The following code is used to determine which assembly protocol a level supports.
+ *
+ * - `append_coord`: levels that are appended to in order (e.g. compressed, singleton). Levels
+ * that also have `append_edges` record the number of children of every parent position.
+ * - `insert_coord`: levels that are inserted into in any order (e.g. hashed).
+ * - `coord_access`: levels whose positions are computed from the coordinate (e.g. dense).
+ */
+
+template <class T, class = void>
+struct has_append_coord : std::false_type
+{
+};
+
+template <class T>
+struct has_append_coord<T, std::void_t<decltype(&T::append_coord)>> : std::true_type
+{
+};
+
+template <class T>
+inline constexpr bool has_append_coord_v = has_append_coord<T>::value;
+
+template <class T, class = void>
+struct has_append_edges : std::false_type
+{
+};
+
+template <class T>
+struct has_append_edges<T, std::void_t<decltype(&T::append_edges)>> : std::true_type
+{
+};
+
+template <class T>
+inline constexpr bool has_append_edges_v = has_append_edges<T>::value;
+
+template <class T, class = void>
+struct has_insert_coord : std::false_type
+{
+};
+
+template <class T>
+struct has_insert_coord<T, std::void_t<decltype(&T::insert_coord)>> : std::true_type
+{
+};
+
+template <class T>
+inline constexpr bool has_insert_coord_v = has_insert_coord<T>::value;
+
+template <class T, class = void>
+struct has_coord_access : std::false_type
+{
+};
+
+template <class T>
+struct has_coord_access<T, std::void_t<decltype(&T::coord_access)>> : std::true_type
+{
+};
+
+template <class T>
+inline constexpr bool has_coord_access_v = has_coord_access<T>::value;
+
+namespace xsparse::level_capabilities
+{
+    /**
+     * @brief Builds a tensor level by level from a stream of `(coordinates..., value)` entries.
+     *
+     * @details Every entry is pushed through the assembly protocol of each level in a single
+     * pass, and its value is written to the data container at the position of the last level:
+     *
+     * - append levels (`append_coord`, plus `append_init`, `append_edges` and
+     * `append_finalize` for levels with edges) receive their coordinates in order;
+     * - insert levels (`insert_init`, `insert_coord`) receive them in any order, and an
+     * existing coordinate is found again with `locate`;
+     * - levels with `coord_access` (e.g. dense) compute their positions directly.
+     *
+     * The levels must be empty when assembly starts. If any level is appended to, the entries
+     * must be sorted lexicographically by coordinate, otherwise `std::invalid_argument` is
+     * thrown. Entries with the same coordinates as a previous one overwrite its value, unless
+     * a level stores duplicates (it is not unique, or is followed by a branchless level).
+     * `finalize` must be called once after the last entry.
+     *
+     * @tparam Levels - the levels to assemble, outermost first.
+     * @tparam Data - the container that the positions of the last level index into.
+     */
+    template <class Levels, class Data>
+    class Assemble;
+
+    template <class... Levels, class Data>
+    class Assemble<std::tuple<Levels...>, Data>
+    {
+        static constexpr std::size_t N = sizeof...(Levels);
+        static_assert(N > 0, "At least one level is required");
+        static_assert(
+            ((has_append_coord_v<Levels> || has_insert_coord_v<Levels>
+              || has_coord_access_v<Levels>)&&...),
+            "Every level must support appending, inserting or computing its positions");
+
+        using Coordinates = std::tuple<util::coordinate_t<Levels>...>;
+        using Value = typename Data::value_type;
+
+        template <std::size_t K>
+        using level_t = std::tuple_element_t<K, std::tuple<Levels...>>;
+
+    private:
+        std::tuple<Levels&...> const m_levelsTuple;
+        Data& m_data;
+
+        bool m_empty;
+        Coordinates m_coords;
+        // the position of the current entry in every level
+        std::array<std::size_t, N> m_pk;
+        // the number of positions created so far in levels that are appended or inserted to
+        std::array<std::size_t, N> m_count;
+        // the number of parent positions that the level has been initialized for
+        std::array<std::size_t, N> m_parent_capacity;
+        // the parent position whose children are being appended, and its first child
+        std::array<std::size_t, N> m_open_parent;
+        std::array<std::size_t, N> m_edge_begin;
+        std::array<bool, N> m_has_open_parent;
+
+        template <std::size_t K>
+        static constexpr bool stores_duplicates() noexcept
+        /**
+         * @brief Whether every entry needs a new position in level `K`, even if its coordinates
+         * so far are equal to those of the previous entry.
+         */
+        {
+            if constexpr (K + 1 < N)
+            {
+                return !level_t<K>::LevelProperties::is_unique
+                       || level_t<K + 1>::LevelProperties::is_branchless;
+            }
+            else
+            {
+                return !level_t<K>::LevelProperties::is_unique;
+            }
+        }
+
+        template <std::size_t K, std::size_t... J>
+        inline auto parent_coords(Coordinates const& coords,
+                                  [[maybe_unused]] std::index_sequence<J...> j) const noexcept
+        {
+            // `I` holds the coordinates of the lower levels, nearest level first
+            return typename level_t<K>::BaseTraits::I{ std::get<K - 1 - J>(coords)... };
+        }
+
+        template <std::size_t K>
+        inline void grow_parents(std::size_t pkm1)
+        /**
+         * @brief Make sure level `K` is initialized for parent position `pkm1`.
+         *
+         * @details Grows geometrically, so that the initialization is amortized over the
+         * parents. `finalize` trims it to the exact number of parent positions.
+         */
+        {
+            if (pkm1 < m_parent_capacity[K])
+            {
+                return;
+            }
+
+            m_parent_capacity[K] = std::max(pkm1 + 1, 2 * m_parent_capacity[K]);
+            if constexpr (has_append_edges_v<level_t<K>>)
+            {
+                std::get<K>(m_levelsTuple).append_init(m_parent_capacity[K]);
+            }
+            else if constexpr (has_insert_coord_v<level_t<K>>)
+            {
+                std::get<K>(m_levelsTuple).insert_init(m_parent_capacity[K]);
+            }
+        }
+
+        template <std::size_t K>
+        inline void close_parent()
+        {
+            if constexpr (has_append_edges_v<level_t<K>>)
+            {
+                using BaseTraits = typename level_t<K>::BaseTraits;
+                if (m_has_open_parent[K])
+                {
+                    std::get<K>(m_levelsTuple)
+                        .append_edges(static_cast<typename BaseTraits::PKM1>(m_open_parent[K]),
+                                      static_cast<typename BaseTraits::PK>(m_edge_begin[K]),
+                                      static_cast<typename BaseTraits::PK>(m_count[K]));
+                    m_has_open_parent[K] = false;
+                }
+            }
+        }
+
+        template <std::size_t K>
+        inline void assemble_level(Coordinates const& coords, bool same_parent)
+        /**
+         * @brief Create (or find) the position of the current entry in level `K`.
+         *
+         * @param same_parent - whether the parent position is the one of the previous entry.
+         */
+        {
+            using Level = level_t<K>;
+            using BaseTraits = typename Level::BaseTraits;
+            auto& level = std::get<K>(m_levelsTuple);
+            std::size_t const pkm1 = K == 0 ? 0 : m_pk[K - 1];
+            auto const ik = std::get<K>(coords);
+
+            if constexpr (has_coord_access_v<Level>)
+            {
+                auto const i = parent_coords<K>(
+                    coords,
+                    std::make_index_sequence<std::tuple_size_v<typename BaseTraits::I>>{});
+                m_pk[K] = static_cast<std::size_t>(
+                    level
+                        .coord_access(static_cast<typename BaseTraits::PKM1>(pkm1), i, ik)
+                        .value());
+            }
+            else if constexpr (has_append_coord_v<Level>)
+            {
+                if (same_parent && ik < std::get<K>(m_coords))
+                {
+                    throw std::invalid_argument("coordinates must be sorted to be appended");
+                }
+
+                if constexpr (has_append_edges_v<Level>)
+                {
+                    if (!m_has_open_parent[K] || m_open_parent[K] != pkm1)
+                    {
+                        if (m_has_open_parent[K] && pkm1 < m_open_parent[K])
+                        {
+                            throw std::invalid_argument(
+                                "coordinates must be sorted to be appended");
+                        }
+                        close_parent<K>();
+                        grow_parents<K>(pkm1);
+                        m_open_parent[K] = pkm1;
+                        m_edge_begin[K] = m_count[K];
+                        m_has_open_parent[K] = true;
+                    }
+                }
+
+                level.append_coord(ik);
+                m_pk[K] = m_count[K]++;
+            }
+            else if constexpr (has_insert_coord_v<Level>)
+            {
+                grow_parents<K>(pkm1);
+                if (auto const pk
+                    = level.locate(static_cast<typename BaseTraits::PKM1>(pkm1), ik);
+                    pk.has_value() && !stores_duplicates<K>())
+                {
+                    m_pk[K] = static_cast<std::size_t>(pk.value());
+                }
+                else
+                {
+                    m_pk[K] = m_count[K]++;
+                    level.insert_coord(static_cast<typename BaseTraits::PKM1>(pkm1),
+                                       static_cast<typename BaseTraits::PK>(m_pk[K]),
+                                       ik);
+                }
+            }
+        }
+
+        template <std::size_t K>
+        inline void append_level(Coordinates const& coords, bool& diverged)
+        {
+            bool const same_parent = !diverged;
+            diverged = diverged || stores_duplicates<K>()
+                       || std::get<K>(coords) != std::get<K>(m_coords);
+            if (diverged)
+            {
+                assemble_level<K>(coords, same_parent);
+            }
+        }
+
+        template <std::size_t... K>
+        inline void append_levels(Coordinates const& coords,
+                                  [[maybe_unused]] std::index_sequence<K...> k)
+        {
+            bool diverged = m_empty;
+            (append_level<K>(coords, diverged), ...);
+        }
+
+        template <std::size_t K>
+        inline void finalize_level(std::size_t& szkm1)
+        {
+            using Level = level_t<K>;
+            auto& level = std::get<K>(m_levelsTuple);
+
+            // the number of parent positions is passed as a `std::size_t`, since it does not
+            // fit the coordinate type of a level in general
+            if constexpr (has_coord_access_v<Level>)
+            {
+                szkm1 = level.size(szkm1);
+            }
+            else
+            {
+                if constexpr (has_append_edges_v<Level>)
+                {
+                    close_parent<K>();
+                    level.append_init(szkm1);
+                    level.append_finalize(szkm1);
+                }
+                else if constexpr (has_insert_coord_v<Level>)
+                {
+                    level.insert_init(szkm1);
+                }
+                szkm1 = m_count[K];
+            }
+        }
+
+        template <std::size_t... K>
+        inline std::size_t finalize_levels([[maybe_unused]] std::index_sequence<K...> k)
+        {
+            std::size_t szkm1 = 1;
+            (finalize_level<K>(szkm1), ...);
+            return szkm1;
+        }
+
+        template <class Entry, std::size_t... K>
+        inline void append_entry(Entry const& entry, [[maybe_unused]] std::index_sequence<K...> k)
+        {
+            append(Coordinates{ std::get<K>(entry)... }, std::get<N>(entry));
+        }
+
+    public:
+        explicit inline Assemble(Levels&... levels, Data& data)
+            : m_levelsTuple(std::tie(levels...))
+            , m_data(data)
+            , m_empty(true)
+            , m_coords()
+            , m_pk()
+            , m_count()
+            , m_parent_capacity()
+            , m_open_parent()
+            , m_edge_begin()
+            , m_has_open_parent()
+        {
+        }
+
+        inline void append(Coordinates const& coords, Value const& value)
+        /**
+         * @brief Add a single entry to the tensor being assembled.
+         */
+        {
+            append_levels(coords, std::index_sequence_for<Levels...>{});
+            m_coords = coords;
+            m_empty = false;
+
+            std::size_t const pk = m_pk[N - 1];
+            if (pk >= m_data.size())
+            {
+                m_data.resize(pk + 1);
+            }
+            m_data[pk] = value;
+        }
+
+        template <class InputIt>
+        inline void append(InputIt first, InputIt last)
+        /**
+         * @brief Add every `(coordinates..., value)` tuple in `[first, last)`.
+         */
+        {
+            for (; first != last; ++first)
+            {
+                append_entry(*first, std::index_sequence_for<Levels...>{});
+            }
+        }
+
+        inline void finalize()
+        /**
+         * @brief Finish assembly: record the remaining edges, size every level to the exact
+         * number of parent positions, and size the data to the positions of the last level.
+         */
+        {
+            m_data.resize(finalize_levels(std::index_sequence_for<Levels...>{}));
+        }
+    };
+}
 
 #endif  // XSPARSE_ASSEMBLY_HPP
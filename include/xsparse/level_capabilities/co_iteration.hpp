@@ -1,8 +1,13 @@
 #ifndef XSPARSE_CO_ITERATION_HPP
 #define XSPARSE_CO_ITERATION_HPP
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <array>
 #include <vector>
 #include <tuple>
 #include <limits>
+#include <optional>
 #include <algorithm>
 #include <stdexcept>
 #include <xsparse/level_capabilities/locate.hpp>
@@ -27,6 +32,23 @@ struct all_ordered_or_have_locate<Level, RemainingLevels...>
                                       : false;
 };
 
+/**
+ * @brief Whether a level can return the support of a fiber 64 coordinates at a time, with
+ * `word_access(pkm1, w)` (e.g. dense and bitmap).
+ */
+template <class T, class = void>
+struct has_word_access : std::false_type
+{
+};
+
+template <class T>
+struct has_word_access<T, std::void_t<decltype(&T::word_access)>> : std::true_type
+{
+};
+
+template <class T>
+inline constexpr bool has_word_access_v = has_word_access<T>::value;
+
 // Helper function to check if a level is ordered
 template <typename Level>
 constexpr bool
@@ -54,6 +76,11 @@ namespace xsparse::level_capabilities
      * from different sequences at the same position and returns a tuple of the
      * minimum index and the corresponding elements from each sequence.
      *
+     * The merge goes on for as long as `F` holds for the levels that have coordinates left,
+     * where unordered levels, which are only located into, always count as having some. A
+     * conjunction thus ends with its shortest level and a disjunction with its longest one,
+     * whose remaining coordinates are visited with no PK for the exhausted levels.
+     *
      * @tparam F - A function object that is used to compare elements from different ranges.
      * Its input is a tuple of booleans corresponding to each of the levels. The output is a boolean
      * that is the result of the function.
@@ -96,6 +123,14 @@ namespace xsparse::level_capabilities
         // ordered. which is used in determining the template recursion
         static constexpr auto ordered_mask_tuple = std::make_tuple(is_level_ordered<Levels>()...);
 
+        // Whether `F` is a pure conjunction, in which case the ordered levels are intersected by
+        // skipping ahead rather than being merged one coordinate at a time.
+        static constexpr bool is_conjunctive = util::is_conjunction_v<F, sizeof...(Levels)>;
+
+        // Whether every level exposes its fibers as bitsets, in which case the merged support is
+        // computed a word at a time.
+        static constexpr bool is_word_parallel = (has_word_access_v<Levels> && ...);
+
         template <std::size_t I, bool... Args>
         static constexpr auto validate_boolean_helper()
         /**
@@ -173,6 +208,41 @@ namespace xsparse::level_capabilities
             std::tuple<Is...> const m_i;
             std::tuple<Ps...> const m_pkm1;
             std::tuple<typename Levels::iteration_helper...> m_iterHelpers;
+            std::size_t m_leader;
+
+        private:
+            template <std::size_t I>
+            inline void sparsest_level_helper(std::size_t& leader,
+                                              std::ptrdiff_t& leader_length) const noexcept
+            {
+                using level_type = std::tuple_element_t<I, std::tuple<Levels...>>;
+                if constexpr (level_type::LevelProperties::is_ordered)
+                {
+                    auto const& iter_helper = std::get<I>(m_iterHelpers);
+                    auto const length
+                        = static_cast<std::ptrdiff_t>(iter_helper.end() - iter_helper.begin());
+                    if (length < leader_length)
+                    {
+                        leader = I;
+                        leader_length = length;
+                    }
+                }
+            }
+
+            template <std::size_t... I>
+            inline std::size_t sparsest_level([[maybe_unused]] std::index_sequence<I...> i)
+                const noexcept
+            /**
+             * @brief The index of the ordered level with the fewest entries in this fiber.
+             *
+             * @details It leads conjunctive merges, proposing every candidate coordinate.
+             */
+            {
+                std::size_t leader = 0;
+                std::ptrdiff_t leader_length = std::numeric_limits<std::ptrdiff_t>::max();
+                (sparsest_level_helper<I>(leader, leader_length), ...);
+                return leader;
+            }
 
         public:
             explicit inline coiteration_helper(Coiterate const& coiterate,
@@ -183,20 +253,193 @@ namespace xsparse::level_capabilities
                 , m_pkm1(std::move(pkm1))
                 , m_iterHelpers(unfold_and_apply_helper(
                       coiterate.m_levelsTuple, m_i, pkm1, std::index_sequence_for<Ps...>{}))
+                , m_leader(0)
             {
                 // PKM1 should have the same number of elements as the number of levels in
                 // `m_levelsTuple`
                 static_assert(
                     std::tuple_size_v<std::remove_reference_t<decltype(coiterate.m_levelsTuple)>>
                     == std::tuple_size_v<std::remove_reference_t<decltype(pkm1)>>);
+
+                if constexpr (is_conjunctive && !is_word_parallel)
+                {
+                    m_leader = sparsest_level(std::index_sequence_for<Levels...>{});
+                }
+            }
+
+            template <std::size_t... Masks>
+            static constexpr std::uint64_t merge_words(
+                std::array<std::uint64_t, sizeof...(Levels)> const& words,
+                [[maybe_unused]] std::index_sequence<Masks...> masks) noexcept
+            /**
+             * @brief The bits for which `F` is true, given the bits of every level.
+             *
+             * @details Conjunctions and disjunctions are a plain AND and OR. Any other `F` is
+             * evaluated as the OR of the minterms of its truth table, one per combination of
+             * arguments for which `F` is true.
+             */
+            {
+                constexpr std::size_t N = sizeof...(Levels);
+                if constexpr (is_conjunctive)
+                {
+                    std::uint64_t merged = ~std::uint64_t{ 0 };
+                    for (auto const word : words)
+                    {
+                        merged &= word;
+                    }
+                    return merged;
+                }
+                else if constexpr (util::is_disjunction_v<F, N>)
+                {
+                    std::uint64_t merged = 0;
+                    for (auto const word : words)
+                    {
+                        merged |= word;
+                    }
+                    return merged;
+                }
+                else
+                {
+                    auto const minterm = [&](std::size_t mask) noexcept
+                    {
+                        std::uint64_t term = ~std::uint64_t{ 0 };
+                        for (std::size_t j = 0; j < N; ++j)
+                        {
+                            term &= ((mask >> j) & 1) != 0 ? words[j] : ~words[j];
+                        }
+                        return term;
+                    };
+                    std::uint64_t merged = 0;
+                    ((merged |= util::evaluate_bool_mask<F, Masks>(std::make_index_sequence<N>{})
+                                    ? minterm(Masks)
+                                    : 0),
+                     ...);
+                    return merged;
+                }
+            }
+
+            template <std::size_t... I>
+            inline std::uint64_t merged_word(std::size_t w,
+                                             [[maybe_unused]] std::index_sequence<I...> i)
+                const noexcept
+            {
+                auto const& levels = m_coiterate.m_levelsTuple;
+                return merge_words(
+                    { std::get<I>(levels).word_access(std::get<I>(m_pkm1), w)... },
+                    std::make_index_sequence<(std::size_t{ 1 } << sizeof...(Levels))>{});
+            }
+
+            inline std::size_t num_words() const noexcept
+            {
+                auto const size = std::get<0>(m_coiterate.m_levelsTuple).size();
+                return (static_cast<std::size_t>(size) + 63) / 64;
             }
 
+            class word_iterator
+            /**
+             * @brief Iterates over the merged support of levels with `word_access`.
+             *
+             * @details Instead of finding the minimum coordinate and advancing every level one
+             * coordinate at a time, the support of 64 coordinates is merged with `F` in a
+             * few bitwise operations, and its set bits are visited with a count of trailing
+             * zeros. The positions of a coordinate are found with `locate` or `coord_access`.
+             */
+            {
+            private:
+                coiteration_helper const& m_coiterHelper;
+                std::size_t const m_num_words;
+                // the current word, and its merged bits from the current coordinate on
+                std::size_t m_word;
+                std::uint64_t m_bits;
+
+                inline void skip_empty_words() noexcept
+                {
+                    while (m_bits == 0 && ++m_word < m_num_words)
+                    {
+                        m_bits = m_coiterHelper.merged_word(m_word,
+                                                            std::index_sequence_for<Levels...>{});
+                    }
+                }
+
+                template <std::size_t I>
+                inline auto get_PK_level(IK ik) const noexcept
+                {
+                    using level_type = std::tuple_element_t<I, std::tuple<Levels...>>;
+                    auto const& level = std::get<I>(m_coiterHelper.m_coiterate.m_levelsTuple);
+                    auto const pkm1 = std::get<I>(m_coiterHelper.m_pkm1);
+                    if constexpr (has_locate_v<level_type>)
+                    {
+                        return std::optional<typename level_type::BaseTraits::PK>(
+                            level.locate(pkm1, ik));
+                    }
+                    else
+                    {
+                        return std::optional<typename level_type::BaseTraits::PK>(
+                            level.coord_access(pkm1, m_coiterHelper.m_i, ik));
+                    }
+                }
+
+                template <std::size_t... I>
+                inline auto get_PKs(IK ik, [[maybe_unused]] std::index_sequence<I...> i)
+                    const noexcept
+                {
+                    return std::make_tuple(get_PK_level<I>(ik)...);
+                }
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using reference = typename std::
+                    tuple<IK, std::tuple<std::optional<typename Levels::BaseTraits::PK>...>>;
+
+                explicit inline word_iterator(coiteration_helper const& coiterHelper,
+                                              std::size_t word) noexcept
+                    : m_coiterHelper(coiterHelper)
+                    , m_num_words(coiterHelper.num_words())
+                    , m_word(word)
+                    , m_bits(word < m_num_words
+                                 ? coiterHelper.merged_word(word,
+                                                            std::index_sequence_for<Levels...>{})
+                                 : 0)
+                {
+                    if (m_word < m_num_words)
+                    {
+                        skip_empty_words();
+                    }
+                }
+
+                inline reference operator*() const noexcept
+                {
+                    auto const ik = static_cast<IK>(
+                        m_word * 64 + static_cast<std::size_t>(std::countr_zero(m_bits)));
+                    return { ik, get_PKs(ik, std::index_sequence_for<Levels...>{}) };
+                }
+
+                inline word_iterator& operator++() noexcept
+                {
+                    m_bits &= m_bits - 1;
+                    skip_empty_words();
+                    return *this;
+                }
+
+                inline bool operator!=(word_iterator const& other) const noexcept
+                {
+                    return m_word != other.m_word || m_bits != other.m_bits;
+                }
+
+                inline bool operator==(word_iterator const& other) const noexcept
+                {
+                    return !(*this != other);
+                }
+            };
+
             class iterator
             {
             private:
                 coiteration_helper const& m_coiterHelper;
                 std::tuple<typename Levels::iteration_helper::iterator...> iterators;
                 IK min_ik;
+                // PKs found by `locate` for the unordered levels of a conjunctive merge
+                std::tuple<std::optional<typename Levels::BaseTraits::PK>...> m_located;
 
             private:
                 template <typename... iter1, typename... iter2>
@@ -213,20 +456,21 @@ namespace xsparse::level_capabilities
                                               const std::tuple<iter2...>& it2,
                                               std::index_sequence<I...>) const noexcept
                 {
-                    return std::tuple{ compare_level(std::get<I>(it1), std::get<I>(it2))... };
+                    return std::tuple{ has_coordinates_left(std::get<I>(it1),
+                                                            std::get<I>(it2))... };
                 }
 
                 template <typename iter1, typename iter2>
-                inline constexpr auto compare_level(iter1& it1, iter2& it2) const noexcept
+                inline constexpr bool has_coordinates_left(iter1& it1, iter2& it2) const noexcept
                 {
                     if constexpr (iter1::parent_type::LevelProperties::is_ordered)
                     {
-                        // check if the current position is equal to the end
-                        return it1 == it2;
+                        // check if the current position has not reached the end
+                        return !(it1 == it2);
                     }
                     else
                     {
-                        // always return true for unordered levels
+                        // unordered levels are only located into, so they never run out
                         return true;
                     }
                 }
@@ -242,9 +486,12 @@ namespace xsparse::level_capabilities
                                       || has_locate_v<typename iter_type::parent_type>,
                                   "The level must be ordered or have a locate function.");
 
+                    // coordinates are less than the size of a level, so the largest `IK` is never
+                    // one and stands in for exhausted and unordered levels
                     if constexpr (iter_type::parent_type::LevelProperties::is_ordered)
                     {
-                        return it_current != it_end ? std::get<0>(*it_current) : min_ik;
+                        return it_current != it_end ? static_cast<IK>(std::get<0>(*it_current))
+                                                    : std::numeric_limits<IK>::max();
                     }
                     else
                     {
@@ -303,7 +550,14 @@ namespace xsparse::level_capabilities
 
                     if constexpr (iter::parent_type::LevelProperties::is_ordered)
                     {
-                        return deref_PKs(i);
+                        // an exhausted level of a disjunction has no PK
+                        return i != std::get<I>(m_coiterHelper.m_iterHelpers).end()
+                                   ? deref_PKs(i)
+                                   : std::nullopt;
+                    }
+                    else if constexpr (is_conjunctive)
+                    {
+                        return std::get<I>(m_located);
                     }
                     else if constexpr (has_locate_v<typename iter::parent_type>)
                     {
@@ -346,19 +600,127 @@ namespace xsparse::level_capabilities
                         std::make_index_sequence<std::tuple_size_v<decltype(iterators)>>{});
                 }
 
-                template <class iter>
-                inline void advance_iter(iter& i) const noexcept
+                template <std::size_t I>
+                inline void seek_level(IK& target, bool& aligned, bool& exhausted) noexcept
                 {
-                    // advance iterator if it is ordered
-                    if constexpr (iter::parent_type::LevelProperties::is_ordered)
+                    using iter_type = std::tuple_element_t<I, decltype(iterators)>;
+                    if constexpr (iter_type::parent_type::LevelProperties::is_ordered)
+                    {
+                        if (exhausted)
+                        {
+                            return;
+                        }
+
+                        auto& it = std::get<I>(iterators);
+                        it.seek(target);
+                        if (it == std::get<I>(m_coiterHelper.m_iterHelpers).end())
+                        {
+                            exhausted = true;
+                        }
+                        else if (auto const ik = static_cast<IK>(std::get<0>(*it)); ik != target)
+                        {
+                            target = ik;
+                            aligned = false;
+                        }
+                    }
+                }
+
+                template <std::size_t I>
+                inline void probe_level(IK& target, bool& aligned) noexcept
+                {
+                    using iter_type = std::tuple_element_t<I, decltype(iterators)>;
+                    if constexpr (!iter_type::parent_type::LevelProperties::is_ordered)
+                    {
+                        if (!aligned)
+                        {
+                            return;
+                        }
+
+                        auto& pk = std::get<I>(m_located);
+                        pk = std::get<I>(m_coiterHelper.m_coiterate.m_levelsTuple)
+                                 .locate(std::get<I>(m_coiterHelper.m_pkm1), target);
+                        if (!pk.has_value())
+                        {
+                            target = static_cast<IK>(target + 1);
+                            aligned = false;
+                        }
+                    }
+                }
+
+                template <std::size_t I>
+                inline void exhaust_level() noexcept
+                {
+                    using iter_type = std::tuple_element_t<I, decltype(iterators)>;
+                    if constexpr (iter_type::parent_type::LevelProperties::is_ordered)
+                    {
+                        auto& it = std::get<I>(iterators);
+                        it += std::get<I>(m_coiterHelper.m_iterHelpers).end() - it;
+                    }
+                }
+
+                template <std::size_t... I>
+                inline void intersect([[maybe_unused]] std::index_sequence<I...> i) noexcept
+                /**
+                 * @brief Move to the next coordinate present in every level.
+                 *
+                 * @details The sparsest ordered level leads: it proposes a candidate, and the
+                 * other ordered levels seek to it. Each seek gallops, so intersecting a small
+                 * fiber with a large one costs `O(small * log(large))`. If a follower overshoots,
+                 * the leader seeks to the follower's coordinate instead. Once the ordered levels
+                 * agree, unordered levels are probed with `locate`, and a miss moves on to the
+                 * next candidate. Once any ordered level is exhausted so is the conjunction,
+                 * and all ordered iterators are moved to their end.
+                 */
+                {
+                    std::size_t const leader = m_coiterHelper.m_leader;
+                    IK target = std::numeric_limits<IK>::min();
+                    bool aligned = false;
+                    bool exhausted = false;
+                    while (!aligned && !exhausted)
+                    {
+                        ((I == leader ? seek_level<I>(target, aligned, exhausted) : void()), ...);
+                        aligned = true;
+                        ((I != leader ? seek_level<I>(target, aligned, exhausted) : void()), ...);
+                        if (!exhausted)
+                        {
+                            (probe_level<I>(target, aligned), ...);
+                        }
+                    }
+
+                    if (exhausted)
+                    {
+                        (exhaust_level<I>(), ...);
+                    }
+                    min_ik = target;
+                }
+
+                inline void intersect_helper() noexcept
+                {
+                    intersect(std::make_index_sequence<std::tuple_size_v<decltype(iterators)>>{});
+                }
+
+                template <std::size_t I>
+                inline void advance_iter() noexcept
+                {
+                    // advance iterator if it is ordered and not exhausted
+                    using iter_type = std::tuple_element_t<I, decltype(iterators)>;
+                    if constexpr (iter_type::parent_type::LevelProperties::is_ordered)
                     {
-                        if (static_cast<IK>(std::get<0>(*i)) == min_ik)
+                        auto& i = std::get<I>(iterators);
+                        if (i != std::get<I>(m_coiterHelper.m_iterHelpers).end()
+                            && static_cast<IK>(std::get<0>(*i)) == min_ik)
                         {
                             ++i;
                         }
                     }
                 }
 
+                template <std::size_t... I>
+                inline void advance_iters([[maybe_unused]] std::index_sequence<I...> i) noexcept
+                {
+                    (advance_iter<I>(), ...);
+                }
+
             public:
                 using iterator_category = std::forward_iterator_tag;
                 using reference = typename std::
@@ -370,7 +732,14 @@ namespace xsparse::level_capabilities
                     : m_coiterHelper(coiterHelper)
                     , iterators(it)
                 {
-                    min_helper();
+                    if constexpr (is_conjunctive)
+                    {
+                        intersect_helper();
+                    }
+                    else
+                    {
+                        min_helper();
+                    }
                 }
 
                 inline reference operator*() const noexcept
@@ -388,16 +757,26 @@ namespace xsparse::level_capabilities
 
                 inline iterator& operator++() noexcept
                 {
-                    std::apply([&](auto&... args) { ((advance_iter(args)), ...); }, iterators);
-                    min_helper();
+                    advance_iters(
+                        std::make_index_sequence<std::tuple_size_v<decltype(iterators)>>{});
+                    if constexpr (is_conjunctive)
+                    {
+                        intersect_helper();
+                    }
+                    else
+                    {
+                        min_helper();
+                    }
                     return *this;
                 }
 
                 inline bool operator!=(iterator const& other) const noexcept
                 {
-                    // a tuple of booleans E.g. (true, false, true, false)
+                    // a tuple of booleans E.g. (true, false, true, false), true for the levels
+                    // that have coordinates left. The merge goes on as long as `F` of them
+                    // holds, e.g. until all levels of a disjunction are exhausted.
                     const auto result_bools = compareHelper(iterators, other.iterators);
-                    return !m_coiterHelper.m_coiterate.m_comparisonHelper(result_bools);
+                    return m_coiterHelper.m_coiterate.m_comparisonHelper(result_bools);
                 };
 
                 inline bool operator==(iterator const& other) const noexcept
@@ -406,20 +785,34 @@ namespace xsparse::level_capabilities
                 };
             };
 
-            inline iterator begin() const noexcept
+            inline auto begin() const noexcept
             {
-                return iterator{ *this,
-                                 std::apply([&](auto&... args)
-                                            { return std::tuple(args.begin()...); },
-                                            this->m_iterHelpers) };
+                if constexpr (is_word_parallel)
+                {
+                    return word_iterator{ *this, 0 };
+                }
+                else
+                {
+                    return iterator{ *this,
+                                     std::apply([&](auto&... args)
+                                                { return std::tuple(args.begin()...); },
+                                                this->m_iterHelpers) };
+                }
             }
 
-            inline iterator end() const noexcept
+            inline auto end() const noexcept
             {
-                return iterator{ *this,
-                                 std::apply([&](auto&... args)
-                                            { return std::tuple(args.end()...); },
-                                            this->m_iterHelpers) };
+                if constexpr (is_word_parallel)
+                {
+                    return word_iterator{ *this, num_words() };
+                }
+                else
+                {
+                    return iterator{ *this,
+                                     std::apply([&](auto&... args)
+                                                { return std::tuple(args.end()...); },
+                                                this->m_iterHelpers) };
+                }
             }
         };
 
@@ -1,6 +1,8 @@
 #ifndef XSPARSE_COORDINATE_ITERATE_HPP
 #define XSPARSE_COORDINATE_ITERATE_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <tuple>
 #include <optional>
@@ -48,7 +50,8 @@ namespace xsparse::level_capabilities
         public:
             class iterator;
             using value_type = typename BaseTraits::PK;
-            using difference_type = typename std::make_signed_t<typename BaseTraits::IK>;
+            // not the signed `IK`, which is too narrow for the length of a narrow fiber
+            using difference_type = std::ptrdiff_t;
             using key_type = typename BaseTraits::IK;
             using pointer = typename BaseTraits::PK*;
             using reference = std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
@@ -102,6 +105,20 @@ namespace xsparse::level_capabilities
                     return *this;
                 }
 
+                inline iterator& seek(typename BaseTraits::IK ik) noexcept
+                /**
+                 * @brief Advance to the first coordinate that is not less than `ik`.
+                 *
+                 * @details Coordinates are contiguous, so this is a clamped jump.
+                 */
+                {
+                    if (m_ik < ik)
+                    {
+                        m_ik = std::min(ik, m_iterHelper.m_ik_end);
+                    }
+                    return *this;
+                }
+
                 inline difference_type operator-(iterator const& other)
                 {
                     return static_cast<difference_type>(m_ik)
@@ -149,6 +166,24 @@ namespace xsparse::level_capabilities
         }
     };
 
+    /**
+     * @brief The distance between the positions of consecutive coordinates of a fiber, which
+     * a level can set with a `POS_STRIDE` constant if its fibers are interleaved.
+     */
+    template <class Level, class = void>
+    struct pos_stride : std::integral_constant<std::size_t, 1>
+    {
+    };
+
+    template <class Level>
+    struct pos_stride<Level, std::void_t<decltype(Level::POS_STRIDE)>>
+        : std::integral_constant<std::size_t, Level::POS_STRIDE>
+    {
+    };
+
+    template <class Level>
+    inline constexpr std::size_t pos_stride_v = pos_stride<Level>::value;
+
     template <template <class...> class T, class IK, class PK, class... LowerLevels>
     class coordinate_position_iterate
     {
@@ -174,10 +209,13 @@ namespace xsparse::level_capabilities
             typename BaseTraits::I const m_i;
             typename BaseTraits::PK m_pk_begin, m_pk_end;
 
+            static constexpr typename BaseTraits::PK STRIDE
+                = static_cast<typename BaseTraits::PK>(pos_stride_v<typename BaseTraits::Level>);
+
         public:
             class iterator;
             using value_type = typename BaseTraits::PK;
-            using difference_type = typename std::make_signed_t<typename BaseTraits::PK>;
+            using difference_type = std::ptrdiff_t;
             using key_type = typename BaseTraits::IK;
             using pointer = typename BaseTraits::PK*;
             using reference = std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
@@ -208,32 +246,84 @@ namespace xsparse::level_capabilities
 
                 inline iterator& operator++() noexcept
                 {
-                    ++m_pk;
+                    m_pk += STRIDE;
                     return *this;
                 }
 
                 inline iterator& operator--() noexcept
                 {
-                    --m_pk;
+                    m_pk -= STRIDE;
                     return *this;
                 }
 
                 inline iterator& operator+=(difference_type n) noexcept
                 {
-                    m_pk += n;
+                    m_pk += n * static_cast<difference_type>(STRIDE);
                     return *this;
                 }
 
                 inline iterator& operator-=(difference_type n) noexcept
                 {
-                    m_pk -= n;
+                    m_pk -= n * static_cast<difference_type>(STRIDE);
+                    return *this;
+                }
+
+                inline iterator& seek(typename BaseTraits::IK ik) noexcept
+                /**
+                 * @brief Advance to the first position whose coordinate is not less than `ik`.
+                 *
+                 * @details Gallops forward in exponentially growing steps and then binary
+                 * searches the last step, so skipping `n` positions costs `O(log n)` calls to
+                 * `pos_access`. Only meaningful for ordered levels. The search counts
+                 * coordinates from the current one, which are `STRIDE` positions apart.
+                 */
+                {
+                    using pk_type = typename BaseTraits::PK;
+                    pk_type const n_end
+                        = static_cast<pk_type>((m_iterHelper.m_pk_end - m_pk) / STRIDE);
+                    auto const pk_at = [&](pk_type n) noexcept
+                    { return static_cast<pk_type>(m_pk + n * STRIDE); };
+                    auto const crd_less = [&](pk_type n) noexcept
+                    { return m_iterHelper.m_level.pos_access(pk_at(n), m_iterHelper.m_i) < ik; };
+
+                    if (n_end == 0 || !crd_less(0))
+                    {
+                        return *this;
+                    }
+
+                    // Invariant: the coordinate at `lo` is less than `ik`. The step is capped
+                    // at the remaining length, so narrow position types cannot overflow.
+                    pk_type lo = 0;
+                    pk_type step = 1;
+                    while (step < n_end - lo && crd_less(static_cast<pk_type>(lo + step)))
+                    {
+                        lo = static_cast<pk_type>(lo + step);
+                        step = step <= (n_end - lo) / 2 ? static_cast<pk_type>(step * 2)
+                                                        : static_cast<pk_type>(n_end - lo);
+                    }
+
+                    pk_type hi = step < n_end - lo ? static_cast<pk_type>(lo + step) : n_end;
+                    while (hi - lo > 1)
+                    {
+                        auto const mid = static_cast<pk_type>(lo + (hi - lo) / 2);
+                        if (crd_less(mid))
+                        {
+                            lo = mid;
+                        }
+                        else
+                        {
+                            hi = mid;
+                        }
+                    }
+                    m_pk = pk_at(hi);
                     return *this;
                 }
 
                 inline difference_type operator-(iterator const& other)
                 {
-                    return static_cast<difference_type>(m_pk)
-                           - static_cast<difference_type>(other.m_pk);
+                    return (static_cast<difference_type>(m_pk)
+                            - static_cast<difference_type>(other.m_pk))
+                           / static_cast<difference_type>(STRIDE);
                 }
 
                 inline bool operator==(iterator const& other) const noexcept
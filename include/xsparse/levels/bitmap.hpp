@@ -0,0 +1,434 @@
+#ifndef XSPARSE_LEVELS_BITMAP_HPP
+#define XSPARSE_LEVELS_BITMAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <optional>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+
+#include <xsparse/util/base_traits.hpp>
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/level_properties.hpp>
+#include <xtl/xiterator_base.hpp>
+
+namespace xsparse
+{
+    namespace levels
+    {
+        /**
+         * @brief A level that stores a bitset over the coordinates of every fiber, for fibers
+         * too dense for `compressed` and too sparse for `dense`.
+         *
+         * @details Fiber `pkm1` occupies the `WORD_BITS`-bit words `[pkm1 * W, (pkm1 + 1) * W)`
+         * of the bitset, where `W` is the number of words needed for `size()` coordinates, and
+         * coordinate `ik` is bit `ik % WORD_BITS` of word `pkm1 * W + ik / WORD_BITS`. Next to
+         * every word, the level keeps the number of set bits in all words before it. The
+         * position of a coordinate is its rank, i.e. the number of set bits before it, so
+         * positions are the same as for the equivalent `compressed` level and the data of a
+         * tensor is laid out alike.
+         *
+         * `locate` is a rank query: one bit test and one `popcount`. Iteration scans a word at
+         * a time and finds the next coordinate with a count of trailing zeros, which compile to
+         * `popcnt`/`tzcnt` where the target supports them. Coordinates are ordered, so the level
+         * can be coiterated like `compressed` and `seek` skips whole words. If all levels of
+         * a `Coiterate` expose their fibers with `word_access`, as this level and `dense` do,
+         * their fibers are merged a word at a time.
+         */
+        template <class LowerLevels,
+                  class IK,
+                  class PK,
+                  class ContainerTraits
+                  = util::container_traits<std::vector, std::unordered_set, std::unordered_map>,
+                  class _LevelProperties = level_properties<false, true, true, false, true>>
+        class bitmap;
+
+        template <class... LowerLevels,
+                  class IK,
+                  class PK,
+                  class ContainerTraits,
+                  class _LevelProperties>
+        class bitmap<std::tuple<LowerLevels...>, IK, PK, ContainerTraits, _LevelProperties>
+        {
+            static_assert(_LevelProperties::is_ordered);
+            static_assert(_LevelProperties::is_unique);
+            static_assert(!_LevelProperties::is_branchless);
+            static_assert(_LevelProperties::is_compact);
+
+        public:
+            using BaseTraits = util::base_traits<bitmap,
+                                                 std::tuple<LowerLevels...>,
+                                                 IK,
+                                                 PK,
+                                                 ContainerTraits,
+                                                 _LevelProperties>;
+            using LevelProperties = _LevelProperties;
+
+            using Word = std::uint64_t;
+            static constexpr std::size_t WORD_BITS = 64;
+
+        private:
+            using PosContainer = typename ContainerTraits::template Vec<PK>;
+            using CrdContainer = typename ContainerTraits::template Vec<IK>;
+            using WordContainer = typename ContainerTraits::template Vec<Word>;
+
+        public:
+            class iteration_helper
+            {
+                static_assert(std::is_nothrow_invocable_r_v<std::optional<typename BaseTraits::PK>,
+                                                            decltype(&BaseTraits::Level::locate),
+                                                            typename BaseTraits::Level&,
+                                                            typename BaseTraits::PKM1,
+                                                            typename BaseTraits::IK>);
+
+            private:
+                typename BaseTraits::Level const& m_level;
+                std::size_t const m_word_begin, m_word_end;
+
+            public:
+                class iterator;
+                using value_type = typename BaseTraits::PK;
+                using difference_type = std::ptrdiff_t;
+                using pointer = typename BaseTraits::PK*;
+                using reference = std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
+                using iterator_type = iterator;
+
+                class iterator : public xtl::xbidirectional_iterator_base2<iteration_helper>
+                {
+                private:
+                    iteration_helper const& m_iterHelper;
+                    // the current word, its bits from the current coordinate on, and the
+                    // position of the current coordinate
+                    std::size_t m_word;
+                    Word m_bits;
+                    typename BaseTraits::PK m_pk;
+
+                    inline void skip_empty_words() noexcept
+                    {
+                        while (m_bits == 0 && ++m_word < m_iterHelper.m_word_end)
+                        {
+                            m_bits = m_iterHelper.m_level.m_words[m_word];
+                        }
+                    }
+
+                    inline typename BaseTraits::PK rank() const noexcept
+                    {
+                        auto const& level = m_iterHelper.m_level;
+                        if (m_bits == 0)
+                        {
+                            return level.m_rank[m_word];
+                        }
+                        Word const below = (m_bits & (~m_bits + 1)) - 1;
+                        return static_cast<typename BaseTraits::PK>(
+                            level.m_rank[m_word] + std::popcount(level.m_words[m_word] & below));
+                    }
+
+                public:
+                    using parent_type = typename BaseTraits::Level;
+
+                    explicit inline iterator(iteration_helper const& iterationHelper,
+                                             std::size_t word) noexcept
+                        : m_iterHelper(iterationHelper)
+                        , m_word(word)
+                        , m_bits(word < iterationHelper.m_word_end
+                                     ? iterationHelper.m_level.m_words[word]
+                                     : 0)
+                    {
+                        if (m_word < m_iterHelper.m_word_end)
+                        {
+                            skip_empty_words();
+                        }
+                        m_pk = rank();
+                    }
+
+                    inline std::tuple<typename BaseTraits::IK, typename BaseTraits::PK> operator*()
+                        const noexcept
+                    {
+                        auto const ik = (m_word - m_iterHelper.m_word_begin) * WORD_BITS
+                                        + static_cast<std::size_t>(std::countr_zero(m_bits));
+                        return { static_cast<typename BaseTraits::IK>(ik), m_pk };
+                    }
+
+                    inline iterator& operator++() noexcept
+                    {
+                        m_bits &= m_bits - 1;
+                        skip_empty_words();
+                        ++m_pk;
+                        return *this;
+                    }
+
+                    inline iterator& operator--() noexcept
+                    {
+                        auto const& words = m_iterHelper.m_level.m_words;
+                        // the bits below the current coordinate, within its word
+                        Word below
+                            = m_bits == 0 ? 0 : words[m_word] & ((m_bits & (~m_bits + 1)) - 1);
+                        while (below == 0)
+                        {
+                            below = words[--m_word];
+                        }
+                        auto const bit = WORD_BITS - 1
+                                         - static_cast<std::size_t>(std::countl_zero(below));
+                        m_bits = words[m_word] & (~Word{ 0 } << bit);
+                        --m_pk;
+                        return *this;
+                    }
+
+                    inline iterator& operator+=(difference_type n) noexcept
+                    /**
+                     * @brief Advance by `n` coordinates, skipping whole words by their
+                     * `popcount`.
+                     */
+                    {
+                        auto remaining = static_cast<std::size_t>(n);
+                        while (remaining > 0 && m_word < m_iterHelper.m_word_end)
+                        {
+                            auto const count = static_cast<std::size_t>(std::popcount(m_bits));
+                            if (remaining < count)
+                            {
+                                for (; remaining > 0; --remaining)
+                                {
+                                    m_bits &= m_bits - 1;
+                                }
+                                break;
+                            }
+                            remaining -= count;
+                            m_bits = 0;
+                            skip_empty_words();
+                        }
+                        m_pk = rank();
+                        return *this;
+                    }
+
+                    inline iterator& seek(typename BaseTraits::IK ik) noexcept
+                    /**
+                     * @brief Advance to the first coordinate that is not less than `ik`.
+                     *
+                     * @details Jumps straight to the word of `ik` and masks off the bits below
+                     * it, so the cost is the number of empty words scanned after it.
+                     */
+                    {
+                        std::size_t const word
+                            = m_iterHelper.m_word_begin + static_cast<std::size_t>(ik) / WORD_BITS;
+                        if (m_word >= m_iterHelper.m_word_end || word < m_word)
+                        {
+                            return *this;
+                        }
+                        if (word >= m_iterHelper.m_word_end)
+                        {
+                            m_word = m_iterHelper.m_word_end;
+                            m_bits = 0;
+                            m_pk = rank();
+                            return *this;
+                        }
+                        if (word > m_word)
+                        {
+                            m_word = word;
+                            m_bits = m_iterHelper.m_level.m_words[word];
+                        }
+                        m_bits &= ~Word{ 0 } << (static_cast<std::size_t>(ik) % WORD_BITS);
+                        skip_empty_words();
+                        m_pk = rank();
+                        return *this;
+                    }
+
+                    inline difference_type operator-(iterator const& other) const noexcept
+                    {
+                        return static_cast<difference_type>(m_pk)
+                               - static_cast<difference_type>(other.m_pk);
+                    }
+
+                    inline bool operator==(iterator const& other) const noexcept
+                    {
+                        return m_word == other.m_word && m_bits == other.m_bits;
+                    }
+
+                    inline bool operator<(iterator const& other) const noexcept
+                    {
+                        return m_pk < other.m_pk;
+                    }
+                };
+
+                explicit inline iteration_helper(typename BaseTraits::Level const& level,
+                                                 std::size_t word_begin,
+                                                 std::size_t word_end) noexcept
+                    : m_level(level)
+                    , m_word_begin(word_begin)
+                    , m_word_end(word_end)
+                {
+                }
+
+                inline iterator_type begin() const noexcept
+                {
+                    return iterator_type{ *this, m_word_begin };
+                }
+
+                inline iterator_type end() const noexcept
+                {
+                    return iterator_type{ *this, m_word_end };
+                }
+            };
+
+            iteration_helper iter_helper([[maybe_unused]] typename BaseTraits::I i,
+                                         typename BaseTraits::PKM1 pkm1) const noexcept
+            {
+                // i is not used, but it is here to make the interface consistent with other levels
+                auto const [word_begin, word_end] = word_bounds(pkm1);
+                return iteration_helper{ *this, word_begin, word_end };
+            }
+
+            bitmap(IK size)
+                : m_size(std::move(size))
+                , m_words_per_fiber(words_for(m_size))
+                , m_words()
+                , m_rank(1, 0)
+            {
+            }
+
+            bitmap(IK size, PosContainer const& pos, CrdContainer const& crd)
+                : m_size(std::move(size))
+                , m_words_per_fiber(words_for(m_size))
+            /**
+             * @brief Build the level from the `pos` and `crd` arrays of a `compressed` level,
+             * whose positions it keeps.
+             */
+            {
+                auto const num_fibers = static_cast<std::size_t>(pos.size()) - 1;
+                m_words.resize(num_fibers * m_words_per_fiber);
+                for (std::size_t pkm1 = 0; pkm1 < num_fibers; ++pkm1)
+                {
+                    for (auto pk = pos[pkm1]; pk < pos[pkm1 + 1]; ++pk)
+                    {
+                        set_bit(pkm1, crd[pk]);
+                    }
+                }
+                build_rank();
+            }
+
+            inline auto locate(typename BaseTraits::PKM1 pkm1, IK ik) const noexcept
+            {
+                auto const w = static_cast<std::size_t>(pkm1) * m_words_per_fiber
+                               + static_cast<std::size_t>(ik) / WORD_BITS;
+                Word const bit = Word{ 1 } << (static_cast<std::size_t>(ik) % WORD_BITS);
+                return (m_words[w] & bit) != 0
+                           ? std::optional<PK>(static_cast<PK>(
+                               m_rank[w] + std::popcount(m_words[w] & (bit - 1))))
+                           : std::nullopt;
+            }
+
+            inline Word word_access(typename BaseTraits::PKM1 pkm1, std::size_t w) const noexcept
+            /**
+             * @brief The coordinates `[WORD_BITS * w, WORD_BITS * (w + 1))` of fiber `pkm1` as
+             * a bitset.
+             */
+            {
+                return m_words[static_cast<std::size_t>(pkm1) * m_words_per_fiber + w];
+            }
+
+            inline void append_init(std::size_t szkm1) noexcept
+            {
+                m_words.resize(szkm1 * m_words_per_fiber);
+            }
+
+            inline void append_edges(typename BaseTraits::PKM1 const pkm1,
+                                     typename BaseTraits::PK pk_begin,
+                                     typename BaseTraits::PK pk_end) noexcept
+            {
+                for (auto pk = pk_begin; pk < pk_end; ++pk)
+                {
+                    set_bit(pkm1, m_appended[pk]);
+                }
+            }
+
+            inline void append_coord(typename BaseTraits::IK ik) noexcept
+            {
+                // a coordinate's fiber is only known once `append_edges` closes it
+                m_appended.push_back(ik);
+            }
+
+            inline void append_finalize([[maybe_unused]] std::size_t szkm1) noexcept
+            {
+                m_appended = CrdContainer();
+                build_rank();
+            }
+
+            inline IK size() const noexcept
+            {
+                return m_size;
+            }
+
+            inline std::pair<std::size_t, std::size_t> word_bounds(
+                typename BaseTraits::PKM1 pkm1) const noexcept
+            /**
+             * @brief The range of words that hold the bits of fiber `pkm1`.
+             */
+            {
+                auto const begin = static_cast<std::size_t>(pkm1) * m_words_per_fiber;
+                return { begin, begin + m_words_per_fiber };
+            }
+
+            inline WordContainer const& get_words() const noexcept
+            {
+                return m_words;
+            }
+
+            inline PosContainer const& get_rank() const noexcept
+            /**
+             * @brief The number of set bits before every word, with the total at the end.
+             */
+            {
+                return m_rank;
+            }
+
+        private:
+            static inline std::size_t words_for(IK size) noexcept
+            {
+                return (static_cast<std::size_t>(size) + WORD_BITS - 1) / WORD_BITS;
+            }
+
+            inline void set_bit(std::size_t pkm1, IK ik) noexcept
+            {
+                m_words[pkm1 * m_words_per_fiber + static_cast<std::size_t>(ik) / WORD_BITS]
+                    |= Word{ 1 } << (static_cast<std::size_t>(ik) % WORD_BITS);
+            }
+
+            inline void build_rank()
+            {
+                m_rank.resize(m_words.size() + 1);
+                PK count = 0;
+                for (std::size_t w = 0; w < m_words.size(); ++w)
+                {
+                    m_rank[w] = count;
+                    count = static_cast<PK>(count + std::popcount(m_words[w]));
+                }
+                m_rank[m_words.size()] = count;
+            }
+
+            IK m_size;
+            std::size_t m_words_per_fiber;
+            WordContainer m_words;
+            PosContainer m_rank;
+            // the coordinates appended to fibers that are not closed yet
+            CrdContainer m_appended;
+        };
+    }  // namespace levels
+
+    template <class... LowerLevels,
+              class IK,
+              class PK,
+              class ContainerTraits,
+              class _LevelProperties>
+    struct util::coordinate_position_trait<
+        levels::bitmap<std::tuple<LowerLevels...>, IK, PK, ContainerTraits, _LevelProperties>>
+    {
+        using Coordinate = IK;
+        using Position = PK;
+    };
+}  // namespace xsparse
+
+
+#endif
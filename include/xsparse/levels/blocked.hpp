@@ -0,0 +1,195 @@
+#ifndef XSPARSE_LEVELS_BLOCKED_HPP
+#define XSPARSE_LEVELS_BLOCKED_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <xsparse/level_capabilities/coordinate_iterate.hpp>
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/level_properties.hpp>
+
+namespace xsparse
+{
+    namespace levels
+    {
+        /**
+         * @brief A compressed level whose stored coordinates are dense tiles of `BlockSize`
+         * consecutive coordinates.
+         *
+         * @details Like `compressed`, the tiles below parent position `pkm1` are
+         * `[pos[pkm1], pos[pkm1 + 1])`, but tile `b` covers the coordinates
+         * `crd[b] * BlockSize + r` at the positions `b * BlockSize + r`, for every `r` in
+         * `[0, BlockSize)`. Every tile thus needs one coordinate instead of `BlockSize`, and the
+         * tiles of the level below are contiguous.
+         *
+         * Placing a `dense` level of size `BlockSize` below this one, over the rows of a block
+         * row, gives BCSR: `(dense, blocked, dense)` stores the `BlockSize` x `BlockSize`
+         * blocks of a matrix column by column, at positions `b * BlockSize * BlockSize`.
+         *
+         * Generic code sees every coordinate of a tile through `pos_bounds` and `pos_access`.
+         * Kernels can instead iterate over whole tiles with `block_bounds` and `block_access`,
+         * and use the compile-time `BLOCK_SIZE` for register tiling.
+         *
+         * @tparam BlockSize - a `std::integral_constant` with the number of coordinates per
+         * tile.
+         */
+        template <class LowerLevels,
+                  class IK,
+                  class PK,
+                  class BlockSize,
+                  class ContainerTraits
+                  = util::container_traits<std::vector, std::unordered_set, std::unordered_map>,
+                  class _LevelProperties = level_properties<false, true, true, false, true>>
+        class blocked;
+
+        template <class... LowerLevels,
+                  class IK,
+                  class PK,
+                  class BlockSize,
+                  class ContainerTraits,
+                  class _LevelProperties>
+        class blocked<std::tuple<LowerLevels...>,
+                      IK,
+                      PK,
+                      BlockSize,
+                      ContainerTraits,
+                      _LevelProperties>
+            : public level_capabilities::coordinate_position_iterate<blocked,
+                                                                     std::tuple<LowerLevels...>,
+                                                                     IK,
+                                                                     PK,
+                                                                     BlockSize,
+                                                                     ContainerTraits,
+                                                                     _LevelProperties>
+
+        {
+            static_assert(!_LevelProperties::is_branchless);
+            static_assert(_LevelProperties::is_compact);
+            static_assert(BlockSize::value > 0, "Tiles must hold at least one coordinate");
+            using PosContainer = typename ContainerTraits::template Vec<PK>;
+            using CrdContainer = typename ContainerTraits::template Vec<IK>;
+
+        public:
+            using BaseTraits = util::base_traits<blocked,
+                                                 std::tuple<LowerLevels...>,
+                                                 IK,
+                                                 PK,
+                                                 BlockSize,
+                                                 ContainerTraits,
+                                                 _LevelProperties>;
+            using LevelCapabilities
+                = level_capabilities::coordinate_position_iterate<blocked,
+                                                                  std::tuple<LowerLevels...>,
+                                                                  IK,
+                                                                  PK,
+                                                                  BlockSize,
+                                                                  ContainerTraits,
+                                                                  _LevelProperties>;
+            using LevelProperties = _LevelProperties;
+
+            static constexpr std::size_t BLOCK_SIZE = BlockSize::value;
+
+        public:
+            blocked(IK size)
+                : m_size(std::move(size))
+                , m_pos()
+                , m_crd()
+            {
+            }
+
+            blocked(IK size, PosContainer const& pos, CrdContainer const& crd)
+                : m_size(std::move(size))
+                , m_pos(pos)
+                , m_crd(crd)
+            /**
+             * @brief A level with the tiles `crd` below every parent position, delimited by
+             * `pos`. The entries of `crd` are tile coordinates, i.e. coordinates divided by
+             * `BLOCK_SIZE`.
+             */
+            {
+            }
+
+            blocked(IK size, PosContainer&& pos, CrdContainer&& crd)
+                : m_size(std::move(size))
+                , m_pos(std::move(pos))
+                , m_crd(std::move(crd))
+            {
+            }
+
+            inline std::pair<PK, PK> pos_bounds(typename BaseTraits::PKM1 const pkm1) const noexcept
+            {
+                auto const [b_begin, b_end] = block_bounds(pkm1);
+                return { static_cast<PK>(b_begin * BLOCK_SIZE),
+                         static_cast<PK>(b_end * BLOCK_SIZE) };
+            }
+
+            inline IK pos_access(PK pk, [[maybe_unused]] typename BaseTraits::I i) const noexcept
+            {
+                return static_cast<IK>(m_crd[pk / BLOCK_SIZE] * BLOCK_SIZE + pk % BLOCK_SIZE);
+            }
+
+            inline std::pair<PK, PK> block_bounds(typename BaseTraits::PKM1 const pkm1) const
+                noexcept
+            /**
+             * @brief The tiles below parent position `pkm1`.
+             */
+            {
+                return { m_pos[pkm1], m_pos[static_cast<std::size_t>(pkm1) + 1] };
+            }
+
+            inline IK block_access(PK b) const noexcept
+            /**
+             * @brief The first coordinate of tile `b`, whose positions start at
+             * `b * BLOCK_SIZE`.
+             */
+            {
+                return static_cast<IK>(m_crd[b] * BLOCK_SIZE);
+            }
+
+            inline IK size() const noexcept
+            {
+                return m_size;
+            }
+
+            inline PosContainer const& get_pos() const noexcept
+            {
+                return m_pos;
+            }
+
+            inline CrdContainer const& get_crd() const noexcept
+            {
+                return m_crd;
+            }
+
+        private:
+            IK m_size;
+            PosContainer m_pos;
+            CrdContainer m_crd;
+        };
+    }  // namespace levels
+
+    template <class... LowerLevels,
+              class IK,
+              class PK,
+              class BlockSize,
+              class ContainerTraits,
+              class _LevelProperties>
+    struct util::coordinate_position_trait<levels::blocked<std::tuple<LowerLevels...>,
+                                                           IK,
+                                                           PK,
+                                                           BlockSize,
+                                                           ContainerTraits,
+                                                           _LevelProperties>>
+    {
+        using Coordinate = IK;
+        using Position = PK;
+    };
+}  // namespace xsparse
+
+
+#endif
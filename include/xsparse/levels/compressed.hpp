@@ -1,6 +1,7 @@
 #ifndef XSPARSE_LEVELS_COMPRESSED_HPP
 #define XSPARSE_LEVELS_COMPRESSED_HPP
 
+#include <cstddef>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -75,14 +76,14 @@ namespace xsparse
 
             compressed(IK size, PosContainer&& pos, CrdContainer&& crd)
                 : m_size(std::move(size))
-                , m_pos(pos)
-                , m_crd(crd)
+                , m_pos(std::move(pos))
+                , m_crd(std::move(crd))
             {
             }
 
             inline std::pair<PK, PK> pos_bounds(typename BaseTraits::PKM1 const pkm1) const noexcept
             {
-                return { m_pos[pkm1], m_pos[static_cast<typename BaseTraits::PKM1>(pkm1 + 1)] };
+                return { m_pos[pkm1], m_pos[static_cast<std::size_t>(pkm1) + 1] };
             }
 
             inline IK pos_access(PK pk, [[maybe_unused]] typename BaseTraits::I i) const noexcept
@@ -90,7 +91,7 @@ namespace xsparse
                 return m_crd[pk];
             }
 
-            inline void append_init(typename BaseTraits::IK szkm1) noexcept
+            inline void append_init(std::size_t szkm1) noexcept
             {
                 m_pos.resize(szkm1 + 1);
             }
@@ -107,10 +108,10 @@ namespace xsparse
                 m_crd.push_back(ik);
             }
 
-            inline void append_finalize(typename BaseTraits::IK szkm1) noexcept
+            inline void append_finalize(std::size_t szkm1) noexcept
             {
                 typename BaseTraits::PK cumsum = m_pos[0];
-                for (typename BaseTraits::PK pkm1 = 1; pkm1 <= szkm1; ++pkm1)
+                for (std::size_t pkm1 = 1; pkm1 <= szkm1; ++pkm1)
                 {
                     cumsum += m_pos[pkm1];
                     m_pos[pkm1] = cumsum;
@@ -122,6 +123,16 @@ namespace xsparse
                 return m_size;
             }
 
+            inline PosContainer const& get_pos() const noexcept
+            {
+                return m_pos;
+            }
+
+            inline CrdContainer const& get_crd() const noexcept
+            {
+                return m_crd;
+            }
+
         private:
             IK m_size;
             PosContainer m_pos;
@@ -1,6 +1,8 @@
 #ifndef XSPARSE_LEVELS_DENSE_HPP
 #define XSPARSE_LEVELS_DENSE_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <xsparse/util/base_traits.hpp>
 #include <xsparse/level_capabilities/coordinate_iterate.hpp>
@@ -57,12 +59,26 @@ namespace xsparse
                                                   [[maybe_unused]] typename BaseTraits::I i,
                                                   IK ik) const noexcept
             {
-                return std::optional(static_cast<PK>(pkm1 * m_size + ik));
+                // in `PK`, since the product overflows narrower coordinate types
+                return std::optional(static_cast<PK>(static_cast<PK>(pkm1) * static_cast<PK>(m_size)
+                                                     + static_cast<PK>(ik)));
             }
 
-            inline IK size(typename BaseTraits::IK szkm1) const noexcept
+            inline std::uint64_t word_access([[maybe_unused]] typename BaseTraits::PKM1 pkm1,
+                                             std::size_t w) const noexcept
+            /**
+             * @brief The coordinates `[64 * w, 64 * (w + 1))` of a fiber as a bitset, which are
+             * all present up to the size of the level.
+             */
             {
-                return szkm1 * m_size;
+                auto const remaining = static_cast<std::size_t>(m_size) - 64 * w;
+                return remaining >= 64 ? ~std::uint64_t{ 0 }
+                                       : (std::uint64_t{ 1 } << remaining) - 1;
+            }
+
+            inline std::size_t size(std::size_t szkm1) const noexcept
+            {
+                return szkm1 * static_cast<std::size_t>(m_size);
             }
 
             inline IK size() const noexcept
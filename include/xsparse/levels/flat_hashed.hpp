@@ -0,0 +1,394 @@
+#ifndef XSPARSE_LEVELS_FLAT_HASHED_HPP
+#define XSPARSE_LEVELS_FLAT_HASHED_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <optional>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include <xsparse/util/base_traits.hpp>
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/level_properties.hpp>
+#include <xtl/xiterator_base.hpp>
+
+namespace xsparse
+{
+    namespace levels
+    {
+        /**
+         * @brief A hashed level stored in one open-addressing table for all fibers.
+         *
+         * @details A drop-in alternative to `hashed`, which keeps one node-based map per parent
+         * position. The table is keyed on `(pkm1, ik)` and laid out like a SwissTable: a
+         * control byte per slot holds 7 bits of the hash (or marks the slot empty), and
+         * `locate` compares a whole group of 16 control bytes at once (with SSE2 where
+         * available) before touching any slot. The entries of each fiber are also chained in
+         * insertion order so that `iter_helper` does not have to scan the table.
+         */
+        template <class LowerLevels,
+                  class IK,
+                  class PK,
+                  class ContainerTraits
+                  = util::container_traits<std::vector, std::unordered_set, std::unordered_map>,
+                  class _LevelProperties = level_properties<true, false, true, false, false>>
+        class flat_hashed;
+
+        template <class... LowerLevels,
+                  class IK,
+                  class PK,
+                  class ContainerTraits,
+                  class _LevelProperties>
+        class flat_hashed<std::tuple<LowerLevels...>, IK, PK, ContainerTraits, _LevelProperties>
+        {
+            static_assert(!_LevelProperties::is_ordered);
+            static_assert(!_LevelProperties::is_branchless);
+            static_assert(!_LevelProperties::is_compact);
+
+        public:
+            using BaseTraits = util::base_traits<flat_hashed,
+                                                 std::tuple<LowerLevels...>,
+                                                 IK,
+                                                 PK,
+                                                 ContainerTraits,
+                                                 _LevelProperties>;
+            using LevelProperties = _LevelProperties;
+
+        private:
+            using CrdContainer = typename ContainerTraits::template Vec<
+                typename ContainerTraits::template Map<IK, PK>>;
+
+            static constexpr std::size_t GROUP_SIZE = 16;
+            static constexpr std::int8_t EMPTY = std::numeric_limits<std::int8_t>::min();
+            static constexpr std::size_t NPOS = std::numeric_limits<std::size_t>::max();
+
+            struct slot
+            {
+                typename BaseTraits::PKM1 pkm1;
+                IK ik;
+                PK pk;
+                std::size_t entry;
+            };
+
+        public:
+            class iteration_helper
+            {
+                static_assert(std::is_nothrow_invocable_r_v<std::optional<typename BaseTraits::PK>,
+                                                            decltype(&BaseTraits::Level::locate),
+                                                            typename BaseTraits::Level&,
+                                                            typename BaseTraits::PKM1,
+                                                            typename BaseTraits::IK>);
+
+            private:
+                typename BaseTraits::Level const& m_level;
+                std::size_t const m_head;
+
+            public:
+                class iterator;
+                using value_type =
+                    typename std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
+                using difference_type = std::ptrdiff_t;
+                using pointer =
+                    typename std::pair<typename BaseTraits::IK, typename BaseTraits::PK>*;
+                using reference = std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
+                using iterator_type = iterator;
+
+                class iterator : public xtl::xbidirectional_iterator_base2<iteration_helper>
+                {
+                private:
+                    typename BaseTraits::Level const& m_level;
+                    std::size_t m_entry;
+
+                public:
+                    using parent_type = typename BaseTraits::Level;
+
+                    explicit inline iterator(typename BaseTraits::Level const& level,
+                                             std::size_t entry) noexcept
+                        : m_level(level)
+                        , m_entry(entry)
+                    {
+                    }
+
+                    inline std::tuple<typename BaseTraits::IK, typename BaseTraits::PK> operator*()
+                        const noexcept
+                    {
+                        return { m_level.m_entry_ik[m_entry], m_level.m_entry_pk[m_entry] };
+                    }
+
+                    inline bool operator==(const iterator& other) const noexcept
+                    {
+                        return &m_level == &other.m_level && m_entry == other.m_entry;
+                    }
+
+                    inline iterator& operator++() noexcept
+                    {
+                        m_entry = m_level.m_entry_next[m_entry];
+                        return *this;
+                    }
+                };
+
+                explicit inline iteration_helper(typename BaseTraits::Level const& level,
+                                                 std::size_t head) noexcept
+                    : m_level(level)
+                    , m_head(head)
+                {
+                }
+
+                inline iterator_type begin() const noexcept
+                {
+                    return iterator_type{ m_level, m_head };
+                }
+
+                inline iterator_type end() const noexcept
+                {
+                    return iterator_type{ m_level, NPOS };
+                }
+            };
+
+            iteration_helper iter_helper([[maybe_unused]] typename BaseTraits::I i,
+                                         typename BaseTraits::PKM1 pkm1) const noexcept
+            {
+                // i is not used, but it is here to make the interface consistent with other levels
+                return iteration_helper{ *this, m_head[pkm1] };
+            }
+
+            flat_hashed(IK size)
+                : m_size(std::move(size))
+            {
+            }
+
+            flat_hashed(IK size, CrdContainer const& crd)
+                : m_size(std::move(size))
+            /**
+             * @brief Builds the table from the per-fiber maps a `hashed` level is made of.
+             */
+            {
+                std::size_t nnz = 0;
+                for (auto const& map : crd)
+                {
+                    nnz += map.size();
+                }
+                reserve(nnz);
+                insert_init(crd.size());
+                for (std::size_t pkm1 = 0; pkm1 < crd.size(); ++pkm1)
+                {
+                    for (auto const& [ik, pk] : crd[pkm1])
+                    {
+                        insert_coord(static_cast<typename BaseTraits::PKM1>(pkm1), pk, ik);
+                    }
+                }
+            }
+
+            inline auto locate(typename BaseTraits::PKM1 pkm1, IK ik) const noexcept
+            {
+                auto const s = find_slot(pkm1, ik);
+                return s != NPOS ? std::optional<PK>(m_slots[s].pk) : std::nullopt;
+            }
+
+            inline void insert_init(std::size_t szkm1) noexcept
+            {
+                m_head.resize(szkm1, NPOS);
+                m_tail.resize(szkm1, NPOS);
+            }
+
+            inline void insert_coord(typename BaseTraits::PKM1 pkm1, PK pk, IK ik) noexcept
+            {
+                if (auto const s = find_slot(pkm1, ik); s != NPOS)
+                {
+                    m_slots[s].pk = pk;
+                    m_entry_pk[m_slots[s].entry] = pk;
+                    return;
+                }
+
+                // keep the load factor at most 7/8, so that every probe meets an empty slot
+                if (8 * (m_entry_ik.size() + 1) > 7 * capacity())
+                {
+                    rehash(std::max(GROUP_SIZE, 2 * capacity()));
+                }
+
+                std::size_t const entry = m_entry_ik.size();
+                m_entry_ik.push_back(ik);
+                m_entry_pk.push_back(pk);
+                m_entry_next.push_back(NPOS);
+                if (m_tail[pkm1] == NPOS)
+                {
+                    m_head[pkm1] = entry;
+                }
+                else
+                {
+                    m_entry_next[m_tail[pkm1]] = entry;
+                }
+                m_tail[pkm1] = entry;
+
+                place(slot{ pkm1, ik, pk, entry });
+            }
+
+            inline void reserve(std::size_t nnz) noexcept
+            /**
+             * @brief Sizes the table to hold `nnz` coordinates without rehashing.
+             */
+            {
+                std::size_t cap = GROUP_SIZE;
+                while (8 * nnz > 7 * cap)
+                {
+                    cap *= 2;
+                }
+                if (cap > capacity())
+                {
+                    rehash(cap);
+                }
+            }
+
+            inline IK size() const noexcept
+            {
+                return m_size;
+            }
+
+        private:
+            inline std::size_t capacity() const noexcept
+            {
+                return m_slots.size();
+            }
+
+            static inline std::uint64_t hash(typename BaseTraits::PKM1 pkm1, IK ik) noexcept
+            {
+                std::uint64_t h = static_cast<std::uint64_t>(pkm1) * 0x9E3779B97F4A7C15ULL
+                                  ^ static_cast<std::uint64_t>(ik);
+                h *= 0xBF58476D1CE4E5B9ULL;
+                return h ^ (h >> 31);
+            }
+
+            static inline std::uint32_t match_group(std::int8_t const* ctrl,
+                                                    std::int8_t byte) noexcept
+            /**
+             * @brief A bitmask of the control bytes in `[ctrl, ctrl + GROUP_SIZE)` equal to
+             * `byte`.
+             */
+            {
+#if defined(__SSE2__) || defined(_M_X64)
+                __m128i const group = _mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl));
+                return static_cast<std::uint32_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte))));
+#else
+                std::uint32_t mask = 0;
+                for (std::size_t j = 0; j < GROUP_SIZE; ++j)
+                {
+                    mask |= static_cast<std::uint32_t>(ctrl[j] == byte) << j;
+                }
+                return mask;
+#endif
+            }
+
+            inline std::size_t find_slot(typename BaseTraits::PKM1 pkm1, IK ik) const noexcept
+            {
+                if (capacity() == 0)
+                {
+                    return NPOS;
+                }
+
+                auto const h = hash(pkm1, ik);
+                auto const h2 = static_cast<std::int8_t>(h & 0x7F);
+                std::size_t const mask = capacity() - 1;
+                std::size_t pos = static_cast<std::size_t>(h >> 7) & mask;
+                // triangular probing over groups visits every group of a power-of-two table
+                for (std::size_t step = GROUP_SIZE;; pos = (pos + step) & mask, step += GROUP_SIZE)
+                {
+                    std::int8_t const* ctrl = m_ctrl.data() + pos;
+                    for (auto match = match_group(ctrl, h2); match != 0; match &= match - 1)
+                    {
+                        std::size_t const s = (pos + std::countr_zero(match)) & mask;
+                        if (m_slots[s].ik == ik && m_slots[s].pkm1 == pkm1)
+                        {
+                            return s;
+                        }
+                    }
+                    if (match_group(ctrl, EMPTY) != 0)
+                    {
+                        return NPOS;
+                    }
+                }
+            }
+
+            inline void place(slot const& entry) noexcept
+            {
+                auto const h = hash(entry.pkm1, entry.ik);
+                std::size_t const mask = capacity() - 1;
+                std::size_t pos = static_cast<std::size_t>(h >> 7) & mask;
+                std::uint32_t empty;
+                for (std::size_t step = GROUP_SIZE;
+                     (empty = match_group(m_ctrl.data() + pos, EMPTY)) == 0;
+                     pos = (pos + step) & mask, step += GROUP_SIZE)
+                {
+                }
+
+                std::size_t const s = (pos + std::countr_zero(empty)) & mask;
+                set_ctrl(s, static_cast<std::int8_t>(h & 0x7F));
+                m_slots[s] = entry;
+            }
+
+            inline void set_ctrl(std::size_t s, std::int8_t byte) noexcept
+            {
+                m_ctrl[s] = byte;
+                // the first group is mirrored past the end, so that groups can be loaded from
+                // any position without wrapping around
+                if (s < GROUP_SIZE)
+                {
+                    m_ctrl[capacity() + s] = byte;
+                }
+            }
+
+            inline void rehash(std::size_t new_capacity) noexcept
+            {
+                auto old_slots = std::move(m_slots);
+                auto old_ctrl = std::move(m_ctrl);
+                std::size_t const old_capacity = old_slots.size();
+
+                m_slots = decltype(m_slots)();
+                m_slots.resize(new_capacity);
+                m_ctrl = decltype(m_ctrl)();
+                m_ctrl.resize(new_capacity + GROUP_SIZE, EMPTY);
+                for (std::size_t s = 0; s < old_capacity; ++s)
+                {
+                    if (old_ctrl[s] != EMPTY)
+                    {
+                        place(old_slots[s]);
+                    }
+                }
+            }
+
+            IK m_size;
+            typename ContainerTraits::template Vec<std::int8_t> m_ctrl;
+            typename ContainerTraits::template Vec<slot> m_slots;
+            typename ContainerTraits::template Vec<std::size_t> m_head;
+            typename ContainerTraits::template Vec<std::size_t> m_tail;
+            typename ContainerTraits::template Vec<IK> m_entry_ik;
+            typename ContainerTraits::template Vec<PK> m_entry_pk;
+            typename ContainerTraits::template Vec<std::size_t> m_entry_next;
+        };
+    }  // namespace levels
+
+    template <class... LowerLevels,
+              class IK,
+              class PK,
+              class ContainerTraits,
+              class _LevelProperties>
+    struct util::coordinate_position_trait<
+        levels::flat_hashed<std::tuple<LowerLevels...>, IK, PK, ContainerTraits, _LevelProperties>>
+    {
+        using Coordinate = IK;
+        using Position = PK;
+    };
+}  // namespace xsparse
+
+
+#endif
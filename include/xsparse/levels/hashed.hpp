@@ -1,6 +1,9 @@
 #ifndef XSPARSE_LEVELS_HASHED_HPP
 #define XSPARSE_LEVELS_HASHED_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <utility>
 #include <optional>
@@ -25,6 +28,18 @@ namespace xsparse
                   class _LevelProperties = level_properties<true, false, true, false, false>>
         class hashed;
 
+        template <class LowerLevels,
+                  class IK,
+                  class PK,
+                  class Hashed,
+                  class _LevelProperties
+                  = level_properties<Hashed::LevelProperties::is_full,
+                                     true,
+                                     Hashed::LevelProperties::is_unique,
+                                     false,
+                                     false>>
+        class ordered_hashed;
+
         template <class... LowerLevels,
                   class IK,
                   class PK,
@@ -46,6 +61,7 @@ namespace xsparse
                                                  ContainerTraits,
                                                  _LevelProperties>;
             using LevelProperties = _LevelProperties;
+            using sorted_fiber_type = typename ContainerTraits::template Vec<std::pair<IK, PK>>;
 
         public:
             class iteration_helper
@@ -58,14 +74,13 @@ namespace xsparse
 
             private:
                 typename ContainerTraits::template Map<typename BaseTraits::IK,
-                                                       typename BaseTraits::PK>
-                    m_map;
+                                                       typename BaseTraits::PK> const& m_map;
 
             public:
                 class iterator;
                 using value_type =
                     typename std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
-                using difference_type = typename std::make_signed_t<typename BaseTraits::PK>;
+                using difference_type = std::ptrdiff_t;
                 using pointer =
                     typename std::pair<typename BaseTraits::IK, typename BaseTraits::PK>*;
                 using reference = std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
@@ -113,8 +128,12 @@ namespace xsparse
 
                 explicit inline iteration_helper(
                     typename ContainerTraits::template Map<typename BaseTraits::IK,
-                                                           typename BaseTraits::PK>& map) noexcept
+                                                           typename BaseTraits::PK> const&
+                        map) noexcept
                     : m_map(map)
+                /**
+                 * @brief A view over the fiber `map`, which must outlive this helper.
+                 */
                 {
                 }
 
@@ -130,7 +149,7 @@ namespace xsparse
             };
 
             iteration_helper iter_helper([[maybe_unused]] typename BaseTraits::I i,
-                                         typename BaseTraits::PKM1 pkm1)
+                                         typename BaseTraits::PKM1 pkm1) const noexcept
             {
                 // i is not used, but it is here to make the interface consistent with other levels
                 return iteration_helper{ this->m_crd[pkm1] };
@@ -150,7 +169,7 @@ namespace xsparse
 
             hashed(IK size, CrdContainer&& crd)
                 : m_size(std::move(size))
-                , m_crd(crd)
+                , m_crd(std::move(crd))
             {
             }
 
@@ -160,14 +179,60 @@ namespace xsparse
                 return it != m_crd[pkm1].end() ? std::optional<PK>(it->second) : std::nullopt;
             }
 
-            inline void insert_init(typename BaseTraits::IK szkm1) noexcept
+            inline sorted_fiber_type const& sorted_fiber(typename BaseTraits::PKM1 pkm1) const
+            /**
+             * @brief The entries of the fiber below `pkm1`, sorted by coordinate.
+             *
+             * @details The entries are copied out of the map and sorted the first time they are
+             * asked for, and kept until `insert_coord` changes the fiber or `insert_init`
+             * resizes the level. Building a fiber is not thread-safe, so concurrent readers
+             * should ask for every fiber they share once beforehand.
+             */
+            {
+                if (m_sorted_valid.size() != m_crd.size())
+                {
+                    m_sorted.resize(m_crd.size());
+                    m_sorted_valid.assign(m_crd.size(), 0);
+                }
+                auto const p = static_cast<std::size_t>(pkm1);
+                auto& fiber = m_sorted[p];
+                if (!m_sorted_valid[p])
+                {
+                    fiber.assign(m_crd[p].begin(), m_crd[p].end());
+                    std::sort(fiber.begin(),
+                              fiber.end(),
+                              [](auto const& a, auto const& b) { return a.first < b.first; });
+                    m_sorted_valid[p] = 1;
+                }
+                return fiber;
+            }
+
+            inline auto ordered() const noexcept
+            /**
+             * @brief An ordered view of this level, which iterates every fiber in increasing
+             * coordinate order through `sorted_fiber` and may be merged in disjunctions.
+             *
+             * @details The view yields the positions of this level, so data stays addressed the
+             * same way. It refers to this level, which must outlive it.
+             */
+            {
+                return ordered_hashed<std::tuple<LowerLevels...>, IK, PK, hashed>{ *this };
+            }
+
+            inline void insert_init(std::size_t szkm1) noexcept
             {
                 m_crd.resize(szkm1);
+                m_sorted.clear();
+                m_sorted_valid.clear();
             }
 
             inline void insert_coord(typename BaseTraits::PKM1 pkm1, PK pk, IK ik) noexcept
             {
                 m_crd[pkm1][ik] = pk;
+                if (static_cast<std::size_t>(pkm1) < m_sorted_valid.size())
+                {
+                    m_sorted_valid[static_cast<std::size_t>(pkm1)] = 0;
+                }
             }
 
             inline IK size() const noexcept
@@ -178,6 +243,195 @@ namespace xsparse
         private:
             IK m_size;
             CrdContainer m_crd;
+            // the fibers sorted on demand by `sorted_fiber`, and whether each is up to date
+            mutable typename ContainerTraits::template Vec<sorted_fiber_type> m_sorted;
+            mutable typename ContainerTraits::template Vec<std::uint8_t> m_sorted_valid;
+        };
+
+        template <class... LowerLevels,
+                  class IK,
+                  class PK,
+                  class Hashed,
+                  class _LevelProperties>
+        class ordered_hashed<std::tuple<LowerLevels...>, IK, PK, Hashed, _LevelProperties>
+        /**
+         * @brief An ordered view of a `hashed` level, returned by its `ordered()`.
+         *
+         * @details Iterates the fibers of the hashed level in increasing coordinate order,
+         * through the sorted copies the level builds lazily and drops when a fiber changes,
+         * and yields the positions of the hashed level. Being ordered, the view may appear in
+         * the disjunctions of `Coiterate` that the hashed level itself is excluded from, and
+         * its iterators `seek` by galloping over the sorted fiber. `locate` is forwarded to
+         * the hashed level.
+         */
+        {
+            static_assert(_LevelProperties::is_ordered);
+            static_assert(!_LevelProperties::is_branchless);
+            static_assert(!_LevelProperties::is_compact);
+
+        public:
+            using BaseTraits = util::base_traits<ordered_hashed,
+                                                 std::tuple<LowerLevels...>,
+                                                 IK,
+                                                 PK,
+                                                 Hashed,
+                                                 _LevelProperties>;
+            using LevelProperties = _LevelProperties;
+
+        public:
+            class iteration_helper
+            {
+            private:
+                using wrapped_iterator_type = typename Hashed::sorted_fiber_type::const_iterator;
+                wrapped_iterator_type m_begin, m_end;
+
+            public:
+                class iterator;
+                using value_type =
+                    typename std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
+                using difference_type = std::ptrdiff_t;
+                using pointer =
+                    typename std::pair<typename BaseTraits::IK, typename BaseTraits::PK>*;
+                using reference = std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
+                using iterator_type = iterator;
+
+                class iterator : public xtl::xrandom_access_iterator_base2<iteration_helper>
+                {
+                private:
+                    wrapped_iterator_type m_it, m_end;
+
+                public:
+                    using parent_type = typename BaseTraits::Level;
+
+                    explicit inline iterator(wrapped_iterator_type it,
+                                             wrapped_iterator_type end) noexcept
+                        : m_it(it)
+                        , m_end(end)
+                    {
+                    }
+
+                    inline std::tuple<typename BaseTraits::IK, typename BaseTraits::PK> operator*()
+                        const noexcept
+                    {
+                        return { m_it->first, m_it->second };
+                    }
+
+                    inline iterator& operator++() noexcept
+                    {
+                        ++m_it;
+                        return *this;
+                    }
+
+                    inline iterator& operator--() noexcept
+                    {
+                        --m_it;
+                        return *this;
+                    }
+
+                    inline iterator& operator+=(difference_type n) noexcept
+                    {
+                        m_it += n;
+                        return *this;
+                    }
+
+                    inline iterator& operator-=(difference_type n) noexcept
+                    {
+                        m_it -= n;
+                        return *this;
+                    }
+
+                    inline iterator& seek(typename BaseTraits::IK ik) noexcept
+                    /**
+                     * @brief Advance to the first entry whose coordinate is not less than
+                     * `ik`, galloping and then binary searching the last step.
+                     */
+                    {
+                        auto const crd_less = [&](difference_type n) noexcept
+                        { return (m_it + n)->first < ik; };
+                        difference_type const n_end = m_end - m_it;
+                        if (n_end == 0 || !crd_less(0))
+                        {
+                            return *this;
+                        }
+
+                        // Invariant: the coordinate at `lo` is less than `ik`.
+                        difference_type lo = 0;
+                        difference_type step = 1;
+                        while (step < n_end - lo && crd_less(lo + step))
+                        {
+                            lo += step;
+                            step *= 2;
+                        }
+                        difference_type const hi = std::min(lo + step, n_end);
+                        m_it = std::lower_bound(m_it + lo + 1,
+                                                m_it + hi,
+                                                ik,
+                                                [](auto const& e, typename BaseTraits::IK k)
+                                                { return e.first < k; });
+                        return *this;
+                    }
+
+                    inline difference_type operator-(iterator const& other)
+                    {
+                        return m_it - other.m_it;
+                    }
+
+                    inline bool operator==(iterator const& other) const noexcept
+                    {
+                        return m_it == other.m_it;
+                    }
+
+                    inline bool operator<(iterator const& other) const noexcept
+                    {
+                        return m_it < other.m_it;
+                    }
+                };
+
+                explicit inline iteration_helper(
+                    typename Hashed::sorted_fiber_type const& fiber) noexcept
+                    : m_begin(fiber.begin())
+                    , m_end(fiber.end())
+                /**
+                 * @brief A view over the sorted `fiber`, which must not change while the
+                 * helper is in use.
+                 */
+                {
+                }
+
+                inline iterator_type begin() const noexcept
+                {
+                    return iterator_type{ m_begin, m_end };
+                }
+
+                inline iterator_type end() const noexcept
+                {
+                    return iterator_type{ m_end, m_end };
+                }
+            };
+
+            explicit ordered_hashed(Hashed const& level) noexcept
+                : m_level(&level)
+            {
+            }
+
+            iteration_helper iter_helper([[maybe_unused]] typename BaseTraits::I i,
+                                         typename BaseTraits::PKM1 pkm1) const
+            {
+                return iteration_helper{ m_level->sorted_fiber(pkm1) };
+            }
+
+            inline auto locate(typename BaseTraits::PKM1 pkm1, IK ik) const noexcept
+            {
+                return m_level->locate(pkm1, ik);
+            }
+
+            inline IK size() const noexcept
+            {
+                return m_level->size();
+            }
+
+        private:
+            Hashed const* m_level;
         };
     }  // namespace levels
 
@@ -192,6 +446,14 @@ namespace xsparse
         using Coordinate = IK;
         using Position = PK;
     };
+
+    template <class... LowerLevels, class IK, class PK, class Hashed, class _LevelProperties>
+    struct util::coordinate_position_trait<
+        levels::ordered_hashed<std::tuple<LowerLevels...>, IK, PK, Hashed, _LevelProperties>>
+    {
+        using Coordinate = IK;
+        using Position = PK;
+    };
 }  // namespace xsparse
 
 
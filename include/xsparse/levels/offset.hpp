@@ -71,7 +71,7 @@ namespace xsparse
 
             offset(IK size, OffsetContainer&& offset)
                 : m_size(std::move(size))
-                , m_offset(offset)
+                , m_offset(std::move(offset))
             {
             }
 
@@ -92,6 +92,11 @@ namespace xsparse
                 return m_size;
             }
 
+            inline OffsetContainer const& get_offset() const noexcept
+            {
+                return m_offset;
+            }
+
         private:
             IK m_size;
             OffsetContainer m_offset;
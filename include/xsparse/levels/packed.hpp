@@ -0,0 +1,536 @@
+#ifndef XSPARSE_LEVELS_PACKED_HPP
+#define XSPARSE_LEVELS_PACKED_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <xsparse/util/base_traits.hpp>
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/level_properties.hpp>
+#include <xtl/xiterator_base.hpp>
+
+namespace xsparse
+{
+    namespace levels
+    {
+        /**
+         * @brief A `compressed` level whose coordinates are delta-encoded and bit-packed.
+         *
+         * @details The coordinates of every fiber are split into blocks of `BLOCK_SIZE`. A
+         * block stores its first and last coordinate, and the gaps between its consecutive
+         * coordinates, minus one, packed with the bit width of the largest of them. A run of
+         * consecutive coordinates thus takes no bits at all, and the coordinates of a fiber
+         * with `n` nonzeros out of `size` take about `log2(size / n)` bits each instead of
+         * `8 * sizeof(IK)`. The gaps are interleaved over `LANES` streams of words, gap `i` in
+         * stream `i % LANES`, so that the streams can be unpacked in parallel with the same
+         * shifts.
+         *
+         * Positions are the same as for `compressed`, so the data of a tensor is laid out
+         * alike. The iterator decodes one gap per step, `seek` skips whole blocks by their
+         * last coordinate before scanning a single block, and kernels can decode a block at a
+         * time with `decode`.
+         */
+        template <class LowerLevels,
+                  class IK,
+                  class PK,
+                  class ContainerTraits
+                  = util::container_traits<std::vector, std::unordered_set, std::unordered_map>,
+                  class _LevelProperties = level_properties<true, true, true, false, true>>
+        class packed;
+
+        template <class... LowerLevels,
+                  class IK,
+                  class PK,
+                  class ContainerTraits,
+                  class _LevelProperties>
+        class packed<std::tuple<LowerLevels...>, IK, PK, ContainerTraits, _LevelProperties>
+        {
+            static_assert(_LevelProperties::is_ordered);
+            static_assert(_LevelProperties::is_unique);
+            static_assert(!_LevelProperties::is_branchless);
+            static_assert(_LevelProperties::is_compact);
+            using PosContainer = typename ContainerTraits::template Vec<PK>;
+            using CrdContainer = typename ContainerTraits::template Vec<IK>;
+            using WordContainer = typename ContainerTraits::template Vec<std::uint64_t>;
+
+        public:
+            using BaseTraits = util::base_traits<packed,
+                                                 std::tuple<LowerLevels...>,
+                                                 IK,
+                                                 PK,
+                                                 ContainerTraits,
+                                                 _LevelProperties>;
+            using LevelProperties = _LevelProperties;
+
+            static constexpr std::size_t BLOCK_SIZE = 128;
+            static constexpr std::size_t LANES = 4;
+
+        public:
+            class iteration_helper
+            {
+            private:
+                typename BaseTraits::Level const& m_level;
+                typename BaseTraits::PK const m_pk_begin, m_pk_end;
+                std::size_t const m_block_begin;
+
+            public:
+                class iterator;
+                using value_type = typename BaseTraits::PK;
+                using difference_type = std::ptrdiff_t;
+                using key_type = typename BaseTraits::IK;
+                using pointer = typename BaseTraits::PK*;
+                using reference = std::pair<typename BaseTraits::IK, typename BaseTraits::PK>;
+                using iterator_type = iterator;
+
+                class iterator : public xtl::xrandom_access_iterator_base2<iteration_helper>
+                {
+                private:
+                    iteration_helper const& m_iterHelper;
+                    typename BaseTraits::PK m_pk;
+                    // the coordinate at `m_pk`, if it is not the end
+                    typename BaseTraits::IK m_ik;
+
+                    inline std::size_t offset() const noexcept
+                    {
+                        return static_cast<std::size_t>(m_pk - m_iterHelper.m_pk_begin);
+                    }
+
+                    inline std::size_t block() const noexcept
+                    {
+                        return m_iterHelper.m_block_begin + offset() / BLOCK_SIZE;
+                    }
+
+                    inline void load() noexcept
+                    {
+                        if (m_pk < m_iterHelper.m_pk_end)
+                        {
+                            m_ik = m_iterHelper.m_level.coordinate(block(),
+                                                                   offset() % BLOCK_SIZE);
+                        }
+                    }
+
+                public:
+                    using parent_type = typename BaseTraits::Level;
+
+                    explicit inline iterator(iteration_helper const& iterationHelper,
+                                             typename BaseTraits::PK pk) noexcept
+                        : m_iterHelper(iterationHelper)
+                        , m_pk(pk)
+                        , m_ik()
+                    {
+                        load();
+                    }
+
+                    inline std::tuple<typename BaseTraits::IK, typename BaseTraits::PK> operator*()
+                        const noexcept
+                    {
+                        return { m_ik, m_pk };
+                    }
+
+                    inline iterator& operator++() noexcept
+                    {
+                        ++m_pk;
+                        if (m_pk < m_iterHelper.m_pk_end)
+                        {
+                            auto const j = offset() % BLOCK_SIZE;
+                            auto const& level = m_iterHelper.m_level;
+                            m_ik = j == 0 ? level.m_first[block()]
+                                          : static_cast<typename BaseTraits::IK>(
+                                              m_ik + level.gap(block(), j));
+                        }
+                        return *this;
+                    }
+
+                    inline iterator& operator--() noexcept
+                    {
+                        auto const& level = m_iterHelper.m_level;
+                        if (m_pk == m_iterHelper.m_pk_end || offset() % BLOCK_SIZE == 0)
+                        {
+                            --m_pk;
+                            m_ik = level.m_last[block()];
+                        }
+                        else
+                        {
+                            m_ik = static_cast<typename BaseTraits::IK>(
+                                m_ik - level.gap(block(), offset() % BLOCK_SIZE));
+                            --m_pk;
+                        }
+                        return *this;
+                    }
+
+                    inline iterator& operator+=(difference_type n) noexcept
+                    {
+                        m_pk = static_cast<typename BaseTraits::PK>(m_pk + n);
+                        load();
+                        return *this;
+                    }
+
+                    inline iterator& operator-=(difference_type n) noexcept
+                    {
+                        m_pk = static_cast<typename BaseTraits::PK>(m_pk - n);
+                        load();
+                        return *this;
+                    }
+
+                    inline iterator& seek(typename BaseTraits::IK ik) noexcept
+                    /**
+                     * @brief Advance to the first coordinate that is not less than `ik`.
+                     *
+                     * @details Binary searches the last coordinates of the remaining blocks of
+                     * the fiber for the block holding `ik`, and decodes only that block.
+                     */
+                    {
+                        if (m_pk >= m_iterHelper.m_pk_end || !(m_ik < ik))
+                        {
+                            return *this;
+                        }
+
+                        auto const& level = m_iterHelper.m_level;
+                        auto const b = block();
+                        if (level.m_last[b] < ik)
+                        {
+                            auto const num_blocks
+                                = (static_cast<std::size_t>(m_iterHelper.m_pk_end
+                                                            - m_iterHelper.m_pk_begin)
+                                   + BLOCK_SIZE - 1)
+                                  / BLOCK_SIZE;
+                            auto const first = level.m_last.begin()
+                                               + static_cast<std::ptrdiff_t>(b + 1);
+                            auto const last = level.m_last.begin()
+                                              + static_cast<std::ptrdiff_t>(
+                                                  m_iterHelper.m_block_begin + num_blocks);
+                            auto const found = static_cast<std::size_t>(
+                                std::lower_bound(first, last, ik) - level.m_last.begin());
+                            if (found == m_iterHelper.m_block_begin + num_blocks)
+                            {
+                                m_pk = m_iterHelper.m_pk_end;
+                                return *this;
+                            }
+                            m_pk = static_cast<typename BaseTraits::PK>(
+                                m_iterHelper.m_pk_begin
+                                + (found - m_iterHelper.m_block_begin) * BLOCK_SIZE);
+                            m_ik = level.m_first[found];
+                        }
+
+                        // the block ends with a coordinate that is not less than `ik`
+                        while (m_ik < ik)
+                        {
+                            ++*this;
+                        }
+                        return *this;
+                    }
+
+                    inline difference_type operator-(iterator const& other) const noexcept
+                    {
+                        return static_cast<difference_type>(m_pk)
+                               - static_cast<difference_type>(other.m_pk);
+                    }
+
+                    inline bool operator==(iterator const& other) const noexcept
+                    {
+                        return m_pk == other.m_pk;
+                    }
+
+                    inline bool operator<(iterator const& other) const noexcept
+                    {
+                        return m_pk < other.m_pk;
+                    }
+                };
+
+                explicit inline iteration_helper(typename BaseTraits::Level const& level,
+                                                 typename BaseTraits::PK pk_begin,
+                                                 typename BaseTraits::PK pk_end,
+                                                 std::size_t block_begin) noexcept
+                    : m_level(level)
+                    , m_pk_begin(pk_begin)
+                    , m_pk_end(pk_end)
+                    , m_block_begin(block_begin)
+                {
+                }
+
+                inline iterator_type begin() const noexcept
+                {
+                    return iterator_type{ *this, m_pk_begin };
+                }
+
+                inline iterator_type end() const noexcept
+                {
+                    return iterator_type{ *this, m_pk_end };
+                }
+            };
+
+            iteration_helper iter_helper([[maybe_unused]] typename BaseTraits::I i,
+                                         typename BaseTraits::PKM1 pkm1) const noexcept
+            {
+                // i is not used, but it is here to make the interface consistent with other levels
+                auto const [pk_begin, pk_end] = pos_bounds(pkm1);
+                return iteration_helper{
+                    *this, pk_begin, pk_end, static_cast<std::size_t>(m_block_pos[pkm1])
+                };
+            }
+
+            packed(IK size)
+                : m_size(std::move(size))
+                , m_pos()
+            {
+            }
+
+            packed(IK size, PosContainer const& pos, CrdContainer const& crd)
+                : m_size(std::move(size))
+                , m_pos(pos)
+            /**
+             * @brief Encode the `pos` and `crd` arrays of a `compressed` level.
+             */
+            {
+                encode(crd);
+            }
+
+            packed(IK size, PosContainer&& pos, CrdContainer const& crd)
+                : m_size(std::move(size))
+                , m_pos(std::move(pos))
+            {
+                encode(crd);
+            }
+
+            inline std::pair<PK, PK> pos_bounds(typename BaseTraits::PKM1 const pkm1) const noexcept
+            {
+                return { m_pos[pkm1], m_pos[static_cast<std::size_t>(pkm1) + 1] };
+            }
+
+            inline std::size_t decode(typename BaseTraits::PKM1 const pkm1,
+                                      std::size_t k,
+                                      IK* out) const noexcept
+            /**
+             * @brief Decode block `k` of fiber `pkm1` into `out`, which must have room for
+             * `BLOCK_SIZE` coordinates.
+             *
+             * @details Unpacks the gaps of all lanes at once, with the same shifts for every
+             * lane, which vectorizes, and then sums them up.
+             *
+             * @return The number of coordinates in the block.
+             */
+            {
+                auto const [pk_begin, pk_end] = pos_bounds(pkm1);
+                auto const b = static_cast<std::size_t>(m_block_pos[pkm1]) + k;
+                auto const n = std::min(BLOCK_SIZE,
+                                        static_cast<std::size_t>(pk_end - pk_begin)
+                                            - k * BLOCK_SIZE);
+                std::size_t const width = m_width[b];
+                std::uint64_t const* const words = m_words.data() + m_word_offset[b];
+                std::uint64_t const mask
+                    = width == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << width) - 1;
+
+                std::uint64_t gaps[BLOCK_SIZE];
+                for (std::size_t t = 0, bit = 0; t * LANES + 1 < n; ++t, bit += width)
+                {
+                    std::uint64_t const* const w = words + bit / 64 * LANES;
+                    std::size_t const shift = bit % 64;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                    {
+                        // `<< 1 << (63 - shift)` is zero rather than undefined for no shift
+                        gaps[t * LANES + l]
+                            = (((w[l] >> shift) | (w[l + LANES] << 1 << (63 - shift))) & mask) + 1;
+                    }
+                }
+
+                IK ik = m_first[b];
+                out[0] = ik;
+                for (std::size_t j = 1; j < n; ++j)
+                {
+                    ik = static_cast<IK>(ik + gaps[j - 1]);
+                    out[j] = ik;
+                }
+                return n;
+            }
+
+            inline void append_init(std::size_t szkm1) noexcept
+            {
+                m_pos.resize(szkm1 + 1);
+            }
+
+            inline void append_edges(typename BaseTraits::PKM1 const pkm1,
+                                     typename BaseTraits::PK pk_begin,
+                                     typename BaseTraits::PK pk_end) noexcept
+            {
+                m_pos[pkm1 + 1] = pk_end - pk_begin;
+            }
+
+            inline void append_coord(typename BaseTraits::IK ik) noexcept
+            {
+                // coordinates are encoded once all fibers are known
+                m_appended.push_back(ik);
+            }
+
+            inline void append_finalize(std::size_t szkm1) noexcept
+            {
+                typename BaseTraits::PK cumsum = m_pos[0];
+                for (std::size_t pkm1 = 1; pkm1 <= szkm1; ++pkm1)
+                {
+                    cumsum += m_pos[pkm1];
+                    m_pos[pkm1] = cumsum;
+                }
+                encode(m_appended);
+                m_appended = CrdContainer();
+            }
+
+            inline IK size() const noexcept
+            {
+                return m_size;
+            }
+
+            inline PosContainer const& get_pos() const noexcept
+            {
+                return m_pos;
+            }
+
+            inline WordContainer const& get_words() const noexcept
+            /**
+             * @brief The packed gaps of all blocks.
+             */
+            {
+                return m_words;
+            }
+
+        private:
+            inline std::uint64_t gap(std::size_t b, std::size_t j) const noexcept
+            /**
+             * @brief The difference between coordinates `j - 1` and `j` of block `b`.
+             */
+            {
+                std::size_t const width = m_width[b];
+                std::size_t const bit = (j - 1) / LANES * width;
+                std::size_t const shift = bit % 64;
+                std::uint64_t const* const w
+                    = m_words.data() + m_word_offset[b] + bit / 64 * LANES + (j - 1) % LANES;
+                // the words are padded, so the next word of the lane can always be read
+                std::uint64_t const value = (w[0] >> shift) | (w[LANES] << 1 << (63 - shift));
+                std::uint64_t const mask
+                    = width == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << width) - 1;
+                return (value & mask) + 1;
+            }
+
+            inline IK coordinate(std::size_t b, std::size_t j) const noexcept
+            {
+                auto ik = m_first[b];
+                for (std::size_t t = 1; t <= j; ++t)
+                {
+                    ik = static_cast<IK>(ik + gap(b, t));
+                }
+                return ik;
+            }
+
+            template <class Crd>
+            inline void encode(Crd const& crd)
+            {
+                auto const num_fibers = static_cast<std::size_t>(m_pos.size()) - 1;
+                m_block_pos.resize(num_fibers + 1);
+                m_block_pos[0] = 0;
+                for (std::size_t f = 0; f < num_fibers; ++f)
+                {
+                    auto const len = static_cast<std::size_t>(m_pos[f + 1] - m_pos[f]);
+                    m_block_pos[f + 1] = static_cast<PK>(m_block_pos[f]
+                                                         + (len + BLOCK_SIZE - 1) / BLOCK_SIZE);
+                }
+
+                auto const num_blocks = static_cast<std::size_t>(m_block_pos[num_fibers]);
+                m_first.resize(num_blocks);
+                m_last.resize(num_blocks);
+                m_width.resize(num_blocks);
+                m_word_offset.resize(num_blocks);
+
+                // the bit width of every block, from its largest gap
+                std::size_t words = 0;
+                for (std::size_t f = 0; f < num_fibers; ++f)
+                {
+                    auto const pk_end = static_cast<std::size_t>(m_pos[f + 1]);
+                    for (auto b = static_cast<std::size_t>(m_block_pos[f]);
+                         b < static_cast<std::size_t>(m_block_pos[f + 1]);
+                         ++b)
+                    {
+                        auto const p0 = static_cast<std::size_t>(m_pos[f])
+                                        + (b - static_cast<std::size_t>(m_block_pos[f]))
+                                              * BLOCK_SIZE;
+                        auto const p1 = std::min(p0 + BLOCK_SIZE, pk_end);
+                        std::uint64_t largest = 0;
+                        for (auto p = p0 + 1; p < p1; ++p)
+                        {
+                            largest = std::max(
+                                largest, static_cast<std::uint64_t>(crd[p] - crd[p - 1] - 1));
+                        }
+                        m_first[b] = crd[p0];
+                        m_last[b] = crd[p1 - 1];
+                        m_width[b] = static_cast<std::uint8_t>(std::bit_width(largest));
+                        m_word_offset[b] = words;
+                        auto const per_lane = (p1 - p0 - 1 + LANES - 1) / LANES;
+                        words += (per_lane * m_width[b] + 63) / 64 * LANES;
+                    }
+                }
+
+                m_words.resize(0);
+                // padded, so that the next word of every lane can be read
+                m_words.resize(words + 2 * LANES, 0);
+                for (std::size_t f = 0; f < num_fibers; ++f)
+                {
+                    for (auto b = static_cast<std::size_t>(m_block_pos[f]);
+                         b < static_cast<std::size_t>(m_block_pos[f + 1]);
+                         ++b)
+                    {
+                        auto const p0 = static_cast<std::size_t>(m_pos[f])
+                                        + (b - static_cast<std::size_t>(m_block_pos[f]))
+                                              * BLOCK_SIZE;
+                        auto const p1
+                            = std::min(p0 + BLOCK_SIZE, static_cast<std::size_t>(m_pos[f + 1]));
+                        for (auto p = p0 + 1; p < p1; ++p)
+                        {
+                            auto const i = p - p0 - 1;
+                            auto const bit = i / LANES * m_width[b];
+                            auto const w = m_word_offset[b] + bit / 64 * LANES + i % LANES;
+                            auto const value = static_cast<std::uint64_t>(crd[p] - crd[p - 1] - 1);
+                            m_words[w] |= value << (bit % 64);
+                            if (bit % 64 + m_width[b] > 64)
+                            {
+                                m_words[w + LANES] |= value >> (64 - bit % 64);
+                            }
+                        }
+                    }
+                }
+            }
+
+            IK m_size;
+            PosContainer m_pos;
+            // the first block of every fiber
+            PosContainer m_block_pos;
+            // the first and last coordinate, the bit width of the gaps and the first word of
+            // every block
+            CrdContainer m_first;
+            CrdContainer m_last;
+            typename ContainerTraits::template Vec<std::uint8_t> m_width;
+            typename ContainerTraits::template Vec<std::size_t> m_word_offset;
+            WordContainer m_words;
+            // the coordinates appended to the level before it is encoded
+            CrdContainer m_appended;
+        };
+    }  // namespace levels
+
+    template <class... LowerLevels,
+              class IK,
+              class PK,
+              class ContainerTraits,
+              class _LevelProperties>
+    struct util::coordinate_position_trait<
+        levels::packed<std::tuple<LowerLevels...>, IK, PK, ContainerTraits, _LevelProperties>>
+    {
+        using Coordinate = IK;
+        using Position = PK;
+    };
+}  // namespace xsparse
+
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef XSPARSE_LEVELS_RANGE_HPP
 #define XSPARSE_LEVELS_RANGE_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
 #include <utility>
 #include <xsparse/util/base_traits.hpp>
 #include <xsparse/level_capabilities/coordinate_iterate.hpp>
@@ -73,7 +76,7 @@ namespace xsparse
             range(IK size_N, IK size_M, OffsetContainer&& offset)
                 : m_size_N(std::move(size_N))
                 , m_size_M(std::move(size_M))
-                , m_offset(offset)
+                , m_offset(std::move(offset))
             {
             }
 
@@ -81,15 +84,36 @@ namespace xsparse
             {
                 static_assert(std::tuple_size_v<decltype(i)> >= 1,
                               "Tuple size should be at least 1");
-                return { static_cast<IK>(std::max(0, -m_offset[std::get<0>(i)])),
-                         static_cast<IK>(std::min(m_size_N, m_size_M - m_offset[std::get<0>(i)])) };
+                // offsets are signed; with an unsigned `PK` a negative one wraps around
+                auto const offset = static_cast<std::ptrdiff_t>(
+                    static_cast<std::make_signed_t<PK>>(m_offset[std::get<0>(i)]));
+                auto const size_N = static_cast<std::ptrdiff_t>(m_size_N);
+                auto const size_M = static_cast<std::ptrdiff_t>(m_size_M);
+                return { static_cast<IK>(std::max(std::ptrdiff_t{ 0 }, -offset)),
+                         static_cast<IK>(std::min(size_N, size_M - offset)) };
             }
 
             inline std::optional<PK> coord_access(typename BaseTraits::PKM1 pkm1,
                                                   [[maybe_unused]] typename BaseTraits::I i,
                                                   IK ik) const noexcept
             {
-                return std::optional(static_cast<PK>(pkm1 * m_size_N + ik));
+                return std::optional(static_cast<PK>(
+                    static_cast<PK>(pkm1) * static_cast<PK>(m_size_N) + static_cast<PK>(ik)));
+            }
+
+            inline IK size() const noexcept
+            {
+                return m_size_N;
+            }
+
+            inline IK get_size_M() const noexcept
+            {
+                return m_size_M;
+            }
+
+            inline OffsetContainer const& get_offset() const noexcept
+            {
+                return m_offset;
             }
 
         private:
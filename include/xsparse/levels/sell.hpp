@@ -0,0 +1,269 @@
+#ifndef XSPARSE_LEVELS_SELL_HPP
+#define XSPARSE_LEVELS_SELL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <xsparse/level_capabilities/coordinate_iterate.hpp>
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/level_properties.hpp>
+
+namespace xsparse
+{
+    namespace levels
+    {
+        /**
+         * @brief A level in the sliced ELLPACK format SELL-C-sigma, which stores the fibers of
+         * `SliceSize` parent positions (e.g. the rows of a matrix) interleaved.
+         *
+         * @details The parent positions are sorted by the length of their fibers, longest
+         * first, within windows of `sigma` positions, and consecutive groups of `C` of them
+         * form a slice. A slice is padded to its longest fiber and stored column by column:
+         * the `j`-th coordinate of the fiber in lane `l` of slice `s` is at position
+         * `slice_pos[s] + j * C + l`. The `C` lanes of a slice are thus processed together by
+         * kernels, e.g. one lane per SIMD element, and sorting keeps the padding small.
+         *
+         * Since consecutive coordinates of a fiber are `C` positions apart, the level sets
+         * `POS_STRIDE`, and `pos_bounds`/`pos_access` satisfy the contract of
+         * `coordinate_position_iterate`, so the level can be iterated and coiterated like
+         * `compressed`. The data of the tensor must follow the same layout, which `pack`
+         * computes from the data of the equivalent compressed level, with zeros as padding.
+         *
+         * @tparam SliceSize - a `std::integral_constant` with the number of lanes `C` of a
+         * slice.
+         */
+        template <class LowerLevels,
+                  class IK,
+                  class PK,
+                  class SliceSize,
+                  class ContainerTraits
+                  = util::container_traits<std::vector, std::unordered_set, std::unordered_map>,
+                  class _LevelProperties = level_properties<false, true, true, false, false>>
+        class sell;
+
+        template <class... LowerLevels,
+                  class IK,
+                  class PK,
+                  class SliceSize,
+                  class ContainerTraits,
+                  class _LevelProperties>
+        class sell<std::tuple<LowerLevels...>,
+                   IK,
+                   PK,
+                   SliceSize,
+                   ContainerTraits,
+                   _LevelProperties>
+            : public level_capabilities::coordinate_position_iterate<sell,
+                                                                     std::tuple<LowerLevels...>,
+                                                                     IK,
+                                                                     PK,
+                                                                     SliceSize,
+                                                                     ContainerTraits,
+                                                                     _LevelProperties>
+
+        {
+            static_assert(!_LevelProperties::is_branchless);
+            static_assert(!_LevelProperties::is_compact);
+            static_assert(SliceSize::value > 0, "Slices must have at least one lane");
+            using PosContainer = typename ContainerTraits::template Vec<PK>;
+            using CrdContainer = typename ContainerTraits::template Vec<IK>;
+
+        public:
+            using BaseTraits = util::base_traits<sell,
+                                                 std::tuple<LowerLevels...>,
+                                                 IK,
+                                                 PK,
+                                                 SliceSize,
+                                                 ContainerTraits,
+                                                 _LevelProperties>;
+            using LevelCapabilities
+                = level_capabilities::coordinate_position_iterate<sell,
+                                                                  std::tuple<LowerLevels...>,
+                                                                  IK,
+                                                                  PK,
+                                                                  SliceSize,
+                                                                  ContainerTraits,
+                                                                  _LevelProperties>;
+            using LevelProperties = _LevelProperties;
+
+            static constexpr std::size_t SLICE_SIZE = SliceSize::value;
+            static constexpr std::size_t POS_STRIDE = SliceSize::value;
+
+        public:
+            sell(IK size, PosContainer const& pos, CrdContainer const& crd, std::size_t sigma = 1)
+                : m_size(std::move(size))
+            /**
+             * @brief Build the level from the `pos` and `crd` arrays of a `compressed` level,
+             * sorting the fibers by length within windows of `sigma` parent positions.
+             *
+             * @details A `sigma` of 1 keeps the parent positions in order, while a `sigma` of
+             * a few slices is usually enough to remove most of the padding.
+             */
+            {
+                constexpr std::size_t C = SLICE_SIZE;
+                std::size_t const num_rows = pos.size() - 1;
+                std::size_t const num_slices = (num_rows + C - 1) / C;
+                sigma = std::max<std::size_t>(sigma, 1);
+
+                m_len.resize(num_rows);
+                for (std::size_t r = 0; r < num_rows; ++r)
+                {
+                    m_len[r] = static_cast<PK>(pos[r + 1] - pos[r]);
+                }
+
+                // lanes past the last parent position hold the sentinel `num_rows`
+                std::vector<std::size_t> order(num_slices * C, num_rows);
+                std::iota(order.begin(), order.begin() + num_rows, std::size_t{ 0 });
+                for (std::size_t w = 0; w < num_rows; w += sigma)
+                {
+                    std::stable_sort(order.begin() + w,
+                                     order.begin() + std::min(w + sigma, num_rows),
+                                     [&](std::size_t a, std::size_t b)
+                                     { return m_len[a] > m_len[b]; });
+                }
+
+                m_lane.resize(num_rows);
+                m_row.resize(num_slices * C);
+                m_slice_pos.resize(num_slices + 1);
+                m_slice_pos[0] = 0;
+                for (std::size_t t = 0; t < num_slices * C; ++t)
+                {
+                    m_row[t] = static_cast<PK>(order[t]);
+                    if (order[t] < num_rows)
+                    {
+                        m_lane[order[t]] = static_cast<PK>(t);
+                    }
+                }
+                for (std::size_t s = 0; s < num_slices; ++s)
+                {
+                    PK width = 0;
+                    for (std::size_t l = 0; l < C; ++l)
+                    {
+                        auto const r = order[s * C + l];
+                        width = r < num_rows ? std::max(width, m_len[r]) : width;
+                    }
+                    m_slice_pos[s + 1] = static_cast<PK>(m_slice_pos[s] + width * C);
+                }
+
+                m_crd.resize(m_slice_pos[num_slices]);
+                for (std::size_t r = 0; r < num_rows; ++r)
+                {
+                    auto const begin = fiber_begin(static_cast<PK>(r));
+                    for (std::size_t j = 0; j < static_cast<std::size_t>(m_len[r]); ++j)
+                    {
+                        m_crd[begin + j * C] = crd[pos[r] + j];
+                    }
+                }
+            }
+
+            inline std::pair<PK, PK> pos_bounds(typename BaseTraits::PKM1 const pkm1) const noexcept
+            {
+                auto const begin = fiber_begin(static_cast<PK>(pkm1));
+                return { begin, static_cast<PK>(begin + m_len[pkm1] * SLICE_SIZE) };
+            }
+
+            inline IK pos_access(PK pk, [[maybe_unused]] typename BaseTraits::I i) const noexcept
+            {
+                return m_crd[pk];
+            }
+
+            inline IK size() const noexcept
+            {
+                return m_size;
+            }
+
+            inline std::size_t num_slices() const noexcept
+            {
+                return m_slice_pos.size() - 1;
+            }
+
+            inline std::pair<PK, PK> slice_bounds(std::size_t s) const noexcept
+            /**
+             * @brief The positions of slice `s`, including padding, whose lanes are
+             * interleaved.
+             */
+            {
+                return { m_slice_pos[s], m_slice_pos[s + 1] };
+            }
+
+            inline PK slice_row(std::size_t t) const noexcept
+            /**
+             * @brief The parent position in lane `t % SLICE_SIZE` of slice `t / SLICE_SIZE`,
+             * or the number of parent positions for an unused lane of the last slice.
+             */
+            {
+                return m_row[t];
+            }
+
+            inline CrdContainer const& get_crd() const noexcept
+            {
+                return m_crd;
+            }
+
+            template <class Data>
+            inline Data pack(Data const& values) const
+            /**
+             * @brief The data of a tensor in the layout of this level, from the data `values`
+             * of the `compressed` level it was built from. Padding is value-initialized.
+             */
+            {
+                Data packed;
+                packed.resize(m_crd.size());
+                std::size_t p = 0;
+                for (std::size_t r = 0; r < m_len.size(); ++r)
+                {
+                    auto const begin = fiber_begin(static_cast<PK>(r));
+                    for (std::size_t j = 0; j < static_cast<std::size_t>(m_len[r]); ++j)
+                    {
+                        packed[begin + j * SLICE_SIZE] = values[p++];
+                    }
+                }
+                return packed;
+            }
+
+        private:
+            inline PK fiber_begin(PK pkm1) const noexcept
+            {
+                auto const t = static_cast<std::size_t>(m_lane[pkm1]);
+                return static_cast<PK>(m_slice_pos[t / SLICE_SIZE] + t % SLICE_SIZE);
+            }
+
+            IK m_size;
+            // the first position of every slice
+            PosContainer m_slice_pos;
+            // the lane of every parent position, and the parent position of every lane
+            PosContainer m_lane;
+            PosContainer m_row;
+            // the length of the fiber below every parent position
+            PosContainer m_len;
+            CrdContainer m_crd;
+        };
+    }  // namespace levels
+
+    template <class... LowerLevels,
+              class IK,
+              class PK,
+              class SliceSize,
+              class ContainerTraits,
+              class _LevelProperties>
+    struct util::coordinate_position_trait<levels::sell<std::tuple<LowerLevels...>,
+                                                        IK,
+                                                        PK,
+                                                        SliceSize,
+                                                        ContainerTraits,
+                                                        _LevelProperties>>
+    {
+        using Coordinate = IK;
+        using Position = PK;
+    };
+}  // namespace xsparse
+
+
+#endif
@@ -72,7 +72,7 @@ namespace xsparse
 
             singleton(IK size, CrdContainer&& crd)
                 : m_size(std::move(size))
-                , m_crd(crd)
+                , m_crd(std::move(crd))
             {
             }
 
@@ -96,6 +96,11 @@ namespace xsparse
                 return m_size;
             }
 
+            inline CrdContainer const& get_crd() const noexcept
+            {
+                return m_crd;
+            }
+
         private:
             IK m_size;
 
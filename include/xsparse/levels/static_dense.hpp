@@ -0,0 +1,134 @@
+#ifndef XSPARSE_LEVELS_STATIC_DENSE_HPP
+#define XSPARSE_LEVELS_STATIC_DENSE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <xsparse/util/base_traits.hpp>
+#include <xsparse/level_capabilities/coordinate_iterate.hpp>
+#include <xsparse/level_properties.hpp>
+
+namespace xsparse
+{
+    namespace levels
+    {
+        /**
+         * @brief A `dense` level whose size is known at compile time.
+         *
+         * @details Has the same interface as `dense`, but `coord_bounds` and `coord_access`
+         * only depend on the size through the template parameter, so that loops over the level
+         * (e.g. in `Tensor::for_each`) have a constant trip count and `pkm1 * N + ik` folds
+         * into the addressing. Meant for short inner dimensions, like the components of a
+         * point below a `compressed` level.
+         *
+         * @tparam Size - a `std::integral_constant` with the number of coordinates.
+         */
+        template <class LowerLevels,
+                  class IK,
+                  class PK,
+                  class Size,
+                  class _LevelProperties = level_properties<true, true, true, false, true>>
+        class static_dense;
+
+        template <class... LowerLevels, class IK, class PK, class Size, class _LevelProperties>
+        class static_dense<std::tuple<LowerLevels...>, IK, PK, Size, _LevelProperties>
+            : public level_capabilities::coordinate_value_iterate<static_dense,
+                                                                  std::tuple<LowerLevels...>,
+                                                                  IK,
+                                                                  PK,
+                                                                  Size,
+                                                                  _LevelProperties>
+
+        {
+            static_assert(_LevelProperties::is_full);
+            static_assert(!_LevelProperties::is_branchless);
+            static_assert(_LevelProperties::is_compact);
+            static_assert(_LevelProperties::is_ordered);
+            static_assert(Size::value > 0, "The level must hold at least one coordinate");
+
+        public:
+            using LevelCapabilities
+                = level_capabilities::coordinate_value_iterate<static_dense,
+                                                               std::tuple<LowerLevels...>,
+                                                               IK,
+                                                               PK,
+                                                               Size,
+                                                               _LevelProperties>;
+            using BaseTraits = util::base_traits<static_dense,
+                                                 std::tuple<LowerLevels...>,
+                                                 IK,
+                                                 PK,
+                                                 Size,
+                                                 _LevelProperties>;
+            using LevelProperties = _LevelProperties;
+
+            static constexpr IK SIZE = static_cast<IK>(Size::value);
+
+        public:
+            constexpr static_dense() noexcept = default;
+
+            explicit static_dense(IK size)
+            /**
+             * @brief Checks `size` against the compile-time size, for code that constructs
+             * all levels from their sizes.
+             */
+            {
+                if (size != SIZE)
+                {
+                    throw std::invalid_argument("size does not match the static size of the level");
+                }
+            }
+
+            inline constexpr std::pair<IK, IK> coord_bounds([[maybe_unused]]
+                                                            typename BaseTraits::I i) const noexcept
+            {
+                return { static_cast<IK>(0), SIZE };
+            }
+
+            inline constexpr std::optional<PK> coord_access(
+                typename BaseTraits::PKM1 pkm1,
+                [[maybe_unused]] typename BaseTraits::I i,
+                IK ik) const noexcept
+            {
+                return std::optional(static_cast<PK>(static_cast<PK>(pkm1) * static_cast<PK>(SIZE)
+                                                     + static_cast<PK>(ik)));
+            }
+
+            inline constexpr std::uint64_t word_access(
+                [[maybe_unused]] typename BaseTraits::PKM1 pkm1, std::size_t w) const noexcept
+            /**
+             * @brief The coordinates `[64 * w, 64 * (w + 1))` of a fiber as a bitset, which are
+             * all present up to the size of the level.
+             */
+            {
+                auto const remaining = static_cast<std::size_t>(SIZE) - 64 * w;
+                return remaining >= 64 ? ~std::uint64_t{ 0 }
+                                       : (std::uint64_t{ 1 } << remaining) - 1;
+            }
+
+            inline constexpr std::size_t size(std::size_t szkm1) const noexcept
+            {
+                return szkm1 * static_cast<std::size_t>(SIZE);
+            }
+
+            inline constexpr std::integral_constant<IK, SIZE> size() const noexcept
+            {
+                return {};
+            }
+        };
+    }
+
+    template <class... LowerLevels, class IK, class PK, class Size, class _LevelProperties>
+    struct util::coordinate_position_trait<
+        levels::static_dense<std::tuple<LowerLevels...>, IK, PK, Size, _LevelProperties>>
+    {
+        using Coordinate = IK;
+        using Position = PK;
+    };
+}
+
+#endif  // XSPARSE_LEVELS_STATIC_DENSE_HPP
@@ -0,0 +1,119 @@
+#ifndef XSPARSE_PARALLEL_HPP
+#define XSPARSE_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+namespace xsparse
+{
+    template <class... Levels, class Data, class F>
+    inline void parallel_for_each_nonzero(Tensor<std::tuple<Levels...>, Data> const& tensor,
+                                          F&& f,
+                                          util::work_stealing_pool& pool = util::default_pool())
+    /**
+     * @brief Calls `f(coords, value)` for every stored entry of `tensor`, in parallel.
+     *
+     * @details `coords` is a tuple with one coordinate per level, in level order, and `value`
+     * a reference to the entry of the tensor's data. The positions of the outermost level,
+     * which must be `dense` or `compressed`, are split into a few chunks per thread of `pool`.
+     * If the second level is `compressed`, its `pos` array is a prefix sum of the entries below
+     * every outer position, and the chunks are cut so that they hold about the same number of
+     * entries; otherwise they hold the same number of outer positions. The pool balances the
+     * remaining imbalance by work stealing, and the levels below the outermost one are
+     * traversed sequentially within each chunk.
+     *
+     * `f` is called concurrently from several threads, in no particular order.
+     */
+    {
+        using LevelsTuple = std::tuple<Levels...>;
+        using Outer = std::tuple_element_t<0, LevelsTuple>;
+        using OuterTraits = typename Outer::BaseTraits;
+        static_assert(util::is_specialization_of_v<Outer, levels::dense>
+                          || util::is_specialization_of_v<Outer, levels::compressed>,
+                      "The outermost level must be dense or compressed");
+
+        auto const levels = tensor.get_levels();
+        auto& data = tensor.get_data();
+        auto& outer = std::get<0>(levels);
+        typename OuterTraits::PKM1 const root{};
+
+        std::size_t pos_begin = 0;
+        std::size_t pos_end = 0;
+        if constexpr (util::is_specialization_of_v<Outer, levels::dense>)
+        {
+            pos_end = static_cast<std::size_t>(outer.size());
+        }
+        else
+        {
+            auto const [first, last] = outer.pos_bounds(root);
+            pos_begin = static_cast<std::size_t>(first);
+            pos_end = static_cast<std::size_t>(last);
+        }
+        if (pos_begin == pos_end)
+        {
+            return;
+        }
+
+        // a few chunks per thread give the pool something to steal
+        std::size_t const num_chunks = std::min(pos_end - pos_begin, 4 * pool.size());
+        std::vector<std::size_t> bounds(num_chunks + 1);
+        bounds[0] = pos_begin;
+        bounds[num_chunks] = pos_end;
+        for (std::size_t c = 1; c < num_chunks; ++c)
+        {
+            bounds[c] = pos_begin + c * (pos_end - pos_begin) / num_chunks;
+        }
+        if constexpr (sizeof...(Levels) > 1)
+        {
+            using Inner = std::tuple_element_t<1, LevelsTuple>;
+            if constexpr (util::is_specialization_of_v<Inner, levels::compressed>)
+            {
+                auto const& pos = std::get<1>(levels).get_pos();
+                auto const nnz_begin = static_cast<std::size_t>(pos[pos_begin]);
+                auto const nnz = static_cast<std::size_t>(pos[pos_end]) - nnz_begin;
+                for (std::size_t c = 1; c < num_chunks; ++c)
+                {
+                    auto const target = nnz_begin + c * nnz / num_chunks;
+                    auto const it = std::lower_bound(pos.begin() + pos_begin,
+                                                     pos.begin() + pos_end,
+                                                     target,
+                                                     [](auto const p, std::size_t const t)
+                                                     { return static_cast<std::size_t>(p) < t; });
+                    bounds[c] = static_cast<std::size_t>(it - pos.begin());
+                }
+            }
+        }
+
+        pool.parallel_for(
+            num_chunks,
+            [&](std::size_t c)
+            {
+                for (std::size_t p = bounds[c]; p < bounds[c + 1]; ++p)
+                {
+                    typename OuterTraits::IK ik;
+                    if constexpr (util::is_specialization_of_v<Outer, levels::dense>)
+                    {
+                        ik = static_cast<typename OuterTraits::IK>(p);
+                    }
+                    else
+                    {
+                        ik = outer.pos_access(static_cast<typename OuterTraits::PK>(p),
+                                              typename OuterTraits::I{});
+                    }
+                    detail::for_each_nonzero_below<1>(levels, data, f, p, ik);
+                }
+            });
+    }
+}
+
+#endif  // XSPARSE_PARALLEL_HPP
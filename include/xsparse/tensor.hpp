@@ -1,15 +1,108 @@
 #ifndef XSPARSE_TENSOR_HPP
 #define XSPARSE_TENSOR_HPP
 
+#include <cstddef>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <map>
 
 #include <xsparse/util/container_traits.hpp>
+#include <xsparse/level_capabilities/assembly.hpp>
+#include <xsparse/level_capabilities/coordinate_iterate.hpp>
 
 
 namespace xsparse
 {
+    namespace detail
+    {
+        template <class T, class = void>
+        struct has_pos_access : std::false_type
+        {
+        };
+
+        template <class T>
+        struct has_pos_access<T, std::void_t<decltype(&T::pos_access)>> : std::true_type
+        {
+        };
+
+        template <class I, class Coords, std::size_t... J>
+        inline I lower_coords(Coords const& coords,
+                              [[maybe_unused]] std::index_sequence<J...> j) noexcept
+        /**
+         * @brief The coordinates `I` of the levels above a level, nearest level first, out of
+         * the coordinates `coords` of the outer levels in level order.
+         */
+        {
+            constexpr std::size_t K = sizeof...(J);
+            return I(static_cast<std::tuple_element_t<J, I>>(std::get<K - 1 - J>(coords))...);
+        }
+
+        template <std::size_t K, class LevelsTuple, class Data, class F, class... IK>
+        inline void for_each_nonzero_below(LevelsTuple const& levels,
+                                           Data& data,
+                                           F& f,
+                                           std::size_t pkm1,
+                                           IK const... coords)
+        /**
+         * @brief Calls `f(coords, value)` for every nonzero below position `pkm1` of level
+         * `K - 1`, whose coordinates are `coords`, visiting the levels from `K` on in nested
+         * loops.
+         *
+         * @details The coordinates are passed down as scalars and only packed into a tuple for
+         * `f`. Levels with `coord_bounds`/`coord_access` (e.g. dense) loop over their
+         * coordinates and levels with `pos_bounds`/`pos_access` (e.g. compressed) over their
+         * positions directly, so that a CSR matrix is visited by the same two loops one would
+         * write by hand. Other levels are visited through their `iter_helper`.
+         */
+        {
+            if constexpr (K == std::tuple_size_v<LevelsTuple>)
+            {
+                f(std::tuple<IK...>(coords...), data[pkm1]);
+            }
+            else
+            {
+                auto& level = std::get<K>(levels);
+                using Level = std::remove_cv_t<std::remove_reference_t<decltype(level)>>;
+                using BaseTraits = typename Level::BaseTraits;
+                using PKM1 = typename BaseTraits::PKM1;
+                auto const i = lower_coords<typename BaseTraits::I>(
+                    std::forward_as_tuple(coords...), std::make_index_sequence<K>{});
+
+                if constexpr (has_coord_access_v<Level>)
+                {
+                    auto const [ik_begin, ik_end] = level.coord_bounds(i);
+                    for (auto ik = ik_begin; ik < ik_end; ++ik)
+                    {
+                        auto const pk = *level.coord_access(static_cast<PKM1>(pkm1), i, ik);
+                        for_each_nonzero_below<K + 1>(
+                            levels, data, f, static_cast<std::size_t>(pk), coords..., ik);
+                    }
+                }
+                else if constexpr (has_pos_access<Level>::value)
+                {
+                    constexpr auto stride = level_capabilities::pos_stride_v<Level>;
+                    auto const [pk_begin, pk_end] = level.pos_bounds(static_cast<PKM1>(pkm1));
+                    for (auto pk = pk_begin; pk < pk_end; pk += stride)
+                    {
+                        auto const ik = level.pos_access(pk, i);
+                        for_each_nonzero_below<K + 1>(
+                            levels, data, f, static_cast<std::size_t>(pk), coords..., ik);
+                    }
+                }
+                else
+                {
+                    for (auto const [ik, pk] : level.iter_helper(i, static_cast<PKM1>(pkm1)))
+                    {
+                        for_each_nonzero_below<K + 1>(
+                            levels, data, f, static_cast<std::size_t>(pk), coords..., ik);
+                    }
+                }
+            }
+        }
+    }
+
     /**
      * @brief A (sparse) tensor is a collection of levels.
      *
@@ -88,11 +181,41 @@ namespace xsparse
             return m_levelsTuple;
         }
 
-        // TODO: support just iterating through index
-        // e.g. if storage is (i, j, k) corresponding to (hashed, dense, compressed)
-        // we would iterate hashed, then dense, then compressed?
-        // we would iterate in a nested for loop (mainly think about what would be
-        // in operator++)
+        inline Data& get_data() const noexcept
+        {
+            return m_data;
+        }
+
+        template <class InputIt>
+        inline void assemble(InputIt first, InputIt last)
+        /**
+         * @brief Fill the empty levels and data of this tensor in a single pass.
+         *
+         * @details Each element of `[first, last)` is a `(coordinates..., value)` tuple. See
+         * `level_capabilities::Assemble` for the requirements on their order.
+         */
+        {
+            using Assembler = level_capabilities::Assemble<std::tuple<Levels...>, Data>;
+            auto assembler = std::apply([&](auto&... levels)
+                                        { return Assembler(levels..., m_data); },
+                                        m_levelsTuple);
+            assembler.append(first, last);
+            assembler.finalize();
+        }
+
+        template <class F>
+        inline void for_each(F&& f) const
+        /**
+         * @brief Calls `f(coords, value)` for every stored entry of this tensor, in storage
+         * order.
+         *
+         * @details `coords` is a tuple with one coordinate per level, in level order, and
+         * `value` a reference to the entry of the data. The levels are visited in one nested
+         * loop per level, which the compiler sees through completely.
+         */
+        {
+            detail::for_each_nonzero_below<0>(m_levelsTuple, m_data, f, 0);
+        }
     };
 }
 
@@ -0,0 +1,234 @@
+#ifndef XSPARSE_UTIL_MAPPED_VECTOR_HPP
+#define XSPARSE_UTIL_MAPPED_VECTOR_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace xsparse::util
+{
+    /**
+     * @brief A `Vec` for `container_traits` that can view memory it does not own, such as an
+     * array of a memory-mapped file.
+     *
+     * @details A view shares ownership of the memory through `keepalive`, so copying it is
+     * cheap and the memory stays valid for as long as any copy exists. Elements may be written
+     * in place, which for a privately mapped file only changes this process' copy of the page.
+     * Operations that change the size (`push_back`, `resize`, ...) first copy the elements into
+     * storage owned by the container, which from then on behaves like a `std::vector`.
+     */
+    template <class T>
+    class mapped_vector
+    {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = T const&;
+        using pointer = T*;
+        using const_pointer = T const*;
+        using iterator = T*;
+        using const_iterator = T const*;
+
+    private:
+        std::vector<T> m_owned;
+        std::shared_ptr<void const> m_keepalive;
+        T* m_data = nullptr;
+        size_type m_size = 0;
+
+        inline void sync() noexcept
+        {
+            m_data = m_owned.data();
+            m_size = m_owned.size();
+        }
+
+        inline void make_owned()
+        {
+            if (m_keepalive)
+            {
+                m_owned.assign(m_data, m_data + m_size);
+                m_keepalive.reset();
+                sync();
+            }
+        }
+
+    public:
+        mapped_vector() noexcept = default;
+
+        mapped_vector(std::initializer_list<T> init)
+            : m_owned(init)
+        {
+            sync();
+        }
+
+        explicit mapped_vector(size_type count, T const& value = T())
+            : m_owned(count, value)
+        {
+            sync();
+        }
+
+        mapped_vector(std::shared_ptr<void const> keepalive, T* data, size_type size) noexcept
+            : m_keepalive(std::move(keepalive))
+            , m_data(data)
+            , m_size(size)
+        /**
+         * @brief A view over `[data, data + size)`, which `keepalive` keeps valid.
+         */
+        {
+        }
+
+        mapped_vector(mapped_vector const& other)
+            : m_owned(other.m_owned)
+            , m_keepalive(other.m_keepalive)
+            , m_data(other.m_data)
+            , m_size(other.m_size)
+        {
+            if (!m_keepalive)
+            {
+                sync();
+            }
+        }
+
+        mapped_vector(mapped_vector&& other) noexcept
+            : m_owned(std::move(other.m_owned))
+            , m_keepalive(std::move(other.m_keepalive))
+            , m_data(std::exchange(other.m_data, nullptr))
+            , m_size(std::exchange(other.m_size, 0))
+        {
+            other.sync();
+        }
+
+        mapped_vector& operator=(mapped_vector other) noexcept
+        {
+            m_owned.swap(other.m_owned);
+            m_keepalive.swap(other.m_keepalive);
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            return *this;
+        }
+
+        inline bool is_mapped() const noexcept
+        {
+            return static_cast<bool>(m_keepalive);
+        }
+
+        inline T& operator[](size_type n) noexcept
+        {
+            return m_data[n];
+        }
+
+        inline T const& operator[](size_type n) const noexcept
+        {
+            return m_data[n];
+        }
+
+        inline T& at(size_type n)
+        {
+            if (n >= m_size)
+            {
+                throw std::out_of_range("mapped_vector index out of range");
+            }
+            return m_data[n];
+        }
+
+        inline T const& at(size_type n) const
+        {
+            if (n >= m_size)
+            {
+                throw std::out_of_range("mapped_vector index out of range");
+            }
+            return m_data[n];
+        }
+
+        inline T* data() noexcept
+        {
+            return m_data;
+        }
+
+        inline T const* data() const noexcept
+        {
+            return m_data;
+        }
+
+        inline size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        inline iterator begin() noexcept
+        {
+            return m_data;
+        }
+
+        inline const_iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        inline iterator end() noexcept
+        {
+            return m_data + m_size;
+        }
+
+        inline const_iterator end() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        inline T& back() noexcept
+        {
+            return m_data[m_size - 1];
+        }
+
+        inline T const& back() const noexcept
+        {
+            return m_data[m_size - 1];
+        }
+
+        inline void push_back(T const& value)
+        {
+            make_owned();
+            m_owned.push_back(value);
+            sync();
+        }
+
+        inline void resize(size_type count)
+        {
+            make_owned();
+            m_owned.resize(count);
+            sync();
+        }
+
+        inline void resize(size_type count, T const& value)
+        {
+            make_owned();
+            m_owned.resize(count, value);
+            sync();
+        }
+
+        inline void reserve(size_type capacity)
+        {
+            make_owned();
+            m_owned.reserve(capacity);
+            sync();
+        }
+
+        inline void clear() noexcept
+        {
+            m_owned.clear();
+            m_keepalive.reset();
+            sync();
+        }
+    };
+}
+
+#endif  // XSPARSE_UTIL_MAPPED_VECTOR_HPP
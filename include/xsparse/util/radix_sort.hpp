@@ -0,0 +1,101 @@
+#ifndef XSPARSE_UTIL_RADIX_SORT_HPP
+#define XSPARSE_UTIL_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xsparse/util/thread_pool.hpp>
+
+namespace xsparse::util
+{
+    template <class Key, class Payload>
+    inline void radix_sort(std::vector<Key>& keys,
+                           std::vector<Payload>& payload,
+                           unsigned low_bit,
+                           unsigned high_bit,
+                           work_stealing_pool& pool = default_pool())
+    /**
+     * @brief Sorts `keys`, which must all be less than `2^high_bit`, by their bits from
+     * `low_bit` on, and moves the element of `payload` at the same index along with every
+     * key. The sort is stable, so keys that only differ below `low_bit` keep their order.
+     *
+     * @details An LSD radix sort with 8-bit digits, so `(high_bit - low_bit) / 8` rounded up
+     * passes of a counting sort. Every pass splits the keys into a few chunks per thread of
+     * `pool`: each chunk counts its digits, the counts are turned into an offset per digit and
+     * chunk, and each chunk scatters its keys to their offsets in a second buffer. A pass
+     * whose digit is the same for every key is skipped. The buffers are swapped with `keys`
+     * and `payload` after every pass, so both end up sorted whatever the number of passes.
+     */
+    {
+        static_assert(std::is_unsigned_v<Key>, "Keys must be unsigned integers");
+        constexpr unsigned DIGIT_BITS = 8;
+        constexpr std::size_t RADIX = std::size_t{ 1 } << DIGIT_BITS;
+        // chunks smaller than this are not worth a task
+        constexpr std::size_t MIN_CHUNK = std::size_t{ 1 } << 14;
+
+        std::size_t const n = keys.size();
+        if (n < 2)
+        {
+            return;
+        }
+        std::size_t const num_chunks
+            = std::max<std::size_t>(1, std::min(n / MIN_CHUNK, 4 * pool.size()));
+        auto const chunk_begin = [&](std::size_t c) { return c * n / num_chunks; };
+
+        std::vector<Key> key_buffer(n);
+        std::vector<Payload> payload_buffer(n);
+        std::vector<std::size_t> counts(num_chunks * RADIX);
+        for (unsigned shift = low_bit; shift < high_bit; shift += DIGIT_BITS)
+        {
+            auto const digit = [shift](Key key) noexcept
+            { return static_cast<std::size_t>((key >> shift) & (RADIX - 1)); };
+
+            pool.parallel_for(num_chunks,
+                              [&](std::size_t c)
+                              {
+                                  auto* const count = counts.data() + c * RADIX;
+                                  std::fill(count, count + RADIX, std::size_t{ 0 });
+                                  for (auto i = chunk_begin(c); i < chunk_begin(c + 1); ++i)
+                                  {
+                                      ++count[digit(keys[i])];
+                                  }
+                              });
+
+            // the offsets are ordered by digit, then by chunk, which keeps the sort stable
+            bool single_digit = false;
+            std::size_t offset = 0;
+            for (std::size_t d = 0; d < RADIX; ++d)
+            {
+                auto const digit_begin = offset;
+                for (std::size_t c = 0; c < num_chunks; ++c)
+                {
+                    offset += std::exchange(counts[c * RADIX + d], offset);
+                }
+                single_digit = single_digit || offset - digit_begin == n;
+            }
+            if (single_digit)
+            {
+                continue;
+            }
+
+            pool.parallel_for(num_chunks,
+                              [&](std::size_t c)
+                              {
+                                  auto* const next = counts.data() + c * RADIX;
+                                  for (auto i = chunk_begin(c); i < chunk_begin(c + 1); ++i)
+                                  {
+                                      auto const o = next[digit(keys[i])]++;
+                                      key_buffer[o] = keys[i];
+                                      payload_buffer[o] = std::move(payload[i]);
+                                  }
+                              });
+            keys.swap(key_buffer);
+            payload.swap(payload_buffer);
+        }
+    }
+}
+
+#endif  // XSPARSE_UTIL_RADIX_SORT_HPP
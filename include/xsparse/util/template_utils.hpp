@@ -4,8 +4,10 @@
 
 #ifndef XSPARSE_TEMPLATE_UTILS_H
 #define XSPARSE_TEMPLATE_UTILS_H
+#include <cstddef>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace xsparse::util
 {
@@ -56,5 +58,44 @@ namespace xsparse::util
             static constexpr bool value = fn(std::tuple<std::integral_constant<bool, Args>...>{});
         };
     };
+
+    template <template <bool...> class F, std::size_t Mask, std::size_t... I>
+    constexpr bool evaluate_bool_mask([[maybe_unused]] std::index_sequence<I...> i)
+    {
+        return F<(((Mask >> I) & 1) == 1)...>::value;
+    }
+
+    template <template <bool...> class F, std::size_t N, std::size_t... Masks>
+    constexpr bool is_conjunction_helper([[maybe_unused]] std::index_sequence<Masks...> masks)
+    {
+        constexpr std::size_t all_set = (std::size_t{ 1 } << N) - 1;
+        return ((evaluate_bool_mask<F, Masks>(std::make_index_sequence<N>{}) == (Masks == all_set))
+                && ...);
+    }
+
+    /**
+     * @brief Whether the boolean function `F` of `N` arguments is a pure conjunction.
+     *
+     * @details Evaluates `F` over all `2^N` argument combinations at compile time. `F` is a
+     * pure conjunction if it is true only when every argument is true.
+     */
+    template <template <bool...> class F, std::size_t N>
+    inline constexpr bool is_conjunction_v
+        = is_conjunction_helper<F, N>(std::make_index_sequence<(std::size_t{ 1 } << N)>{});
+
+    template <template <bool...> class F, std::size_t N, std::size_t... Masks>
+    constexpr bool is_disjunction_helper([[maybe_unused]] std::index_sequence<Masks...> masks)
+    {
+        return ((evaluate_bool_mask<F, Masks>(std::make_index_sequence<N>{}) == (Masks != 0))
+                && ...);
+    }
+
+    /**
+     * @brief Whether the boolean function `F` of `N` arguments is a pure disjunction, i.e. true
+     * whenever any argument is true.
+     */
+    template <template <bool...> class F, std::size_t N>
+    inline constexpr bool is_disjunction_v
+        = is_disjunction_helper<F, N>(std::make_index_sequence<(std::size_t{ 1 } << N)>{});
 }
 #endif  // XSPARSE_TEMPLATE_UTILS_H
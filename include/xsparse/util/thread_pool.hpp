@@ -0,0 +1,237 @@
+#ifndef XSPARSE_UTIL_THREAD_POOL_HPP
+#define XSPARSE_UTIL_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace xsparse::util
+{
+    /**
+     * @brief A fixed set of worker threads that run batches of indexed tasks.
+     *
+     * @details `parallel_for` deals the tasks of a batch out to one queue per thread in
+     * contiguous blocks. Every thread takes tasks from the front of its own queue and, once it
+     * is empty, steals from the back of the others, so uneven tasks even out at run time. The
+     * calling thread works on the batch too, and batches are run one at a time.
+     */
+    class work_stealing_pool
+    {
+    private:
+        struct task_queue
+        {
+            std::mutex m_mutex;
+            std::deque<std::size_t> m_tasks;
+        };
+
+        std::vector<std::thread> m_threads;
+        std::vector<std::unique_ptr<task_queue>> m_queues;
+
+        std::mutex m_batch_mutex;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        std::size_t m_generation = 0;
+        bool m_stop = false;
+
+        std::function<void(std::size_t)> m_task;
+        std::atomic<std::size_t> m_remaining{ 0 };
+        std::exception_ptr m_exception;
+
+        static inline bool& in_worker() noexcept
+        {
+            static thread_local bool flag = false;
+            return flag;
+        }
+
+        inline std::optional<std::size_t> pop(std::size_t self) noexcept
+        {
+            {
+                auto& own = *m_queues[self];
+                std::lock_guard lock(own.m_mutex);
+                if (!own.m_tasks.empty())
+                {
+                    auto const task = own.m_tasks.front();
+                    own.m_tasks.pop_front();
+                    return task;
+                }
+            }
+
+            for (std::size_t k = 1; k < m_queues.size(); ++k)
+            {
+                auto& victim = *m_queues[(self + k) % m_queues.size()];
+                std::lock_guard lock(victim.m_mutex);
+                if (!victim.m_tasks.empty())
+                {
+                    auto const task = victim.m_tasks.back();
+                    victim.m_tasks.pop_back();
+                    return task;
+                }
+            }
+            return std::nullopt;
+        }
+
+        inline void run_tasks(std::size_t self)
+        {
+            while (auto const task = pop(self))
+            {
+                try
+                {
+                    m_task(*task);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(m_mutex);
+                    if (!m_exception)
+                    {
+                        m_exception = std::current_exception();
+                    }
+                }
+
+                if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_done.notify_all();
+                }
+            }
+        }
+
+        inline void worker(std::size_t self)
+        {
+            in_worker() = true;
+            std::size_t seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    seen = m_generation;
+                }
+                run_tasks(self);
+            }
+        }
+
+    public:
+        explicit inline work_stealing_pool(
+            std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency()))
+        /**
+         * @brief Start a pool in which `num_threads` threads, including the caller of
+         * `parallel_for`, run the tasks.
+         */
+        {
+            num_threads = std::max<std::size_t>(num_threads, 1);
+            for (std::size_t t = 0; t < num_threads; ++t)
+            {
+                m_queues.push_back(std::make_unique<task_queue>());
+            }
+            // queue 0 belongs to the thread calling `parallel_for`
+            for (std::size_t t = 1; t < num_threads; ++t)
+            {
+                m_threads.emplace_back([this, t] { worker(t); });
+            }
+        }
+
+        work_stealing_pool(work_stealing_pool const&) = delete;
+        work_stealing_pool& operator=(work_stealing_pool const&) = delete;
+
+        inline ~work_stealing_pool()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return m_queues.size();
+        }
+
+        template <class F>
+        inline void parallel_for(std::size_t num_tasks, F&& f)
+        /**
+         * @brief Run `f(task)` for every `task` in `[0, num_tasks)` and wait for all of them.
+         *
+         * @details The first exception thrown by a task is rethrown here, after the remaining
+         * tasks have run. Calls from inside a task run their tasks serially on that thread.
+         */
+        {
+            if (num_tasks == 0)
+            {
+                return;
+            }
+            if (in_worker() || size() == 1)
+            {
+                for (std::size_t task = 0; task < num_tasks; ++task)
+                {
+                    f(task);
+                }
+                return;
+            }
+
+            std::lock_guard batch(m_batch_mutex);
+            m_task = std::ref(f);
+            m_exception = nullptr;
+            m_remaining.store(num_tasks, std::memory_order_release);
+            for (std::size_t q = 0; q < size(); ++q)
+            {
+                auto& queue = *m_queues[q];
+                std::lock_guard lock(queue.m_mutex);
+                for (std::size_t task = q * num_tasks / size();
+                     task < (q + 1) * num_tasks / size();
+                     ++task)
+                {
+                    queue.m_tasks.push_back(task);
+                }
+            }
+            {
+                std::lock_guard lock(m_mutex);
+                ++m_generation;
+            }
+            m_wake.notify_all();
+
+            in_worker() = true;
+            run_tasks(0);
+            in_worker() = false;
+
+            std::unique_lock lock(m_mutex);
+            m_done.wait(lock,
+                        [&] { return m_remaining.load(std::memory_order_acquire) == 0; });
+            m_task = nullptr;
+            if (auto exception = std::exchange(m_exception, nullptr))
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+
+    inline work_stealing_pool& default_pool()
+    /**
+     * @brief A process-wide pool with one thread per hardware thread, started on first use.
+     */
+    {
+        static work_stealing_pool pool;
+        return pool;
+    }
+}
+
+#endif  // XSPARSE_UTIL_THREAD_POOL_HPP
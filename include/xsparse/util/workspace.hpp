@@ -0,0 +1,220 @@
+#ifndef XSPARSE_UTIL_WORKSPACE_HPP
+#define XSPARSE_UTIL_WORKSPACE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace xsparse::util
+{
+    /**
+     * @brief A dense array of values over the coordinates `[0, size)` that keeps the list of
+     * coordinates written since it was last cleared (a sparse accumulator).
+     *
+     * @details Kernels that scatter many fibers into one, like the rows of a sparse
+     * matrix-matrix product or a reduction over the output of `Coiterate`, accumulate into a
+     * workspace and read the result back as a sparse fiber. Writing a coordinate for the first
+     * time records it, so reading the fiber and clearing the workspace take time proportional
+     * to the coordinates written, not to `size`, and one allocation serves any number of
+     * fibers.
+     */
+    template <class IK, class V>
+    class workspace
+    {
+    private:
+        // the written coordinates are found by a scan rather than sorted once at least
+        // `size / SCAN_RATIO` of them are set
+        static constexpr std::size_t SCAN_RATIO = 16;
+
+        std::vector<V> m_values;
+        std::vector<std::uint8_t> m_occupied;
+        std::vector<IK> m_touched;
+
+    public:
+        using coordinate_type = IK;
+        using value_type = V;
+
+        workspace() noexcept = default;
+
+        explicit workspace(std::size_t size)
+            : m_values(size)
+            , m_occupied(size)
+        {
+        }
+
+        inline void resize(std::size_t size)
+        /**
+         * @brief Changes the number of coordinates and clears the workspace.
+         */
+        {
+            clear();
+            m_values.resize(size);
+            m_occupied.resize(size);
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return m_values.size();
+        }
+
+        inline std::size_t nnz() const noexcept
+        {
+            return m_touched.size();
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_touched.empty();
+        }
+
+        inline bool contains(IK ik) const noexcept
+        {
+            return m_occupied[static_cast<std::size_t>(ik)] != 0;
+        }
+
+        inline V& operator[](IK ik)
+        /**
+         * @brief The value at `ik`, which is value-initialized when it is first written.
+         */
+        {
+            auto const c = static_cast<std::size_t>(ik);
+            if (!m_occupied[c])
+            {
+                m_occupied[c] = 1;
+                m_values[c] = V{};
+                m_touched.push_back(ik);
+            }
+            return m_values[c];
+        }
+
+        inline void accumulate(IK ik, V const& value)
+        /**
+         * @brief Adds `value` to the value at `ik`.
+         */
+        {
+            auto const c = static_cast<std::size_t>(ik);
+            if (m_occupied[c])
+            {
+                m_values[c] += value;
+            }
+            else
+            {
+                m_occupied[c] = 1;
+                m_values[c] = value;
+                m_touched.push_back(ik);
+            }
+        }
+
+        template <class Range, class F>
+        inline void scatter(Range&& range, F&& value)
+        /**
+         * @brief Adds `value(e)` to the value at `std::get<0>(e)` for every element `e` of
+         * `range`.
+         *
+         * @details `range` is e.g. the `iter_helper` of a level, whose elements are
+         * `(ik, pk)`, or the `coiter_helper` of a `Coiterate`, whose elements are
+         * `(ik, tuple<optional<PK>...>)`.
+         */
+        {
+            for (auto const& e : range)
+            {
+                accumulate(static_cast<IK>(std::get<0>(e)), static_cast<V>(value(e)));
+            }
+        }
+
+        inline std::vector<IK> const& touched() const noexcept
+        /**
+         * @brief The written coordinates, in the order they were first written.
+         */
+        {
+            return m_touched;
+        }
+
+        template <class F>
+        inline void for_each(F&& f)
+        /**
+         * @brief Calls `f(ik, value)` for every written coordinate, in the order they were
+         * first written, with a reference to its value.
+         */
+        {
+            for (auto const ik : m_touched)
+            {
+                f(ik, m_values[static_cast<std::size_t>(ik)]);
+            }
+        }
+
+        template <class F>
+        inline void gather(F&& f)
+        /**
+         * @brief Calls `f(ik, value)` for every written coordinate in increasing order and
+         * clears the workspace.
+         *
+         * @details The written coordinates are sorted, unless so many are written that
+         * scanning all of them is cheaper.
+         */
+        {
+            if (m_touched.size() * SCAN_RATIO >= m_values.size())
+            {
+                for (std::size_t c = 0; c < m_values.size(); ++c)
+                {
+                    if (m_occupied[c])
+                    {
+                        f(static_cast<IK>(c), m_values[c]);
+                        m_occupied[c] = 0;
+                    }
+                }
+                m_touched.clear();
+                return;
+            }
+            std::sort(m_touched.begin(), m_touched.end());
+            for (auto const ik : m_touched)
+            {
+                f(ik, m_values[static_cast<std::size_t>(ik)]);
+            }
+            clear();
+        }
+
+        template <class Level, class PKM1, class Data>
+        inline void append(Level& level, PKM1 pkm1, Data& data)
+        /**
+         * @brief Appends the written coordinates in increasing order to `level` as the fiber
+         * below position `pkm1`, and their values to `data`, and clears the workspace.
+         *
+         * @details Follows the `append_*` protocol of `level_capabilities::Assemble`: `level`
+         * (e.g. `compressed`) receives `append_coord` for every coordinate and, if it has
+         * edges, `append_edges` for the fiber, between the `append_init` and
+         * `append_finalize` of the caller.
+         */
+        {
+            using PK = typename Level::BaseTraits::PK;
+            auto const pk_begin = static_cast<PK>(data.size());
+            gather(
+                [&](IK ik, V const& value)
+                {
+                    level.append_coord(ik);
+                    data.push_back(value);
+                });
+            if constexpr (requires { level.append_edges(pkm1, pk_begin, pk_begin); })
+            {
+                level.append_edges(pkm1, pk_begin, static_cast<PK>(data.size()));
+            }
+        }
+
+        inline void clear() noexcept
+        /**
+         * @brief Forgets the written coordinates, in time proportional to their number.
+         */
+        {
+            for (auto const ik : m_touched)
+            {
+                m_occupied[static_cast<std::size_t>(ik)] = 0;
+            }
+            m_touched.clear();
+        }
+    };
+}
+
+#endif  // XSPARSE_UTIL_WORKSPACE_HPP
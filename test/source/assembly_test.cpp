@@ -0,0 +1,177 @@
+#include <doctest/doctest.h>
+
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/level_capabilities/assembly.hpp>
+
+TEST_CASE("Assembly-CSR")
+{
+    constexpr uintptr_t SIZE1 = 4;
+    constexpr uintptr_t SIZE2 = 10;
+    constexpr uint8_t ZERO = 0;
+
+    // row 2 is empty, so its edges must still be recorded
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> const entries{
+        { 0, 1, 1.0 }, { 0, 7, 2.0 }, { 1, 3, 3.0 }, { 3, 0, 4.0 }, { 3, 4, 5.0 }, { 3, 9, 6.0 }
+    };
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ SIZE1 };
+    xsparse::levels::compressed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> c2{ SIZE2 };
+    std::vector<double> data;
+
+    xsparse::level_capabilities::Assemble<std::tuple<decltype(d1), decltype(c2)>, decltype(data)>
+        assemble(d1, c2, data);
+    assemble.append(entries.begin(), entries.end());
+    assemble.finalize();
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+    for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : c2.iter_helper(std::make_tuple(i1), p1))
+        {
+            result.emplace_back(i1, i2, data[p2]);
+        }
+    }
+    CHECK(result == entries);
+    CHECK(data.size() == entries.size());
+}
+
+TEST_CASE("Assembly-COO")
+{
+    constexpr uintptr_t SIZE = 100;
+    constexpr uint8_t ZERO = 0;
+
+    // the compressed level repeats coordinates because the singleton level below it is
+    // branchless
+    std::vector<std::tuple<uintptr_t, uintptr_t, int>> const entries{
+        { 0, 0, 1 }, { 0, 1, 2 }, { 1, 0, 3 }, { 1, 1, 4 }, { 3, 0, 5 }, { 3, 3, 6 }, { 3, 4, 7 }
+    };
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> c{ SIZE };
+    xsparse::levels::singleton<std::tuple<decltype(c)>, uintptr_t, uintptr_t> s{ SIZE };
+    std::vector<int> data;
+
+    xsparse::Tensor<std::tuple<decltype(c), decltype(s)>, decltype(data)> t(c, s, data);
+    t.assemble(entries.begin(), entries.end());
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, int>> result;
+    for (auto const [i1, p1] : c.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : s.iter_helper(std::make_tuple(i1), p1))
+        {
+            result.emplace_back(i1, i2, data[p2]);
+        }
+    }
+    CHECK(result == entries);
+}
+
+TEST_CASE("Assembly-DCSR")
+{
+    constexpr uintptr_t SIZE = 100;
+    constexpr uint8_t ZERO = 0;
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> const entries{
+        { 20, 20, 1.0 }, { 20, 50, 2.0 }, { 50, 30, 3.0 }, { 70, 10, 4.0 }, { 70, 90, 5.0 }
+    };
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> c1{ SIZE };
+    xsparse::levels::compressed<std::tuple<decltype(c1)>, uintptr_t, uintptr_t> c2{ SIZE };
+    std::vector<double> data;
+
+    xsparse::Tensor<std::tuple<decltype(c1), decltype(c2)>, decltype(data)> t(c1, c2, data);
+    t.assemble(entries.begin(), entries.end());
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+    uintptr_t num_rows = 0;
+    for (auto const [i1, p1] : c1.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : c2.iter_helper(std::make_tuple(i1), p1))
+        {
+            result.emplace_back(i1, i2, data[p2]);
+        }
+        ++num_rows;
+    }
+    CHECK(num_rows == 3);
+    CHECK(result == entries);
+}
+
+TEST_CASE("Assembly-Dense-Hashed-Unsorted")
+{
+    constexpr uintptr_t SIZE1 = 3;
+    constexpr uintptr_t SIZE2 = 10;
+
+    // hashed levels are inserted into, so the entries may come in any order, and a repeated
+    // coordinate overwrites the earlier value
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> const entries{
+        { 2, 5, 1.0 }, { 0, 3, 2.0 }, { 2, 1, 3.0 }, { 0, 9, 4.0 }, { 2, 5, 5.0 }
+    };
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ SIZE1 };
+    xsparse::levels::hashed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> h2{ SIZE2 };
+    std::vector<double> data;
+
+    xsparse::Tensor<std::tuple<decltype(d1), decltype(h2)>, decltype(data)> t(d1, h2, data);
+    t.assemble(entries.begin(), entries.end());
+
+    CHECK(data.size() == 4);
+    CHECK(data[h2.locate(2, 5).value()] == 5.0);
+    CHECK(data[h2.locate(0, 3).value()] == 2.0);
+    CHECK(data[h2.locate(2, 1).value()] == 3.0);
+    CHECK(data[h2.locate(0, 9).value()] == 4.0);
+    CHECK(!h2.locate(1, 5).has_value());
+}
+
+TEST_CASE("Assembly-Compressed-Dense")
+{
+    constexpr uintptr_t SIZE1 = 100;
+    constexpr uintptr_t SIZE2 = 3;
+
+    // the dense inner level stores every coordinate of a stored row, including zeros
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> const entries{
+        { 10, 0, 1.0 }, { 10, 2, 2.0 }, { 40, 1, 3.0 }
+    };
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> c1{ SIZE1 };
+    xsparse::levels::dense<std::tuple<decltype(c1)>, uintptr_t, uintptr_t> d2{ SIZE2 };
+    std::vector<double> data;
+
+    xsparse::Tensor<std::tuple<decltype(c1), decltype(d2)>, decltype(data)> t(c1, d2, data);
+    t.assemble(entries.begin(), entries.end());
+
+    CHECK(data == std::vector<double>{ 1.0, 0.0, 2.0, 0.0, 3.0, 0.0 });
+}
+
+TEST_CASE("Assembly-Unsorted-Throws")
+{
+    constexpr uintptr_t SIZE1 = 4;
+    constexpr uintptr_t SIZE2 = 10;
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ SIZE1 };
+    xsparse::levels::compressed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> c2{ SIZE2 };
+    std::vector<double> data;
+
+    xsparse::level_capabilities::Assemble<std::tuple<decltype(d1), decltype(c2)>, decltype(data)>
+        assemble(d1, c2, data);
+
+    SUBCASE("Unsorted-Within-Row")
+    {
+        assemble.append({ 1, 5 }, 1.0);
+        CHECK_THROWS_AS(assemble.append({ 1, 2 }, 2.0), std::invalid_argument);
+    }
+
+    SUBCASE("Unsorted-Rows")
+    {
+        assemble.append({ 2, 5 }, 1.0);
+        CHECK_THROWS_AS(assemble.append({ 1, 7 }, 2.0), std::invalid_argument);
+    }
+}
@@ -0,0 +1,309 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/offset.hpp>
+#include <xsparse/levels/range.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/util/mapped_vector.hpp>
+
+#include <xsparse/io/binary.hpp>
+
+namespace
+{
+    using mapped_traits = xsparse::util::
+        container_traits<xsparse::util::mapped_vector, std::unordered_set, std::unordered_map>;
+
+    std::string temp_path(std::string const& name)
+    {
+        return "xsparse_binary_test_" + name + ".bin";
+    }
+}
+
+TEST_CASE("Binary-CSR-RoundTrip")
+{
+    constexpr uint8_t ZERO = 0;
+    std::string const path = temp_path("csr");
+
+    std::vector<uintptr_t> const pos{ 0, 2, 3, 3, 6 };
+    std::vector<uintptr_t> const crd{ 1, 7, 3, 0, 4, 9 };
+    std::vector<double> data{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ 4 };
+    xsparse::levels::compressed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> c2{ 10, pos, crd };
+    xsparse::Tensor<std::tuple<decltype(d1), decltype(c2)>, decltype(data)> t(d1, c2, data);
+    xsparse::io::save(path, t);
+
+    SUBCASE("Mapped")
+    {
+        using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+        using compressed_t
+            = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t, mapped_traits>;
+        auto loaded = xsparse::io::
+            load<std::tuple<dense_t, compressed_t>, xsparse::util::mapped_vector<double>>(path);
+        auto& [l1, l2] = loaded.levels;
+
+        // the arrays are views into the file, aligned for SIMD loads
+        CHECK(l2.get_pos().is_mapped());
+        CHECK(l2.get_crd().is_mapped());
+        CHECK(loaded.data.is_mapped());
+        CHECK(reinterpret_cast<uintptr_t>(l2.get_crd().data()) % xsparse::io::ALIGNMENT == 0);
+        CHECK(reinterpret_cast<uintptr_t>(loaded.data.data()) % xsparse::io::ALIGNMENT == 0);
+
+        CHECK(loaded.tensor().shape() == std::make_tuple(uintptr_t(4), uintptr_t(10)));
+        std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+        for (auto const [i1, p1] : l1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : l2.iter_helper(std::make_tuple(i1), p1))
+            {
+                result.emplace_back(i1, i2, loaded.data[p2]);
+            }
+        }
+        std::vector<std::tuple<uintptr_t, uintptr_t, double>> const expected{
+            { 0, 1, 1.0 }, { 0, 7, 2.0 }, { 1, 3, 3.0 }, { 3, 0, 4.0 }, { 3, 4, 5.0 }, { 3, 9, 6.0 }
+        };
+        CHECK(result == expected);
+
+        // writes stay private to the mapping, and growing copies the array out of it
+        loaded.data[0] = 10.0;
+        loaded.data.push_back(7.0);
+        CHECK(!loaded.data.is_mapped());
+        CHECK(loaded.data.size() == 7);
+        CHECK(loaded.data[0] == 10.0);
+        auto reloaded
+            = xsparse::io::load<std::tuple<dense_t, compressed_t>, std::vector<double>>(path);
+        CHECK(reloaded.data == data);
+    }
+
+    SUBCASE("Copied")
+    {
+        auto loaded
+            = xsparse::io::load<std::tuple<decltype(d1), decltype(c2)>, std::vector<double>>(path);
+        CHECK(std::get<1>(loaded.levels).get_pos() == pos);
+        CHECK(std::get<1>(loaded.levels).get_crd() == crd);
+        CHECK(loaded.data == data);
+    }
+
+    SUBCASE("Mismatched-Types")
+    {
+        using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+        using narrow_t = xsparse::levels::compressed<std::tuple<dense_t>, uint32_t, uint32_t>;
+        using singleton_t = xsparse::levels::singleton<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+        CHECK_THROWS_AS(
+            (xsparse::io::load<std::tuple<dense_t, narrow_t>, std::vector<double>>(path)),
+            std::runtime_error);
+        CHECK_THROWS_AS(
+            (xsparse::io::load<std::tuple<dense_t, singleton_t>, std::vector<double>>(path)),
+            std::runtime_error);
+        CHECK_THROWS_AS((xsparse::io::load<std::tuple<dense_t>, std::vector<double>>(path)),
+                        std::runtime_error);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary-DIA-RoundTrip")
+{
+    constexpr uint8_t ZERO = 0;
+    constexpr uintptr_t SIZE = 4;
+    std::string const path = temp_path("dia");
+
+    std::vector<int32_t> const offsets{ -1, 0, 2 };
+    std::vector<int> data(offsets.size() * SIZE);
+    for (std::size_t p = 0; p < data.size(); ++p)
+    {
+        data[p] = static_cast<int>(p);
+    }
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ offsets.size() };
+    xsparse::levels::range<std::tuple<decltype(d1)>, uintptr_t, int32_t> r2{ SIZE, SIZE, offsets };
+    xsparse::levels::offset<std::tuple<decltype(r2), decltype(d1)>, uintptr_t, int32_t> o3{
+        SIZE, offsets
+    };
+    xsparse::io::save(path,
+                      xsparse::Tensor<std::tuple<decltype(d1), decltype(r2), decltype(o3)>,
+                                      decltype(data)>(d1, r2, o3, data));
+
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using range_t = xsparse::levels::
+        range<std::tuple<dense_t>, uintptr_t, int32_t, mapped_traits>;
+    auto loaded = xsparse::io::load<std::tuple<dense_t, range_t, decltype(o3)>,
+                                    xsparse::util::mapped_vector<int>>(path);
+    auto& [l1, l2, l3] = loaded.levels;
+    CHECK(l2.get_size_M() == SIZE);
+
+    auto collect = [](auto& a, auto& b, auto& c)
+    {
+        std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t, int32_t>> entries;
+        for (auto const [i1, p1] : a.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : b.iter_helper(std::make_tuple(i1), p1))
+            {
+                for (auto const [i3, p3] : c.iter_helper(std::make_tuple(i2, i1), p2))
+                {
+                    entries.emplace_back(i1, i2, i3, p3);
+                }
+            }
+        }
+        return entries;
+    };
+    CHECK(collect(l1, l2, l3) == collect(d1, r2, o3));
+    CHECK(std::equal(data.begin(), data.end(), loaded.data.begin(), loaded.data.end()));
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary-Invalid-File")
+{
+    std::string const path = temp_path("invalid");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "this is not an xsparse tensor, although it is long enough for the header";
+    }
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    CHECK_THROWS_AS((xsparse::io::load<std::tuple<dense_t>, std::vector<double>>(path)),
+                    std::runtime_error);
+    CHECK_THROWS_AS(
+        (xsparse::io::load<std::tuple<dense_t>, std::vector<double>>(temp_path("missing"))),
+        std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary-Corrupt-Tables")
+{
+    // a valid CSR file with one field of its header or tables overwritten at a time
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using compressed_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using levels_t = std::tuple<dense_t, compressed_t>;
+    std::string const path = temp_path("corrupt");
+
+    std::vector<double> data{ 1.0, 2.0, 3.0 };
+    dense_t d1{ 2 };
+    compressed_t c2{ 4, { 0, 2, 3 }, { 0, 3, 1 } };
+    xsparse::io::save(path, xsparse::Tensor<levels_t, std::vector<double>>(d1, c2, data));
+    std::vector<char> original;
+    {
+        std::ifstream in(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    CHECK_NOTHROW((xsparse::io::load<levels_t, std::vector<double>>(path)));
+
+    auto const overwrite = [&](std::size_t offset, auto value)
+    {
+        auto bytes = original;
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    auto const level_field = [](std::size_t k, std::size_t field)
+    { return sizeof(xsparse::io::file_header) + k * sizeof(xsparse::io::level_record) + field; };
+    auto const array_field = [](std::size_t a, std::size_t field)
+    {
+        return sizeof(xsparse::io::file_header) + 2 * sizeof(xsparse::io::level_record)
+               + a * sizeof(xsparse::io::array_record) + field;
+    };
+
+    SUBCASE("Level-Table-Past-End")
+    {
+        overwrite(offsetof(xsparse::io::file_header, level_table_offset),
+                  static_cast<uint64_t>(original.size() - 16));
+    }
+    SUBCASE("No-Arrays")
+    {
+        overwrite(offsetof(xsparse::io::file_header, num_arrays), uint64_t{ 0 });
+    }
+    SUBCASE("Array-Table-Overflow")
+    {
+        overwrite(offsetof(xsparse::io::file_header, num_arrays), uint64_t{ 1 } << 59);
+    }
+    SUBCASE("Array-Count-Overflow")
+    {
+        // `offset + count * element_size` wraps around to a small value
+        overwrite(array_field(1, offsetof(xsparse::io::array_record, count)),
+                  (uint64_t{ 1 } << 61) + 1);
+    }
+    SUBCASE("First-Array-Past-End")
+    {
+        overwrite(level_field(1, offsetof(xsparse::io::level_record, first_array)), uint64_t{ 2 });
+    }
+    SUBCASE("Missing-Arrays")
+    {
+        overwrite(level_field(1, offsetof(xsparse::io::level_record, num_arrays)), uint32_t{ 1 });
+    }
+    CHECK_THROWS_AS((xsparse::io::load<levels_t, std::vector<double>>(path)), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary-Corrupt-Arrays")
+{
+    // a valid CSR file with one element of its `pos` or `crd` array overwritten at a time
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using compressed_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using levels_t = std::tuple<dense_t, compressed_t>;
+    std::string const path = temp_path("corrupt_arrays");
+
+    std::vector<double> data{ 1.0, 2.0, 3.0 };
+    dense_t d1{ 2 };
+    compressed_t c2{ 4, { 0, 2, 3 }, { 0, 3, 1 } };
+    xsparse::io::save(path, xsparse::Tensor<levels_t, std::vector<double>>(d1, c2, data));
+    std::vector<char> original;
+    {
+        std::ifstream in(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    auto const overwrite = [&](std::size_t a, std::size_t n, uintptr_t value)
+    {
+        xsparse::io::array_record record;
+        std::memcpy(&record,
+                    original.data() + sizeof(xsparse::io::file_header)
+                        + 2 * sizeof(xsparse::io::level_record)
+                        + a * sizeof(xsparse::io::array_record),
+                    sizeof(record));
+        auto bytes = original;
+        std::memcpy(bytes.data() + record.offset + n * sizeof(value), &value, sizeof(value));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    auto const load = [&](bool trusted)
+    { return xsparse::io::load<levels_t, std::vector<double>>(path, trusted); };
+
+    SUBCASE("Pos-Not-From-Zero")
+    {
+        overwrite(0, 0, 1);
+        CHECK_THROWS_AS(load(false), std::runtime_error);
+    }
+    SUBCASE("Pos-Decreasing")
+    {
+        overwrite(0, 1, 4);
+        CHECK_THROWS_AS(load(false), std::runtime_error);
+    }
+    SUBCASE("Pos-Past-Crd")
+    {
+        overwrite(0, 2, 4);
+        CHECK_THROWS_AS(load(false), std::runtime_error);
+    }
+    SUBCASE("Crd-Out-Of-Range")
+    {
+        overwrite(1, 1, 4);
+        CHECK_THROWS_AS(load(false), std::runtime_error);
+        // a trusted file is not read before it is used
+        CHECK_NOTHROW(load(true));
+    }
+
+    std::remove(path.c_str());
+}
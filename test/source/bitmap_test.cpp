@@ -0,0 +1,205 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/bitmap.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/level_capabilities/assembly.hpp>
+#include <xsparse/level_capabilities/co_iteration.hpp>
+
+namespace
+{
+    constexpr uintptr_t ROWS = 4;
+    constexpr uintptr_t COLS = 150;
+
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using bitmap_t = xsparse::levels::bitmap<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+
+    // rows across three words: every third column, an empty row, a few columns at word
+    // boundaries, and every column
+    struct csr_matrix
+    {
+        std::vector<uintptr_t> pos{ 0 };
+        std::vector<uintptr_t> crd;
+
+        csr_matrix()
+        {
+            for (uintptr_t c = 0; c < COLS; c += 3)
+            {
+                crd.push_back(c);
+            }
+            pos.push_back(crd.size());
+            pos.push_back(crd.size());
+            for (uintptr_t c : { 0, 63, 64, 127, 128, 149 })
+            {
+                crd.push_back(c);
+            }
+            pos.push_back(crd.size());
+            for (uintptr_t c = 0; c < COLS; ++c)
+            {
+                crd.push_back(c);
+            }
+            pos.push_back(crd.size());
+        }
+    };
+}
+
+TEST_CASE("Bitmap-BaseCase")
+{
+    constexpr uint8_t ZERO = 0;
+    csr_matrix const m;
+    dense_t d{ ROWS };
+    csr_t c{ COLS, m.pos, m.crd };
+    bitmap_t b{ COLS, m.pos, m.crd };
+
+    CHECK(b.size() == COLS);
+    CHECK(b.word_bounds(2) == std::make_pair(std::size_t{ 6 }, std::size_t{ 9 }));
+    CHECK(b.get_rank().back() == m.crd.size());
+
+    // the same coordinates and positions as the compressed level
+    for (auto const [i1, p1] : d.iter_helper(std::make_tuple(), ZERO))
+    {
+        std::vector<std::pair<uintptr_t, uintptr_t>> expected, result;
+        for (auto const [i2, p2] : c.iter_helper(std::make_tuple(i1), p1))
+        {
+            expected.emplace_back(i2, p2);
+        }
+        auto const helper = b.iter_helper(std::make_tuple(i1), p1);
+        for (auto const [i2, p2] : helper)
+        {
+            result.emplace_back(i2, p2);
+        }
+        CHECK(result == expected);
+        CHECK(helper.end() - helper.begin() == static_cast<std::ptrdiff_t>(expected.size()));
+
+        // and backwards
+        std::vector<std::pair<uintptr_t, uintptr_t>> reversed;
+        for (auto it = helper.end(); it != helper.begin();)
+        {
+            --it;
+            auto const [i2, p2] = *it;
+            reversed.emplace_back(i2, p2);
+        }
+        std::reverse(reversed.begin(), reversed.end());
+        CHECK(reversed == expected);
+    }
+
+    // `locate` is a rank query
+    for (uintptr_t r = 0; r < ROWS; ++r)
+    {
+        for (uintptr_t col = 0; col < COLS; ++col)
+        {
+            auto const first = m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[r]);
+            auto const last = m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[r + 1]);
+            auto const it = std::lower_bound(first, last, col);
+            std::optional<uintptr_t> expected;
+            if (it != last && *it == col)
+            {
+                expected = static_cast<uintptr_t>(it - m.crd.begin());
+            }
+            CHECK(b.locate(r, col) == expected);
+        }
+    }
+}
+
+TEST_CASE("Bitmap-Seek-Advance")
+{
+    csr_matrix const m;
+    bitmap_t b{ COLS, m.pos, m.crd };
+
+    auto const helper = b.iter_helper(std::make_tuple(uintptr_t{ 2 }), uintptr_t{ 2 });
+    auto it = helper.begin();
+    it.seek(1);
+    CHECK(std::get<0>(*it) == 63);
+    it.seek(63);
+    CHECK(std::get<0>(*it) == 63);
+    it.seek(65);
+    CHECK(std::get<0>(*it) == 127);
+    it.seek(129);
+    CHECK(std::get<0>(*it) == 149);
+    it.seek(150);
+    CHECK(it == helper.end());
+
+    // advancing by a count skips whole words
+    auto const full = b.iter_helper(std::make_tuple(uintptr_t{ 3 }), uintptr_t{ 3 });
+    auto jt = full.begin();
+    jt += 100;
+    CHECK(std::get<0>(*jt) == 100);
+    jt += full.end() - jt;
+    CHECK(jt == full.end());
+
+    auto const empty = b.iter_helper(std::make_tuple(uintptr_t{ 1 }), uintptr_t{ 1 });
+    CHECK(empty.begin() == empty.end());
+}
+
+TEST_CASE("Bitmap-Coiterate")
+{
+    csr_matrix const m;
+    bitmap_t b{ COLS, m.pos, m.crd };
+    csr_t c{ COLS, m.pos, m.crd };
+
+    // intersecting row 0 (every third column) with row 2 (columns at word boundaries)
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) && std::get<1>(t); };
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<bitmap_t, csr_t>,
+        std::tuple<uintptr_t>,
+        std::tuple<uintptr_t, uintptr_t>>
+        coiter(fn, b, c);
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t>> result;
+    for (auto const [ik, pk_tuple] : coiter.coiter_helper(
+             std::make_tuple(uintptr_t{ 0 }), std::make_tuple(uintptr_t{ 0 }, uintptr_t{ 2 })))
+    {
+        result.emplace_back(ik, *std::get<0>(pk_tuple), *std::get<1>(pk_tuple));
+    }
+    std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t>> const expected{ { 0, 0, 50 },
+                                                                               { 63, 21, 51 } };
+    CHECK(result == expected);
+}
+
+TEST_CASE("Bitmap-Assembly")
+{
+    constexpr uint8_t ZERO = 0;
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> const entries{
+        { 0, 1, 1.0 }, { 0, 70, 2.0 }, { 1, 3, 3.0 }, { 3, 0, 4.0 }, { 3, 64, 5.0 }, { 3, 149, 6.0 }
+    };
+
+    dense_t d1{ ROWS };
+    bitmap_t b2{ COLS };
+    std::vector<double> data;
+    xsparse::level_capabilities::Assemble<std::tuple<dense_t, bitmap_t>, decltype(data)> assemble(
+        d1, b2, data);
+    assemble.append(entries.begin(), entries.end());
+    assemble.finalize();
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+    for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : b2.iter_helper(std::make_tuple(i1), p1))
+        {
+            result.emplace_back(i1, i2, data[p2]);
+        }
+    }
+    CHECK(result == entries);
+
+    xsparse::Tensor<std::tuple<dense_t, bitmap_t>, std::vector<double>> A(d1, b2, data);
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> visited;
+    A.for_each([&](auto const& ij, double v)
+               { visited.emplace_back(std::get<0>(ij), std::get<1>(ij), v); });
+    CHECK(visited == entries);
+}
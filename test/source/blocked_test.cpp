@@ -0,0 +1,109 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <xsparse/levels/blocked.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/kernels/spmv.hpp>
+
+namespace
+{
+    constexpr uintptr_t B = 3;
+
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using blocked_t = xsparse::levels::
+        blocked<std::tuple<dense_t>, uintptr_t, uintptr_t, std::integral_constant<std::size_t, B>>;
+    using inner_t = xsparse::levels::dense<std::tuple<blocked_t, dense_t>, uintptr_t, uintptr_t>;
+
+    // a 6 x 9 matrix of 3 x 3 blocks, with blocks at block coordinates (0, 0), (0, 2) and (1, 1)
+    std::vector<uintptr_t> const pos{ 0, 2, 3 };
+    std::vector<uintptr_t> const crd{ 0, 2, 1 };
+
+    std::vector<double> block_data()
+    {
+        // block `b` holds its element (r, c) at `9 * b + 3 * c + r`
+        std::vector<double> data(3 * B * B);
+        for (std::size_t p = 0; p < data.size(); ++p)
+        {
+            data[p] = static_cast<double>(p + 1);
+        }
+        return data;
+    }
+}
+
+TEST_CASE("Blocked-BaseCase")
+{
+    constexpr uint8_t ZERO = 0;
+    dense_t d{ 2 };
+    blocked_t b{ 9, pos, crd };
+
+    static_assert(blocked_t::BLOCK_SIZE == B);
+    CHECK(b.size() == 9);
+
+    // every tile of the first block row expands to three consecutive coordinates
+    std::vector<std::pair<uintptr_t, uintptr_t>> result;
+    for (auto const [ik, pk] : b.iter_helper(std::make_tuple(uintptr_t{ 0 }), ZERO))
+    {
+        result.emplace_back(ik, pk);
+    }
+    std::vector<std::pair<uintptr_t, uintptr_t>> const expected{
+        { 0, 0 }, { 1, 1 }, { 2, 2 }, { 6, 3 }, { 7, 4 }, { 8, 5 }
+    };
+    CHECK(result == expected);
+
+    CHECK(b.block_bounds(1) == std::make_pair(uintptr_t{ 2 }, uintptr_t{ 3 }));
+    CHECK(b.block_access(2) == 3);
+
+    // a seek skips to the tile holding the coordinate
+    auto const helper = b.iter_helper(std::make_tuple(uintptr_t{ 0 }), ZERO);
+    auto it = helper.begin();
+    it.seek(4);
+    CHECK(std::get<0>(*it) == 6);
+}
+
+TEST_CASE("Blocked-BCSR")
+{
+    dense_t d{ 2 };
+    blocked_t b{ 9, pos, crd };
+    inner_t r{ B };
+    auto data = block_data();
+    xsparse::Tensor<std::tuple<dense_t, blocked_t, inner_t>, decltype(data)> A(d, b, r, data);
+
+    // the matrix as dense rows, from the coordinates visited by `for_each`
+    std::vector<std::vector<double>> dense(6, std::vector<double>(9, 0.0));
+    A.for_each([&](auto const& coords, double const value)
+               {
+                   auto const [block_row, col, row] = coords;
+                   dense[block_row * B + row][col] = value;
+               });
+    CHECK(dense[0][0] == 1.0);
+    CHECK(dense[1][0] == 2.0);
+    CHECK(dense[0][1] == 4.0);
+    CHECK(dense[2][8] == 18.0);
+    CHECK(dense[3][3] == 19.0);
+    CHECK(dense[5][5] == 27.0);
+    CHECK(dense[3][0] == 0.0);
+
+    std::vector<double> x(9);
+    for (std::size_t c = 0; c < x.size(); ++c)
+    {
+        x[c] = static_cast<double>(c) - 4.0;
+    }
+    std::vector<double> y(6);
+    xsparse::kernels::spmv(A, x, y);
+    for (std::size_t row = 0; row < 6; ++row)
+    {
+        double expected = 0.0;
+        for (std::size_t c = 0; c < 9; ++c)
+        {
+            expected += dense[row][c] * x[c];
+        }
+        CHECK(y[row] == expected);
+    }
+}
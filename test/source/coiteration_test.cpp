@@ -1,5 +1,7 @@
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <iterator>
 #include <tuple>
 #include <vector>
 #include <functional>
@@ -8,6 +10,7 @@
 #include <map>
 #include <set>
 
+#include <xsparse/levels/bitmap.hpp>
 #include <xsparse/levels/compressed.hpp>
 #include <xsparse/levels/dense.hpp>
 #include <xsparse/levels/singleton.hpp>
@@ -216,6 +219,8 @@ TEST_CASE("Coiteration-Dense-Hashed-ConjunctiveMerge")
      * - If one of the levels is unordered (e.g. hashed, or singleton), then the
      * coiteration is done by iterating over the ordered level, and then looking up
      * the corresponding value in the unordered level.
+     * - Indices that are missing from the unordered level are skipped, since the
+     * conjunction is false there.
      * - The coiteration stops when the end of the ordered (i.e. dense) level is reached.
      *
      * This test checks that the lookup is done correctly.
@@ -269,44 +274,33 @@ TEST_CASE("Coiteration-Dense-Hashed-ConjunctiveMerge")
 
     // when co-iterating over levels that are unordered (i.e. hashed), then we use locate to
     // check if the index exists in the hashed level. If not, then we skip it.
+    uintptr_t num_coiterated = 0;
     for (auto const [ik, pk_tuple] :
          coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
     {
+        // advance the dense level past the indices that the hashed level does not have
+        while (it1 != end1 && std::get<0>(*it1) < ik)
+        {
+            ++it1;
+        }
+        REQUIRE(it1 != end1);
+
         // get the index and pointer from the levels involved in co-iteration
         auto [i1, p1] = *it1;
+        CHECK(ik == i1);
+        CHECK(p1 == std::get<0>(pk_tuple).value());
 
-        // should only iterate over the ordered dense level
-        uintptr_t l = i1;
-        CHECK(ik == l);
-
-        // check that the dense level has not reached the end
-        if (it1 != end1)
-        {
-            // if both levels have a non-zero value at index "i1", then those values
-            // should be present in the co-iterated tuple
-            if (i1 == l)
-            {
-                CHECK(p1 == std::get<0>(pk_tuple).value());
-            }
-
-            // check that the pk_tuple has the correct values when hash level has a value
-            auto hash_level_pk = hash_level.locate(0, i1);
-            if (hash_level_pk.has_value())
-            {
-                CHECK(hash_level_pk == std::get<1>(pk_tuple).value());
-            }
-            else
-            {
-                CHECK(hash_level_pk.has_value() == false);
-            }
+        // the hashed level must have a value at every co-iterated index
+        auto hash_level_pk = hash_level.locate(0, i1);
+        CHECK(hash_level_pk.has_value());
+        CHECK(hash_level_pk == std::get<1>(pk_tuple));
 
-            // increment through the dense level always
-            ++it1;
-        }
+        ++it1;
+        ++num_coiterated;
     }
 
-    // check that the dense level should've reached its end
-    CHECK((it1 == end1) == true);
+    // exactly the indices of the hashed level should have been visited
+    CHECK(num_coiterated == umap1.size());
 }
 
 
@@ -458,4 +452,299 @@ TEST_CASE("Coiteration-Nested-Levels")
     // check that the dense levelS should've reached its end
     CHECK((it1 == end1) == true);
     CHECK((it2 == end2) == true);
-}
\ No newline at end of file
+}
+TEST_CASE("Coiteration-Compressed-Compressed-ConjunctiveMerge")
+{
+    // the conjunctive merge should yield exactly the intersection of the two fibers, even
+    // when their supports differ in size and one is exhausted well before the other
+    constexpr uintptr_t SIZE = 1000;
+    constexpr uint8_t ZERO = 0;
+
+    std::vector<uintptr_t> const crd1{ 3, 17, 40, 41, 42, 300, 512, 999 };
+    std::vector<uintptr_t> crd2;
+    for (uintptr_t i = 0; i < 600; i += 3)
+    {
+        crd2.push_back(i);
+    }
+    std::vector<uintptr_t> const pos1{ 0, crd1.size() };
+    std::vector<uintptr_t> const pos2{ 0, crd2.size() };
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> s1{ SIZE, pos1, crd1 };
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> s2{ SIZE, pos2, crd2 };
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d{ SIZE };
+
+    std::vector<uintptr_t> expected;
+    std::set_intersection(
+        crd1.begin(), crd1.end(), crd2.begin(), crd2.end(), std::back_inserter(expected));
+
+    SUBCASE("Compressed-Compressed")
+    {
+        auto fn = [](std::tuple<bool, bool> t) constexpr
+        { return std::get<0>(t) && std::get<1>(t); };
+
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uintptr_t,
+            uintptr_t,
+            std::tuple<decltype(s1), decltype(s2)>,
+            std::tuple<>,
+            std::tuple<uintptr_t, uintptr_t>>
+            coiter(fn, s1, s2);
+
+        std::vector<uintptr_t> result;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+        {
+            CHECK(crd1[std::get<0>(pk_tuple).value()] == ik);
+            CHECK(crd2[std::get<1>(pk_tuple).value()] == ik);
+            result.push_back(ik);
+        }
+        CHECK(result == expected);
+    }
+
+    SUBCASE("Dense-Compressed-Compressed")
+    {
+        auto fn = [](std::tuple<bool, bool, bool> t) constexpr
+        { return std::get<0>(t) && std::get<1>(t) && std::get<2>(t); };
+
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uintptr_t,
+            uintptr_t,
+            std::tuple<decltype(d), decltype(s2), decltype(s1)>,
+            std::tuple<>,
+            std::tuple<uintptr_t, uintptr_t, uintptr_t>>
+            coiter(fn, d, s2, s1);
+
+        std::vector<uintptr_t> result;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO, ZERO)))
+        {
+            CHECK(std::get<0>(pk_tuple).value() == ik);
+            CHECK(crd2[std::get<1>(pk_tuple).value()] == ik);
+            CHECK(crd1[std::get<2>(pk_tuple).value()] == ik);
+            result.push_back(ik);
+        }
+        CHECK(result == expected);
+    }
+
+    // only pure conjunctions take the intersecting path
+    auto conjunction = [](std::tuple<bool, bool> t) constexpr
+    { return std::get<0>(t) && std::get<1>(t); };
+    auto disjunction = [](std::tuple<bool, bool> t) constexpr
+    { return std::get<0>(t) || std::get<1>(t); };
+    static_assert(xsparse::util::is_conjunction_v<
+                  xsparse::util::LambdaWrapper<decltype(conjunction)>::template apply,
+                  2>);
+    static_assert(!xsparse::util::is_conjunction_v<
+                  xsparse::util::LambdaWrapper<decltype(disjunction)>::template apply,
+                  2>);
+}
+
+TEST_CASE("Coiteration-Dense-Compressed-Hashed-ConjunctiveMerge")
+{
+    // the sparse compressed level leads the conjunctive merge, while the dense level and the
+    // much larger hashed level only follow it
+    constexpr uintptr_t SIZE = 1000;
+    constexpr uint8_t ZERO = 0;
+
+    std::vector<uintptr_t> const crd{ 5, 10, 15, 500, 777, 990 };
+    std::vector<uintptr_t> const pos{ 0, crd.size() };
+    std::unordered_map<uintptr_t, uintptr_t> umap;
+    for (uintptr_t i = 0; i < SIZE; i += 2)
+    {
+        umap[i] = i / 2;
+    }
+    std::vector<std::unordered_map<uintptr_t, uintptr_t>> const crd_hashed{ umap };
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> dense_level{ SIZE };
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> compressed_level{ SIZE,
+                                                                                      pos,
+                                                                                      crd };
+    xsparse::levels::hashed<
+        std::tuple<>,
+        uintptr_t,
+        uintptr_t,
+        xsparse::util::container_traits<std::vector, std::unordered_set, std::unordered_map>,
+        xsparse::level_properties<false, false, false, false, false>>
+        hash_level{ SIZE, crd_hashed };
+
+    auto fn = [](std::tuple<bool, bool, bool> t) constexpr
+    { return std::get<0>(t) && std::get<1>(t) && std::get<2>(t); };
+
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<decltype(dense_level), decltype(compressed_level), decltype(hash_level)>,
+        std::tuple<>,
+        std::tuple<uintptr_t, uintptr_t, uintptr_t>>
+        coiter(fn, dense_level, compressed_level, hash_level);
+
+    auto coiter_helper = coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO, ZERO));
+
+    // the compressed level has the fewest entries, so it drives the loop
+    CHECK(coiter_helper.m_leader == 1);
+
+    std::vector<uintptr_t> result;
+    for (auto const [ik, pk_tuple] : coiter_helper)
+    {
+        CHECK(std::get<0>(pk_tuple).value() == ik);
+        CHECK(crd[std::get<1>(pk_tuple).value()] == ik);
+        CHECK(std::get<2>(pk_tuple).value() == ik / 2);
+        result.push_back(ik);
+    }
+    CHECK(result == std::vector<uintptr_t>{ 10, 500, 990 });
+}
+
+TEST_CASE("Coiteration-Bitmap-Bitmap-Dense-WordParallel")
+{
+    // fibers over three words, the last of them partial
+    constexpr uintptr_t SIZE = 150;
+    constexpr uint8_t ZERO = 0;
+
+    std::vector<uintptr_t> crd1, crd2;
+    for (uintptr_t i = 0; i < SIZE; i += 2)
+    {
+        crd1.push_back(i);
+    }
+    for (uintptr_t i = 0; i < SIZE; i += 3)
+    {
+        crd2.push_back(i);
+    }
+    crd2.push_back(SIZE - 1);
+
+    using bitmap_t = xsparse::levels::bitmap<std::tuple<>, uintptr_t, uintptr_t>;
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    bitmap_t b1{ SIZE, { 0, crd1.size() }, crd1 };
+    bitmap_t b2{ SIZE, { 0, crd2.size() }, crd2 };
+    dense_t d{ SIZE };
+
+    // the expected coordinates and positions of a merge, from `locate`
+    auto const check_merge = [&](auto& coiter, auto const& in_merge)
+    {
+        std::vector<uintptr_t> result, expected;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO, ZERO)))
+        {
+            CHECK(std::get<0>(pk_tuple) == b1.locate(ZERO, ik));
+            CHECK(std::get<1>(pk_tuple) == b2.locate(ZERO, ik));
+            CHECK(std::get<2>(pk_tuple).value() == ik);
+            result.push_back(ik);
+        }
+        for (uintptr_t ik = 0; ik < SIZE; ++ik)
+        {
+            if (in_merge(b1.locate(ZERO, ik).has_value(), b2.locate(ZERO, ik).has_value()))
+            {
+                expected.push_back(ik);
+            }
+        }
+        CHECK(!expected.empty());
+        CHECK(result == expected);
+    };
+
+    SUBCASE("Conjunctive")
+    {
+        auto fn = [](std::tuple<bool, bool, bool> t) constexpr
+        { return std::get<0>(t) && std::get<1>(t) && std::get<2>(t); };
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uintptr_t,
+            uintptr_t,
+            std::tuple<bitmap_t, bitmap_t, dense_t>,
+            std::tuple<>,
+            std::tuple<uintptr_t, uintptr_t, uintptr_t>>
+            coiter(fn, b1, b2, d);
+        check_merge(coiter, [](bool x, bool y) { return x && y; });
+    }
+
+    SUBCASE("Disjunctive")
+    {
+        // the dense level only takes part when both bitmaps do
+        auto fn = [](std::tuple<bool, bool, bool> t) constexpr
+        { return std::get<0>(t) || (std::get<1>(t) && std::get<2>(t)); };
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uintptr_t,
+            uintptr_t,
+            std::tuple<bitmap_t, bitmap_t, dense_t>,
+            std::tuple<>,
+            std::tuple<uintptr_t, uintptr_t, uintptr_t>>
+            coiter(fn, b1, b2, d);
+        check_merge(coiter, [](bool x, bool y) { return x || y; });
+    }
+
+    SUBCASE("Complemented-Mask")
+    {
+        // the entries of the first bitmap outside the mask given by the second
+        auto fn = [](std::tuple<bool, bool, bool> t) constexpr
+        { return std::get<0>(t) && !std::get<1>(t) && std::get<2>(t); };
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uintptr_t,
+            uintptr_t,
+            std::tuple<bitmap_t, bitmap_t, dense_t>,
+            std::tuple<>,
+            std::tuple<uintptr_t, uintptr_t, uintptr_t>>
+            coiter(fn, b1, b2, d);
+        check_merge(coiter, [](bool x, bool y) { return x && !y; });
+    }
+}
+
+TEST_CASE("Coiteration-Compressed-Compressed-DisjunctiveMerge-Unequal")
+{
+    // a disjunction goes on until every level is exhausted, so the coordinates of the longer
+    // fiber after the end of the shorter one are still visited, with no PK for the latter
+    constexpr uint8_t ZERO = 0;
+    using compressed_t = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+
+    std::vector<uintptr_t> const crd1{ 0, 2, 4, 6, 8, 10 };
+    std::vector<uintptr_t> const crd2{ 1, 3 };
+    std::vector<uintptr_t> const pos1{ 0, crd1.size() };
+    std::vector<uintptr_t> const pos2{ 0, crd2.size() };
+    compressed_t c1{ 11, pos1, crd1 };
+    compressed_t c2{ 11, pos2, crd2 };
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) || std::get<1>(t); };
+    using coiterate_t = xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<compressed_t, compressed_t>,
+        std::tuple<>,
+        std::tuple<uint8_t, uint8_t>>;
+    std::vector<uintptr_t> const expected{ 0, 1, 2, 3, 4, 6, 8, 10 };
+
+    SUBCASE("Shorter-Second")
+    {
+        coiterate_t coiter(fn, c1, c2);
+        std::vector<uintptr_t> result;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+        {
+            result.push_back(ik);
+            CHECK(std::get<1>(pk_tuple).has_value() == (ik == 1 || ik == 3));
+        }
+        CHECK(result == expected);
+    }
+
+    SUBCASE("Shorter-First")
+    {
+        coiterate_t coiter(fn, c2, c1);
+        std::vector<uintptr_t> result;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+        {
+            result.push_back(ik);
+            CHECK(std::get<0>(pk_tuple).has_value() == (ik == 1 || ik == 3));
+        }
+        CHECK(result == expected);
+    }
+}
@@ -1,5 +1,6 @@
 #include <doctest/doctest.h>
 
+#include <algorithm>
 #include <tuple>
 #include <vector>
 #include <list>
@@ -165,3 +166,41 @@ TEST_CASE("Compressed-CSR-Append")
     }
     CHECK(l1 == SIZE1);
 }
+
+TEST_CASE("Compressed-Seek")
+{
+    constexpr uintptr_t SIZE = 1000;
+    constexpr uint8_t ZERO = 0;
+
+    std::vector<uintptr_t> pos{ 0 };
+    std::vector<uintptr_t> crd;
+    for (uintptr_t i = 3; i < SIZE; i += 7)
+    {
+        crd.push_back(i);
+    }
+    pos.push_back(crd.size());
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> s{ SIZE, pos, crd };
+    auto it_helper = s.iter_helper(std::make_tuple(), ZERO);
+
+    // seeking from the beginning should agree with `std::lower_bound` for every target
+    for (uintptr_t target = 0; target <= SIZE; ++target)
+    {
+        auto it = it_helper.begin();
+        it.seek(target);
+        auto expected = std::lower_bound(crd.begin(), crd.end(), target);
+        CHECK(it - it_helper.begin() == expected - crd.begin());
+    }
+
+    // seeking never moves backwards
+    auto it = it_helper.begin();
+    it.seek(500);
+    auto const [ik, pk] = *it;
+    it.seek(10);
+    CHECK(std::get<0>(*it) == ik);
+    CHECK(std::get<1>(*it) == pk);
+
+    // seeking past the last coordinate ends the iteration
+    it.seek(SIZE);
+    CHECK(it == it_helper.end());
+}
@@ -0,0 +1,228 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/radix_sort.hpp>
+#include <xsparse/util/thread_pool.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/convert.hpp>
+
+namespace
+{
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using csr_tensor_t = xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>>;
+
+    template <class Tensor>
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> entries(Tensor const& t)
+    {
+        std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+        t.for_each([&](auto const& ij, double v)
+                   { result.emplace_back(std::get<0>(ij), std::get<1>(ij), v); });
+        return result;
+    }
+}
+
+TEST_CASE("Convert-CSR-CSC")
+{
+    // a 4 x 6 matrix with an empty row and an empty column
+    dense_t rows{ 4 };
+    csr_t cols{ 6, { 0, 2, 2, 5, 7 }, { 1, 5, 0, 1, 4, 1, 3 } };
+    std::vector<double> data{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0 };
+    csr_tensor_t A(rows, cols, data);
+
+    xsparse::util::work_stealing_pool pool(2);
+    dense_t cols_t{ 6 };
+    csr_t rows_t{ 4 };
+    std::vector<double> data_t;
+    csr_tensor_t AT(cols_t, rows_t, data_t);
+    xsparse::convert(A, AT, { 1, 0 }, pool);
+
+    CHECK(rows_t.get_pos() == std::vector<uintptr_t>{ 0, 1, 4, 4, 5, 6, 7 });
+    CHECK(rows_t.get_crd() == std::vector<uintptr_t>{ 2, 0, 2, 3, 3, 2, 0 });
+    CHECK(data_t == std::vector<double>{ 3.0, 1.0, 4.0, 6.0, 7.0, 5.0, 2.0 });
+
+    // and back, which gives the original matrix
+    dense_t rows_tt{ 4 };
+    csr_t cols_tt{ 6 };
+    std::vector<double> data_tt;
+    csr_tensor_t ATT(rows_tt, cols_tt, data_tt);
+    xsparse::convert(AT, ATT, { 1, 0 }, pool);
+    CHECK(cols_tt.get_pos() == cols.get_pos());
+    CHECK(cols_tt.get_crd() == cols.get_crd());
+    CHECK(data_tt == data);
+}
+
+TEST_CASE("Convert-Hashed-CSR")
+{
+    using hashed_t = xsparse::levels::hashed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    dense_t rows{ 3 };
+    hashed_t cols{ 100,
+                   { { { 70, 0 }, { 3, 1 }, { 41, 2 } }, {}, { { 99, 3 }, { 0, 4 } } } };
+    std::vector<double> data{ 1.0, 2.0, 3.0, 4.0, 5.0 };
+    xsparse::Tensor<std::tuple<dense_t, hashed_t>, std::vector<double>> H(rows, cols, data);
+
+    // the columns of every row are sorted on the way
+    dense_t rows_c{ 3 };
+    csr_t cols_c{ 100 };
+    std::vector<double> data_c;
+    csr_tensor_t C(rows_c, cols_c, data_c);
+    xsparse::convert(H, C);
+    CHECK(entries(C)
+          == std::vector<std::tuple<uintptr_t, uintptr_t, double>>{
+              { 0, 3, 2.0 }, { 0, 41, 3.0 }, { 0, 70, 1.0 }, { 2, 0, 5.0 }, { 2, 99, 4.0 } });
+    CHECK(cols_c.get_pos() == std::vector<uintptr_t>{ 0, 3, 3, 5 });
+
+    // and back into a hashed level, which is inserted into without sorting
+    dense_t rows_h{ 3 };
+    hashed_t cols_h{ 100 };
+    std::vector<double> data_h;
+    xsparse::Tensor<std::tuple<dense_t, hashed_t>, std::vector<double>> H2(rows_h, cols_h, data_h);
+    xsparse::convert(C, H2);
+    CHECK(data_h[*cols_h.locate(0, 41)] == 3.0);
+    CHECK(data_h[*cols_h.locate(2, 99)] == 4.0);
+    CHECK(!cols_h.locate(1, 3).has_value());
+}
+
+TEST_CASE("Convert-COO-Random")
+{
+    // random matrices in COO, converted to CSR and CSC and compared entry by entry
+    using coo_row_t = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    using coo_col_t = xsparse::levels::singleton<std::tuple<coo_row_t>, uintptr_t, uintptr_t>;
+    constexpr uintptr_t ROWS = 300, COLS = 70000;
+
+    std::mt19937 rng(11);
+    std::bernoulli_distribution present(0.0005);
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> expected;
+    for (uintptr_t i = 0; i < ROWS; ++i)
+    {
+        for (uintptr_t j = 0; j < COLS; ++j)
+        {
+            if (present(rng))
+            {
+                expected.emplace_back(i, j, static_cast<double>(expected.size() + 1));
+            }
+        }
+    }
+
+    coo_row_t coo_rows{ ROWS };
+    coo_col_t coo_cols{ COLS };
+    std::vector<double> coo_data;
+    xsparse::Tensor<std::tuple<coo_row_t, coo_col_t>, std::vector<double>> coo(
+        coo_rows, coo_cols, coo_data);
+    coo.assemble(expected.begin(), expected.end());
+
+    xsparse::util::work_stealing_pool pool(3);
+    dense_t rows{ ROWS };
+    csr_t cols{ COLS };
+    std::vector<double> data;
+    csr_tensor_t A(rows, cols, data);
+    xsparse::convert(coo, A, pool);
+    CHECK(entries(A) == expected);
+
+    dense_t cols_t{ COLS };
+    csr_t rows_t{ ROWS };
+    std::vector<double> data_t;
+    csr_tensor_t AT(cols_t, rows_t, data_t);
+    xsparse::convert(coo, AT, { 1, 0 }, pool);
+    auto transposed = entries(AT);
+    CHECK(transposed.size() == expected.size());
+    for (auto& [j, i, v] : transposed)
+    {
+        std::swap(i, j);
+    }
+    std::sort(transposed.begin(), transposed.end());
+    CHECK(transposed == expected);
+}
+
+TEST_CASE("Convert-Wide-Coordinates")
+{
+    // three modes of 2^40 coordinates do not fit one packed key
+    using c1_t = xsparse::levels::compressed<std::tuple<>, uint64_t, uintptr_t>;
+    using s2_t = xsparse::levels::singleton<std::tuple<c1_t>, uint64_t, uintptr_t>;
+    using s3_t = xsparse::levels::singleton<std::tuple<s2_t, c1_t>, uint64_t, uintptr_t>;
+    constexpr uint64_t SIZE = uint64_t{ 1 } << 40;
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t, int>> const input{
+        { 1, SIZE - 1, 7, 1 }, { 2, 0, 5, 2 }, { SIZE - 2, 3, 5, 3 }, { SIZE - 2, 4, 0, 4 }
+    };
+    c1_t c1{ SIZE };
+    s2_t s2{ SIZE };
+    s3_t s3{ SIZE };
+    std::vector<int> data;
+    xsparse::Tensor<std::tuple<c1_t, s2_t, s3_t>, std::vector<int>> T(c1, s2, s3, data);
+    T.assemble(input.begin(), input.end());
+
+    // mode 2 outermost, then modes 0 and 1
+    c1_t d1{ SIZE };
+    s2_t d2{ SIZE };
+    s3_t d3{ SIZE };
+    std::vector<int> data_p;
+    xsparse::Tensor<std::tuple<c1_t, s2_t, s3_t>, std::vector<int>> P(d1, d2, d3, data_p);
+    xsparse::convert(T, P, { 2, 0, 1 });
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t, int>> result;
+    P.for_each([&](auto const& ijk, int v)
+               { result.emplace_back(std::get<0>(ijk), std::get<1>(ijk), std::get<2>(ijk), v); });
+    CHECK(result
+          == std::vector<std::tuple<uint64_t, uint64_t, uint64_t, int>>{
+              { 0, SIZE - 2, 4, 4 },
+              { 5, 2, 0, 2 },
+              { 5, SIZE - 2, 3, 3 },
+              { 7, 1, SIZE - 1, 1 } });
+}
+
+TEST_CASE("Convert-Errors")
+{
+    dense_t rows{ 2 };
+    csr_t cols{ 3, { 0, 1, 2 }, { 0, 2 } };
+    std::vector<double> data{ 1.0, 2.0 };
+    csr_tensor_t A(rows, cols, data);
+
+    dense_t rows_b{ 2 };
+    csr_t cols_b{ 3 };
+    std::vector<double> data_b;
+    csr_tensor_t B(rows_b, cols_b, data_b);
+    CHECK_THROWS_AS(xsparse::convert(A, B, { 1, 0 }), std::invalid_argument);
+    CHECK_THROWS_AS(xsparse::convert(A, B, { 0, 0 }), std::invalid_argument);
+    CHECK_THROWS_AS(xsparse::convert(A, B, { 0, 2 }), std::invalid_argument);
+    data_b.push_back(1.0);
+    CHECK_THROWS_AS(xsparse::convert(A, B), std::invalid_argument);
+}
+
+TEST_CASE("RadixSort")
+{
+    // enough keys for several chunks, with digits that are all equal above the lowest 20 bits
+    xsparse::util::work_stealing_pool pool(4);
+    std::mt19937_64 rng(5);
+    std::vector<uint64_t> keys(100000);
+    std::vector<std::size_t> order(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i] = (uint64_t{ 3 } << 40) | (rng() & 0xFFFFF);
+        order[i] = i;
+    }
+    auto const original = keys;
+    xsparse::util::radix_sort(keys, order, 0, 42, pool);
+
+    CHECK(std::is_sorted(keys.begin(), keys.end()));
+    bool moved = true, stable = true;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        moved = moved && original[order[i]] == keys[i];
+        stable = stable && (i == 0 || keys[i - 1] != keys[i] || order[i - 1] < order[i]);
+    }
+    CHECK(moved);
+    CHECK(stable);
+}
@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>
+#include <xsparse/levels/flat_hashed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/level_capabilities/co_iteration.hpp>
+#include <xsparse/level_capabilities/locate.hpp>
+
+#include <xsparse/util/container_traits.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/level_properties.hpp>
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+
+TEST_CASE("FlatHashed-BaseCase")
+{
+    constexpr uintptr_t SIZE0 = 3;
+    constexpr uint8_t ZERO = 0;
+
+    std::unordered_map<uintptr_t, uintptr_t> const umap1{ { 5, 2 }, { 6, 1 }, { 4, 0 } };
+    std::vector<std::unordered_map<uintptr_t, uintptr_t>> const crd{ umap1 };
+
+    xsparse::levels::flat_hashed<std::tuple<>, uintptr_t, uintptr_t> h{ SIZE0, crd };
+
+    uintptr_t l2 = 0;
+    for (auto const [i2, p2] : h.iter_helper(std::tuple(), ZERO))
+    {
+        CHECK(crd[0].at(i2) == p2);
+        ++l2;
+    }
+    CHECK(l2 == crd[0].size());
+
+    CHECK(h.locate(ZERO, 5) == 2);
+    CHECK(h.locate(ZERO, 4) == 0);
+    CHECK(!h.locate(ZERO, 7).has_value());
+
+    static_assert(!decltype(h)::LevelProperties::is_ordered);
+    static_assert(!decltype(h)::LevelProperties::is_branchless);
+    static_assert(!decltype(h)::LevelProperties::is_compact);
+    static_assert(has_locate_v<decltype(h)>);
+}
+
+TEST_CASE("Dense-FlatHashed-Insert")
+{
+    // enough coordinates to rehash the table several times, with the same coordinates
+    // repeated under different parents
+    constexpr uintptr_t SIZE0 = 50;
+    constexpr uintptr_t SIZE1 = 1000;
+    constexpr uint8_t ZERO = 0;
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d{ SIZE0 };
+    xsparse::levels::flat_hashed<std::tuple<decltype(d)>, uintptr_t, uintptr_t> h{ SIZE1 };
+    h.insert_init(SIZE0);
+
+    std::vector<std::map<uintptr_t, uintptr_t>> expected(SIZE0);
+    uintptr_t pk = 0;
+    for (uintptr_t p1 = 0; p1 < SIZE0; ++p1)
+    {
+        for (uintptr_t i2 = p1 % 7; i2 < SIZE1; i2 += 7 + p1)
+        {
+            h.insert_coord(p1, pk, i2);
+            expected[p1][i2] = pk++;
+        }
+    }
+    // inserting an existing coordinate updates its position
+    h.insert_coord(3, pk, 3);
+    expected[3][3] = pk;
+
+    for (auto const [i1, p1] : d.iter_helper(std::make_tuple(), ZERO))
+    {
+        std::map<uintptr_t, uintptr_t> fiber;
+        for (auto const [i2, p2] : h.iter_helper(std::make_tuple(i1), p1))
+        {
+            fiber[i2] = p2;
+            CHECK(h.locate(p1, i2) == p2);
+        }
+        CHECK(fiber == expected[p1]);
+
+        for (uintptr_t i2 = 0; i2 < SIZE1; ++i2)
+        {
+            CHECK(h.locate(p1, i2).has_value() == expected[p1].contains(i2));
+        }
+    }
+}
+
+TEST_CASE("Coiteration-Dense-FlatHashed-ConjunctiveMerge")
+{
+    constexpr uint8_t ZERO = 0;
+
+    std::unordered_map<uintptr_t, uintptr_t> const umap1{ { 0, 1 }, { 2, 5 }, { 4, 2 } };
+    std::vector<std::unordered_map<uintptr_t, uintptr_t>> const crd0{ umap1 };
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> dense_level{ 5 };
+    xsparse::levels::flat_hashed<std::tuple<>, uintptr_t, uintptr_t> hash_level{ 5, crd0 };
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return (std::get<0>(t) && std::get<1>(t)); };
+
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<decltype(dense_level), decltype(hash_level)>,
+        std::tuple<>,
+        std::tuple<uintptr_t, uintptr_t>>
+        coiter(fn, dense_level, hash_level);
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t>> result;
+    for (auto const [ik, pk_tuple] :
+         coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+    {
+        result.emplace_back(ik, std::get<0>(pk_tuple).value(), std::get<1>(pk_tuple).value());
+    }
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t>> const expected{ { 0, 0, 1 },
+                                                                             { 2, 2, 5 },
+                                                                             { 4, 4, 2 } };
+    CHECK(result == expected);
+}
@@ -1,12 +1,19 @@
 #include <doctest/doctest.h>
 #include <xsparse/levels/hashed.hpp>
 #include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/compressed.hpp>
 #include <xsparse/levels/singleton.hpp>
+#include <xsparse/level_capabilities/co_iteration.hpp>
 #include <xsparse/level_capabilities/locate.hpp>
+#include <xsparse/util/template_utils.hpp>
 
 #include <xsparse/util/container_traits.hpp>
 #include <xsparse/level_properties.hpp>
 
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include <set>
@@ -261,3 +268,118 @@ TEST_CASE("Dense-Hashed-Insert")
     }
     CHECK(l1 == SIZE0);
 }
+
+TEST_CASE("Hashed-IterHelper-View")
+{
+    constexpr uintptr_t SIZE0 = 2;
+    constexpr uintptr_t SIZE1 = 10;
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d{ SIZE0 };
+    xsparse::levels::hashed<std::tuple<decltype(d)>, uintptr_t, uintptr_t> h{ SIZE1 };
+    h.insert_init(SIZE0);
+    h.insert_coord(1, 0, 7);
+
+    // the helper is a view over the stored fiber, so it sees coordinates inserted after it was
+    // created and the iterators of two helpers over the same fiber compare equal
+    auto const helper = h.iter_helper(std::make_tuple(uintptr_t(1)), 1);
+    h.insert_coord(1, 1, 3);
+    CHECK(std::distance(helper.begin(), helper.end()) == 2);
+    CHECK(helper.begin() == h.iter_helper(std::make_tuple(uintptr_t(1)), 1).begin());
+}
+
+TEST_CASE("Hashed-Ordered-View")
+{
+    constexpr uintptr_t SIZE0 = 3;
+    constexpr uintptr_t SIZE1 = 100;
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d{ SIZE0 };
+    xsparse::levels::hashed<std::tuple<decltype(d)>, uintptr_t, uintptr_t> h{ SIZE1 };
+    h.insert_init(SIZE0);
+    std::vector<uintptr_t> const crd{ 42, 7, 90, 3, 15, 64, 28 };
+    for (uintptr_t p = 0; p < crd.size(); ++p)
+    {
+        h.insert_coord(0, p, crd[p]);
+    }
+    h.insert_coord(2, 7, 5);
+
+    auto const view = h.ordered();
+    static_assert(decltype(view)::LevelProperties::is_ordered);
+    static_assert(has_locate_v<decltype(view)>);
+    CHECK(view.size() == SIZE1);
+    CHECK(view.locate(0, 90) == std::optional<uintptr_t>(2));
+
+    // in increasing coordinate order, with the positions of the hashed level
+    std::vector<std::pair<uintptr_t, uintptr_t>> result;
+    for (auto const [ik, pk] : view.iter_helper(std::make_tuple(uintptr_t(0)), 0))
+    {
+        result.emplace_back(ik, pk);
+    }
+    std::vector<std::pair<uintptr_t, uintptr_t>> const expected{
+        { 3, 3 }, { 7, 1 }, { 15, 4 }, { 28, 6 }, { 42, 0 }, { 64, 5 }, { 90, 2 }
+    };
+    CHECK(result == expected);
+    CHECK(view.iter_helper(std::make_tuple(uintptr_t(1)), 1).begin()
+          == view.iter_helper(std::make_tuple(uintptr_t(1)), 1).end());
+
+    // seeking gallops to the first coordinate that is not less than the target
+    auto const helper = view.iter_helper(std::make_tuple(uintptr_t(0)), 0);
+    auto it = helper.begin();
+    CHECK(std::get<0>(*it.seek(16)) == 28);
+    CHECK(std::get<0>(*it.seek(28)) == 28);
+    CHECK(std::get<0>(*it.seek(0)) == 28);
+    CHECK(std::get<0>(*it.seek(65)) == 90);
+    CHECK(it.seek(91) == helper.end());
+
+    // the sorted copy of a fiber is kept until the fiber changes
+    auto const* sorted = &h.sorted_fiber(0);
+    CHECK(sorted->size() == crd.size());
+    h.insert_coord(0, 8, 50);
+    CHECK(h.sorted_fiber(0).size() == crd.size() + 1);
+    CHECK(h.sorted_fiber(0)[5] == std::pair<uintptr_t, uintptr_t>(50, 8));
+    CHECK(h.sorted_fiber(2) == decltype(h)::sorted_fiber_type{ { 5, 7 } });
+
+    h.insert_init(SIZE0);
+    CHECK(h.sorted_fiber(1).empty());
+}
+
+TEST_CASE("Hashed-Ordered-View-Disjunction")
+{
+    // a hashed level can only be merged in a union through its ordered view
+    constexpr uintptr_t SIZE = 20;
+    constexpr uint8_t ZERO = 0;
+    using compressed_t = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    using hashed_t = xsparse::levels::hashed<std::tuple<>, uintptr_t, uintptr_t>;
+
+    compressed_t c{ SIZE, { 0, 4 }, { 1, 5, 9, 12 } };
+    hashed_t h{ SIZE };
+    h.insert_init(1);
+    h.insert_coord(ZERO, 0, 12);
+    h.insert_coord(ZERO, 1, 2);
+    h.insert_coord(ZERO, 2, 17);
+    h.insert_coord(ZERO, 3, 5);
+    auto view = h.ordered();
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) || std::get<1>(t); };
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<compressed_t, decltype(view)>,
+        std::tuple<>,
+        std::tuple<uint8_t, uint8_t>>
+        coiter(fn, c, view);
+
+    using entry_t = std::tuple<uintptr_t, std::optional<uintptr_t>, std::optional<uintptr_t>>;
+    std::vector<entry_t> result;
+    for (auto const [ik, pks] :
+         coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+    {
+        result.emplace_back(ik, std::get<0>(pks), std::get<1>(pks));
+    }
+    std::vector<entry_t> const expected{
+        { 1, 0, std::nullopt }, { 2, std::nullopt, 1 }, { 5, 1, 3 },
+        { 9, 2, std::nullopt }, { 12, 3, 0 },           { 17, std::nullopt, 2 },
+    };
+    CHECK(result == expected);
+}
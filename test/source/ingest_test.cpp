@@ -0,0 +1,149 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/ingest.hpp>
+
+namespace
+{
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using coo_row_t = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    using coo_col_t = xsparse::levels::singleton<std::tuple<coo_row_t>, uintptr_t, uintptr_t>;
+
+    using entries_t = std::vector<std::tuple<uintptr_t, uintptr_t, double>>;
+
+    // random entries with many duplicates, and the matrix they sum up to
+    struct random_entries
+    {
+        std::vector<uint32_t> rows, cols;
+        std::vector<double> values;
+        std::map<std::pair<uintptr_t, uintptr_t>, double> sums;
+
+        random_entries(std::size_t n, uint32_t num_rows, uint32_t num_cols, unsigned seed)
+        {
+            std::mt19937 rng(seed);
+            std::uniform_int_distribution<uint32_t> row(0, num_rows - 1), col(0, num_cols - 1);
+            std::uniform_int_distribution<int> value(1, 9);
+            for (std::size_t e = 0; e < n; ++e)
+            {
+                rows.push_back(row(rng));
+                cols.push_back(col(rng));
+                values.push_back(value(rng));
+                sums[{ rows.back(), cols.back() }] += values.back();
+            }
+        }
+
+        entries_t expected() const
+        {
+            entries_t result;
+            for (auto const& [ij, v] : sums)
+            {
+                result.emplace_back(ij.first, ij.second, v);
+            }
+            return result;
+        }
+    };
+
+    template <class Tensor>
+    entries_t entries(Tensor const& t)
+    {
+        entries_t result;
+        t.for_each([&](auto const& ij, double v)
+                   { result.emplace_back(std::get<0>(ij), std::get<1>(ij), v); });
+        return result;
+    }
+}
+
+TEST_CASE("Ingest-CSR")
+{
+    // more rows than entries, so that many rows are empty
+    xsparse::util::work_stealing_pool pool(3);
+    random_entries const input(100000, 150000, 1000, 1);
+    dense_t rows{ 150000 };
+    csr_t cols{ 1000 };
+    std::vector<double> data;
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> A(rows, cols, data);
+    xsparse::ingest(A, input.rows, input.cols, input.values, std::plus<>{}, pool);
+
+    CHECK(cols.get_pos().size() == 150001);
+    CHECK(data.size() == input.sums.size());
+    CHECK(entries(A) == input.expected());
+}
+
+TEST_CASE("Ingest-COO")
+{
+    // few coordinates, so that most entries are duplicates
+    xsparse::util::work_stealing_pool pool(2);
+    random_entries const input(60000, 30, 50, 2);
+    coo_row_t rows{ 30 };
+    coo_col_t cols{ 50 };
+    std::vector<double> data;
+    xsparse::Tensor<std::tuple<coo_row_t, coo_col_t>, std::vector<double>> A(rows, cols, data);
+    xsparse::ingest(A, input.rows, input.cols, input.values, std::plus<>{}, pool);
+
+    CHECK(rows.get_pos() == std::vector<uintptr_t>{ 0, input.sums.size() });
+    CHECK(entries(A) == input.expected());
+}
+
+TEST_CASE("Ingest-Reduce")
+{
+    // duplicates are reduced in the order they are given, and a single row takes no key bits
+    std::vector<uintptr_t> const r{ 0, 0, 0, 0, 0 };
+    std::vector<uintptr_t> const c{ 7, 2, 7, 7, 2 };
+    std::vector<double> const v{ 1.0, 2.0, 3.0, 4.0, 5.0 };
+    dense_t rows{ 1 };
+    csr_t cols{ 8 };
+    std::vector<double> data;
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> A(rows, cols, data);
+    xsparse::ingest(A, r, c, v, [](double acc, double x) { return 10 * acc + x; });
+
+    CHECK(cols.get_pos() == std::vector<uintptr_t>{ 0, 2 });
+    CHECK(cols.get_crd() == std::vector<uintptr_t>{ 2, 7 });
+    CHECK(data == std::vector<double>{ 25.0, 134.0 });
+
+    // and no entries at all
+    dense_t rows_e{ 3 };
+    csr_t cols_e{ 8 };
+    std::vector<double> data_e;
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> E(rows_e, cols_e, data_e);
+    xsparse::ingest(E, std::vector<uintptr_t>{}, std::vector<uintptr_t>{}, std::vector<double>{});
+    CHECK(cols_e.get_pos() == std::vector<uintptr_t>{ 0, 0, 0, 0 });
+    CHECK(cols_e.get_crd().empty());
+}
+
+TEST_CASE("Ingest-Errors")
+{
+    std::vector<uintptr_t> const r{ 0, 1 };
+    std::vector<uintptr_t> const c{ 2, 3 };
+    std::vector<double> const v{ 1.0, 2.0 };
+    dense_t rows{ 2 };
+    csr_t cols{ 3 };
+    std::vector<double> data;
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> A(rows, cols, data);
+    CHECK_THROWS_AS(xsparse::ingest(A, r, c, v), std::invalid_argument);
+    CHECK_THROWS_AS(xsparse::ingest(A, r, std::vector<uintptr_t>{ 0 }, v),
+                    std::invalid_argument);
+
+    dense_t rows_w{ uintptr_t{ 1 } << 40 };
+    csr_t cols_w{ uintptr_t{ 1 } << 40 };
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> W(rows_w, cols_w, data);
+    CHECK_THROWS_AS(xsparse::ingest(W, r, r, v), std::invalid_argument);
+
+    data.push_back(1.0);
+    CHECK_THROWS_AS(xsparse::ingest(A, r, r, v), std::invalid_argument);
+}
@@ -0,0 +1,123 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/levels/offset.hpp>
+#include <xsparse/levels/range.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/util/container_traits.hpp>
+
+namespace
+{
+    std::size_t num_allocations = 0;
+
+    /**
+     * @brief An allocator that counts the allocations of the containers using it.
+     */
+    template <class T>
+    struct counting_allocator : std::allocator<T>
+    {
+        using value_type = T;
+
+        template <class U>
+        struct rebind
+        {
+            using other = counting_allocator<U>;
+        };
+
+        counting_allocator() noexcept = default;
+
+        template <class U>
+        counting_allocator(counting_allocator<U> const&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            ++num_allocations;
+            return std::allocator<T>::allocate(n);
+        }
+    };
+
+    template <class T>
+    using counting_vector = std::vector<T, counting_allocator<T>>;
+
+    using counting_traits
+        = xsparse::util::container_traits<counting_vector, std::unordered_set, std::unordered_map>;
+
+    template <class Level, class... Args>
+    std::size_t allocations_to_construct(Args&&... args)
+    {
+        num_allocations = 0;
+        Level const level(std::forward<Args>(args)...);
+        return num_allocations;
+    }
+}
+
+TEST_CASE("Levels-Move-Construct")
+{
+    constexpr uintptr_t SIZE = 100;
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+
+    SUBCASE("Compressed")
+    {
+        using compressed_t = xsparse::levels::
+            compressed<std::tuple<dense_t>, uintptr_t, uintptr_t, counting_traits>;
+        counting_vector<uintptr_t> pos{ 0, 2, 3 };
+        counting_vector<uintptr_t> crd{ 1, 7, 3 };
+        auto const* const crd_data = crd.data();
+
+        CHECK(allocations_to_construct<compressed_t>(SIZE, pos, crd) == 2);
+        num_allocations = 0;
+        compressed_t const c{ SIZE, std::move(pos), std::move(crd) };
+        CHECK(num_allocations == 0);
+        CHECK(c.get_crd().data() == crd_data);
+    }
+
+    SUBCASE("Singleton")
+    {
+        using singleton_t = xsparse::levels::
+            singleton<std::tuple<dense_t>, uintptr_t, uintptr_t, counting_traits>;
+        counting_vector<uintptr_t> crd{ 1, 7, 3 };
+
+        CHECK(allocations_to_construct<singleton_t>(SIZE, crd) == 1);
+        CHECK(allocations_to_construct<singleton_t>(SIZE, std::move(crd)) == 0);
+    }
+
+    SUBCASE("Hashed")
+    {
+        using hashed_t = xsparse::levels::
+            hashed<std::tuple<dense_t>, uintptr_t, uintptr_t, counting_traits>;
+        counting_vector<std::unordered_map<uintptr_t, uintptr_t>> crd{ { { 1, 0 }, { 7, 1 } },
+                                                                        { { 3, 2 } } };
+
+        // copying also copies the maps, which do not use the counting allocator
+        CHECK(allocations_to_construct<hashed_t>(SIZE, crd) == 1);
+        CHECK(allocations_to_construct<hashed_t>(SIZE, std::move(crd)) == 0);
+    }
+
+    SUBCASE("Offset-Range")
+    {
+        using range_t = xsparse::levels::
+            range<std::tuple<dense_t>, uintptr_t, int16_t, counting_traits>;
+        using offset_t = xsparse::levels::
+            offset<std::tuple<range_t, dense_t>, uintptr_t, int16_t, counting_traits>;
+        counting_vector<int16_t> range_offset{ -3, -1, 0, 1 };
+        counting_vector<int16_t> offset_offset{ -3, -1, 0, 1 };
+
+        CHECK(allocations_to_construct<range_t>(SIZE, SIZE, range_offset) == 1);
+        CHECK(allocations_to_construct<range_t>(SIZE, SIZE, std::move(range_offset)) == 0);
+        CHECK(allocations_to_construct<offset_t>(SIZE, offset_offset) == 1);
+        CHECK(allocations_to_construct<offset_t>(SIZE, std::move(offset_offset)) == 0);
+    }
+}
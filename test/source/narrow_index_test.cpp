@@ -0,0 +1,276 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/bitmap.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/flat_hashed.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/levels/offset.hpp>
+#include <xsparse/levels/packed.hpp>
+#include <xsparse/levels/range.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/level_capabilities/assembly.hpp>
+#include <xsparse/level_capabilities/co_iteration.hpp>
+
+namespace
+{
+    constexpr uint8_t ZERO = 0;
+
+    // every `step`-th coordinate of `[0, size)`, starting at `first`
+    std::vector<uint16_t> every(uint16_t first, uint16_t step, uint32_t size)
+    {
+        std::vector<uint16_t> crd;
+        for (uint32_t c = first; c < size; c += step)
+        {
+            crd.push_back(static_cast<uint16_t>(c));
+        }
+        return crd;
+    }
+}
+
+TEST_CASE("NarrowIndex-Dense-Range-Positions")
+{
+    // positions past the range of the coordinates
+    using dense32_t = xsparse::levels::dense<std::tuple<>, uint32_t, uint32_t>;
+    xsparse::levels::dense<std::tuple<dense32_t>, uint32_t, uint64_t> d{ 70000 };
+    CHECK(d.coord_access(69999, std::make_tuple(uint32_t{ 0 }), 69999).value()
+          == uint64_t{ 69999 } * 70000 + 69999);
+
+    using dense16_t = xsparse::levels::dense<std::tuple<>, uint16_t, uint16_t>;
+    xsparse::levels::dense<std::tuple<dense16_t>, uint16_t, uint32_t> d2{ 60000 };
+    CHECK(d2.coord_access(60000, std::make_tuple(uint16_t{ 0 }), 59999).value()
+          == uint32_t{ 60000 } * 60000 + 59999);
+
+    // negative offsets of an unsigned `PK` wrap around
+    std::vector<uint32_t> const offset{ static_cast<uint32_t>(-3), 0, 2 };
+    dense16_t rows{ 3 };
+    xsparse::levels::range<std::tuple<dense16_t>, uint16_t, uint32_t> r{ 4, 6, offset };
+    xsparse::levels::offset<std::tuple<decltype(r), dense16_t>, uint16_t, uint32_t> o{
+        3, offset
+    };
+    std::vector<std::tuple<uint16_t, uint16_t, uint32_t>> result;
+    for (auto const [i1, p1] : rows.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : r.iter_helper(std::make_tuple(i1), p1))
+        {
+            for (auto const [i3, p3] : o.iter_helper(std::make_tuple(i2, i1), p2))
+            {
+                result.emplace_back(i2, i3, p3);
+            }
+        }
+    }
+    std::vector<std::tuple<uint16_t, uint16_t, uint32_t>> const expected{
+        { 3, 0, 3 }, { 0, 0, 4 }, { 1, 1, 5 }, { 2, 2, 6 }, { 3, 3, 7 }, { 0, 2, 8 }, { 1, 3, 9 },
+        { 2, 4, 10 }, { 3, 5, 11 }
+    };
+    CHECK(result == expected);
+}
+
+TEST_CASE("NarrowIndex-Levels")
+{
+    // a fiber longer than `INT16_MAX`, whose length overflows a signed 16-bit difference
+    constexpr uint16_t SIZE = 65535;
+    auto const crd = every(0, 2, SIZE);
+    std::vector<uint16_t> const pos{ 0, static_cast<uint16_t>(crd.size()) };
+    REQUIRE(crd.size() > 32767);
+
+    xsparse::levels::compressed<std::tuple<>, uint16_t, uint16_t> c{ SIZE, pos, crd };
+    xsparse::levels::packed<std::tuple<>, uint16_t, uint16_t> p{ SIZE, pos, crd };
+    xsparse::levels::bitmap<std::tuple<>, uint16_t, uint16_t> b{ SIZE, pos, crd };
+    xsparse::levels::dense<std::tuple<>, uint16_t, uint16_t> d{ SIZE };
+
+    auto const check = [&](auto& level)
+    {
+        auto const helper = level.iter_helper(std::make_tuple(), ZERO);
+        CHECK(helper.end() - helper.begin() == static_cast<std::ptrdiff_t>(crd.size()));
+        std::vector<uint16_t> result;
+        for (auto const [ik, pk] : helper)
+        {
+            CHECK(crd[pk] == ik);
+            result.push_back(ik);
+        }
+        CHECK(result == crd);
+
+        auto it = helper.begin();
+        it.seek(SIZE - 2);
+        CHECK(std::get<0>(*it) == SIZE - 1);
+        it += helper.end() - it;
+        CHECK(it == helper.end());
+    };
+    check(c);
+    check(p);
+    check(b);
+
+    auto const dense_helper = d.iter_helper(std::make_tuple(), ZERO);
+    CHECK(dense_helper.end() - dense_helper.begin() == SIZE);
+    CHECK(std::get<1>(*--dense_helper.end()) == SIZE - 1);
+}
+
+TEST_CASE("NarrowIndex-Coiterate")
+{
+    constexpr uint16_t SIZE = 65535;
+    auto const odd = every(1, 2, SIZE);
+    auto const thirds = every(0, 3, SIZE);
+    std::vector<uint16_t> const odd_pos{ 0, static_cast<uint16_t>(odd.size()) };
+    std::vector<uint16_t> const thirds_pos{ 0, static_cast<uint16_t>(thirds.size()) };
+
+    using compressed_t = xsparse::levels::compressed<std::tuple<>, uint16_t, uint16_t>;
+    using hashed_t = xsparse::levels::hashed<std::tuple<>, uint16_t, uint16_t>;
+    compressed_t c1{ SIZE, odd_pos, odd };
+    compressed_t c2{ SIZE, thirds_pos, thirds };
+    hashed_t h{ SIZE };
+    h.insert_init(1);
+    for (std::size_t k = 0; k < thirds.size(); ++k)
+    {
+        h.insert_coord(0, static_cast<uint16_t>(k), thirds[k]);
+    }
+
+    std::vector<uint16_t> expected;
+    std::set_intersection(
+        odd.begin(), odd.end(), thirds.begin(), thirds.end(), std::back_inserter(expected));
+    REQUIRE(expected.back() == 65529);
+
+    SUBCASE("Conjunctive")
+    {
+        auto fn = [](std::tuple<bool, bool> t) constexpr
+        { return std::get<0>(t) && std::get<1>(t); };
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uint16_t,
+            uint16_t,
+            std::tuple<compressed_t, compressed_t>,
+            std::tuple<>,
+            std::tuple<uint8_t, uint8_t>>
+            coiter(fn, c1, c2);
+        std::vector<uint16_t> result;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+        {
+            CHECK(odd[*std::get<0>(pk_tuple)] == ik);
+            CHECK(thirds[*std::get<1>(pk_tuple)] == ik);
+            result.push_back(ik);
+        }
+        CHECK(result == expected);
+    }
+
+    SUBCASE("Conjunctive-Locate")
+    {
+        auto fn = [](std::tuple<bool, bool> t) constexpr
+        { return std::get<0>(t) && std::get<1>(t); };
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uint16_t,
+            uint16_t,
+            std::tuple<compressed_t, hashed_t>,
+            std::tuple<>,
+            std::tuple<uint8_t, uint8_t>>
+            coiter(fn, c1, h);
+        std::vector<uint16_t> result;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+        {
+            CHECK(thirds[*std::get<1>(pk_tuple)] == ik);
+            result.push_back(ik);
+        }
+        CHECK(result == expected);
+    }
+
+    SUBCASE("Disjunctive")
+    {
+        auto fn = [](std::tuple<bool, bool> t) constexpr
+        { return std::get<0>(t) || std::get<1>(t); };
+        xsparse::level_capabilities::Coiterate<
+            xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+            decltype(fn),
+            uint16_t,
+            uint16_t,
+            std::tuple<compressed_t, compressed_t>,
+            std::tuple<>,
+            std::tuple<uint8_t, uint8_t>>
+            coiter(fn, c1, c2);
+        std::vector<uint16_t> result, merged;
+        for (auto const [ik, pk_tuple] :
+             coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)))
+        {
+            result.push_back(ik);
+        }
+        std::set_union(
+            odd.begin(), odd.end(), thirds.begin(), thirds.end(), std::back_inserter(merged));
+        // the odd coordinates go on after the last multiple of three
+        CHECK(result == merged);
+    }
+}
+
+TEST_CASE("NarrowIndex-Assembly")
+{
+    // 90000 positions in the second level, more than the coordinates of any level can count
+    using rows_t = xsparse::levels::dense<std::tuple<>, uint16_t, uint16_t>;
+    using cols_t = xsparse::levels::dense<std::tuple<rows_t>, uint16_t, uint32_t>;
+    using fibers_t = xsparse::levels::compressed<std::tuple<cols_t, rows_t>, uint16_t, uint32_t>;
+
+    std::vector<std::tuple<uint16_t, uint16_t, uint16_t, double>> const entries{
+        { 0, 1, 5, 1.0 }, { 150, 0, 7, 2.0 }, { 150, 0, 9, 3.0 }, { 299, 299, 4, 4.0 }
+    };
+
+    rows_t l1{ 300 };
+    cols_t l2{ 300 };
+    fibers_t l3{ 10 };
+    std::vector<double> data;
+    xsparse::level_capabilities::Assemble<std::tuple<rows_t, cols_t, fibers_t>, decltype(data)>
+        assemble(l1, l2, l3, data);
+    assemble.append(entries.begin(), entries.end());
+    assemble.finalize();
+
+    CHECK(l3.get_pos().size() == 90001);
+    CHECK(data.size() == entries.size());
+
+    xsparse::Tensor<std::tuple<rows_t, cols_t, fibers_t>, std::vector<double>> A(l1, l2, l3, data);
+    std::vector<std::tuple<uint16_t, uint16_t, uint16_t, double>> visited;
+    A.for_each(
+        [&](auto const& ijk, double v)
+        { visited.emplace_back(std::get<0>(ijk), std::get<1>(ijk), std::get<2>(ijk), v); });
+    CHECK(visited == entries);
+}
+
+TEST_CASE("NarrowIndex-Flat-Hashed-Fibers")
+{
+    // 90000 parent positions, more than the coordinates can count
+    using rows_t = xsparse::levels::dense<std::tuple<>, uint16_t, uint16_t>;
+    using cols_t = xsparse::levels::dense<std::tuple<rows_t>, uint16_t, uint32_t>;
+    using fibers_t
+        = xsparse::levels::flat_hashed<std::tuple<cols_t, rows_t>, uint16_t, uint32_t>;
+    constexpr uint32_t FIBERS = 90000;
+
+    std::vector<std::unordered_map<uint16_t, uint32_t>> crd(FIBERS);
+    crd[0] = { { 5, 0 } };
+    crd[70000] = { { 7, 1 }, { 9, 2 } };
+    crd[FIBERS - 1] = { { 4, 3 } };
+    fibers_t l3{ 10, crd };
+
+    CHECK(l3.locate(0, 5).value() == 0);
+    CHECK(l3.locate(70000, 9).value() == 2);
+    CHECK(l3.locate(FIBERS - 1, 4).value() == 3);
+    CHECK(!l3.locate(FIBERS - 1, 5).has_value());
+
+    std::vector<std::pair<uint16_t, uint32_t>> fiber;
+    for (auto const [ik, pk] : l3.iter_helper(std::make_tuple(uint16_t{ 233 }, uint16_t{ 99 }),
+                                              FIBERS - 1))
+    {
+        fiber.emplace_back(ik, pk);
+    }
+    CHECK(fiber == std::vector<std::pair<uint16_t, uint32_t>>{ { 4, 3 } });
+}
@@ -0,0 +1,248 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/packed.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/kernels/spmv.hpp>
+#include <xsparse/level_capabilities/assembly.hpp>
+#include <xsparse/level_capabilities/co_iteration.hpp>
+
+namespace
+{
+    constexpr uintptr_t ROWS = 5;
+    constexpr uintptr_t COLS = uintptr_t{ 1 } << 40;
+
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using packed_t = xsparse::levels::packed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+
+    // a run of consecutive columns over several blocks, an empty row, a short row, random
+    // columns with small gaps, and columns with gaps of more than 32 bits
+    struct csr_matrix
+    {
+        std::vector<uintptr_t> pos{ 0 };
+        std::vector<uintptr_t> crd;
+
+        csr_matrix()
+        {
+            for (uintptr_t c = 10; c < 400; ++c)
+            {
+                crd.push_back(c);
+            }
+            pos.push_back(crd.size());
+            pos.push_back(crd.size());
+            crd.insert(crd.end(), { 0, 7, 1000 });
+            pos.push_back(crd.size());
+
+            std::mt19937_64 rng(42);
+            uintptr_t c = 0;
+            for (int j = 0; j < 300; ++j)
+            {
+                c += 1 + rng() % 50;
+                crd.push_back(c);
+            }
+            pos.push_back(crd.size());
+            for (uintptr_t c = 3; c < COLS; c += uintptr_t{ 5 } << 35)
+            {
+                crd.push_back(c);
+            }
+            pos.push_back(crd.size());
+        }
+    };
+}
+
+TEST_CASE("Packed-BaseCase")
+{
+    constexpr uint8_t ZERO = 0;
+    csr_matrix const m;
+    dense_t d{ ROWS };
+    csr_t c{ COLS, m.pos, m.crd };
+    packed_t p{ COLS, m.pos, m.crd };
+
+    // the run of consecutive columns takes no bits, so mostly the random row is packed
+    CHECK(p.get_words().size() * 64 < m.crd.size() * 8);
+
+    for (auto const [i1, p1] : d.iter_helper(std::make_tuple(), ZERO))
+    {
+        std::vector<std::pair<uintptr_t, uintptr_t>> expected, result, reversed;
+        for (auto const [i2, p2] : c.iter_helper(std::make_tuple(i1), p1))
+        {
+            expected.emplace_back(i2, p2);
+        }
+        auto const helper = p.iter_helper(std::make_tuple(i1), p1);
+        for (auto const [i2, p2] : helper)
+        {
+            result.emplace_back(i2, p2);
+        }
+        CHECK(result == expected);
+        CHECK(helper.end() - helper.begin() == static_cast<std::ptrdiff_t>(expected.size()));
+
+        for (auto it = helper.end(); it != helper.begin();)
+        {
+            --it;
+            auto const [i2, p2] = *it;
+            reversed.emplace_back(i2, p2);
+        }
+        std::reverse(reversed.begin(), reversed.end());
+        CHECK(reversed == expected);
+
+        // random access decodes the coordinate at the new position
+        for (std::size_t k = 0; k < expected.size(); k += 37)
+        {
+            auto it = helper.begin();
+            it += static_cast<std::ptrdiff_t>(k);
+            CHECK(std::get<0>(*it) == expected[k].first);
+        }
+
+        // and blocks decode to the same coordinates
+        std::vector<uintptr_t> decoded;
+        uintptr_t block[packed_t::BLOCK_SIZE];
+        for (std::size_t k = 0; decoded.size() < expected.size(); ++k)
+        {
+            auto const n = p.decode(p1, k, block);
+            decoded.insert(decoded.end(), block, block + n);
+        }
+        CHECK(decoded.size() == expected.size());
+        for (std::size_t k = 0; k < decoded.size(); ++k)
+        {
+            CHECK(decoded[k] == expected[k].first);
+        }
+    }
+}
+
+TEST_CASE("Packed-Seek")
+{
+    csr_matrix const m;
+    packed_t p{ COLS, m.pos, m.crd };
+
+    for (uintptr_t r = 0; r < ROWS; ++r)
+    {
+        auto const first = m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[r]);
+        auto const last = m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[r + 1]);
+        auto const helper = p.iter_helper(std::make_tuple(r), r);
+        for (uintptr_t target : { uintptr_t{ 0 },
+                                  uintptr_t{ 8 },
+                                  uintptr_t{ 200 },
+                                  uintptr_t{ 399 },
+                                  uintptr_t{ 5000 },
+                                  uintptr_t{ 1 } << 36,
+                                  COLS })
+        {
+            auto it = helper.begin();
+            it.seek(target);
+            auto const expected = std::lower_bound(first, last, target);
+            if (expected == last)
+            {
+                CHECK(it == helper.end());
+            }
+            else
+            {
+                CHECK(std::get<0>(*it) == *expected);
+                CHECK(std::get<1>(*it) == static_cast<uintptr_t>(expected - m.crd.begin()));
+            }
+        }
+    }
+}
+
+TEST_CASE("Packed-Coiterate-SpMV")
+{
+    csr_matrix const m;
+    packed_t p{ COLS, m.pos, m.crd };
+    csr_t c{ COLS, m.pos, m.crd };
+
+    // intersecting the run of row 0 with the random row 3
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) && std::get<1>(t); };
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<packed_t, csr_t>,
+        std::tuple<uintptr_t>,
+        std::tuple<uintptr_t, uintptr_t>>
+        coiter(fn, p, c);
+    std::vector<uintptr_t> result, expected;
+    for (auto const [ik, pk_tuple] : coiter.coiter_helper(
+             std::make_tuple(uintptr_t{ 0 }), std::make_tuple(uintptr_t{ 0 }, uintptr_t{ 3 })))
+    {
+        CHECK(m.crd[*std::get<0>(pk_tuple)] == ik);
+        result.push_back(ik);
+    }
+    std::set_intersection(m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[0]),
+                          m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[1]),
+                          m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[3]),
+                          m.crd.begin() + static_cast<std::ptrdiff_t>(m.pos[4]),
+                          std::back_inserter(expected));
+    CHECK(!expected.empty());
+    CHECK(result == expected);
+
+    // SpMV over the rows with small columns
+    constexpr uintptr_t SMALL_ROWS = 4;
+    constexpr uintptr_t SMALL_COLS = 20000;
+    std::vector<uintptr_t> const pos(m.pos.begin(), m.pos.begin() + SMALL_ROWS + 1);
+    std::vector<uintptr_t> const crd(m.crd.begin(),
+                                     m.crd.begin() + static_cast<std::ptrdiff_t>(pos.back()));
+    std::vector<double> data(crd.size());
+    for (std::size_t k = 0; k < data.size(); ++k)
+    {
+        data[k] = static_cast<double>(k % 7) - 3.0;
+    }
+    std::vector<double> x(SMALL_COLS);
+    for (std::size_t k = 0; k < x.size(); ++k)
+    {
+        x[k] = static_cast<double>(k % 5);
+    }
+
+    dense_t d1{ SMALL_ROWS };
+    csr_t c2{ SMALL_COLS, pos, crd };
+    packed_t p2{ SMALL_COLS, pos, crd };
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> A(d1, c2, data);
+    xsparse::Tensor<std::tuple<dense_t, packed_t>, std::vector<double>> B(d1, p2, data);
+    std::vector<double> y_csr(SMALL_ROWS, -1.0), y_packed(SMALL_ROWS, -1.0);
+    xsparse::kernels::spmv(A, x, y_csr);
+    xsparse::kernels::spmv(B, x, y_packed);
+    CHECK(y_packed == y_csr);
+}
+
+TEST_CASE("Packed-Assembly")
+{
+    constexpr uint8_t ZERO = 0;
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> entries;
+    for (uintptr_t r : { 0, 2, 4 })
+    {
+        for (uintptr_t col = r; col < 1000; col += 3 + r)
+        {
+            entries.emplace_back(r, col, static_cast<double>(entries.size()));
+        }
+    }
+
+    dense_t d1{ ROWS };
+    packed_t l2{ 1000 };
+    std::vector<double> data;
+    xsparse::level_capabilities::Assemble<std::tuple<dense_t, packed_t>, decltype(data)> assemble(
+        d1, l2, data);
+    assemble.append(entries.begin(), entries.end());
+    assemble.finalize();
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+    for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : l2.iter_helper(std::make_tuple(i1), p1))
+        {
+            result.emplace_back(i1, i2, data[p2]);
+        }
+    }
+    CHECK(result == entries);
+}
@@ -0,0 +1,123 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/parallel.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+TEST_CASE("WorkStealingPool")
+{
+    xsparse::util::work_stealing_pool pool(4);
+    CHECK(pool.size() == 4);
+
+    // every task runs exactly once, including tasks of a nested batch
+    std::vector<std::atomic<int>> runs(1000);
+    pool.parallel_for(runs.size() / 10,
+                      [&](std::size_t t)
+                      {
+                          pool.parallel_for(10, [&](std::size_t u) { ++runs[10 * t + u]; });
+                      });
+    for (auto const& r : runs)
+    {
+        CHECK(r == 1);
+    }
+
+    CHECK_THROWS_AS(pool.parallel_for(100,
+                                      [](std::size_t t)
+                                      {
+                                          if (t == 42)
+                                          {
+                                              throw std::runtime_error("task failed");
+                                          }
+                                      }),
+                    std::runtime_error);
+
+    // the pool is still usable after a failed batch
+    std::atomic<std::size_t> sum = 0;
+    pool.parallel_for(100, [&](std::size_t t) { sum += t; });
+    CHECK(sum == 4950);
+}
+
+TEST_CASE("ParallelForEachNonzero-CSR")
+{
+    // rows of very different lengths, so the chunks are cut by the number of nonzeros
+    constexpr uintptr_t ROWS = 200;
+    constexpr uintptr_t COLS = 300;
+
+    std::vector<uintptr_t> pos{ 0 };
+    std::vector<uintptr_t> crd;
+    for (uintptr_t r = 0; r < ROWS; ++r)
+    {
+        uintptr_t const len = r % 10 == 0 ? COLS : r % 3;
+        for (uintptr_t c = 0; c < len; ++c)
+        {
+            crd.push_back(COLS - len + c);
+        }
+        pos.push_back(crd.size());
+    }
+    std::vector<double> data(crd.size(), 1.0);
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ ROWS };
+    xsparse::levels::compressed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> c2{ COLS,
+                                                                                    pos,
+                                                                                    crd };
+    xsparse::Tensor<std::tuple<decltype(d1), decltype(c2)>, decltype(data)> t(d1, c2, data);
+
+    xsparse::util::work_stealing_pool pool(4);
+    // assertions are not made from the worker threads, mismatches are counted instead
+    std::vector<std::atomic<int>> visits(crd.size());
+    std::atomic<int> mismatches = 0;
+    xsparse::parallel_for_each_nonzero(
+        t,
+        [&](std::tuple<uintptr_t, uintptr_t> const& coords, double& value)
+        {
+            auto const p = static_cast<std::size_t>(&value - data.data());
+            auto const [i, j] = coords;
+            if (p < pos[i] || p >= pos[i + 1] || crd[p] != j)
+            {
+                ++mismatches;
+            }
+            ++visits[p];
+            value *= 2;
+        },
+        pool);
+
+    CHECK(mismatches == 0);
+    for (std::size_t p = 0; p < crd.size(); ++p)
+    {
+        CHECK(visits[p] == 1);
+        CHECK(data[p] == 2.0);
+    }
+}
+
+TEST_CASE("ParallelForEachNonzero-COO")
+{
+    constexpr uintptr_t SIZE = 100;
+
+    std::vector<uintptr_t> const pos{ 0, 7 };
+    std::vector<uintptr_t> const crd1{ 0, 0, 1, 1, 3, 3, 3 };
+    std::vector<uintptr_t> const crd2{ 0, 1, 0, 1, 0, 3, 4 };
+    std::vector<int> data{ 1, 2, 3, 4, 5, 6, 7 };
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> c{ SIZE, pos, crd1 };
+    xsparse::levels::singleton<std::tuple<decltype(c)>, uintptr_t, uintptr_t> s{ SIZE, crd2 };
+    xsparse::Tensor<std::tuple<decltype(c), decltype(s)>, decltype(data)> t(c, s, data);
+
+    std::atomic<int> sum = 0;
+    std::atomic<uintptr_t> coord_sum = 0;
+    xsparse::parallel_for_each_nonzero(t,
+                                       [&](auto const& coords, int const& value)
+                                       {
+                                           sum += value;
+                                           coord_sum += std::get<0>(coords) + std::get<1>(coords);
+                                       });
+    CHECK(sum == 28);
+    CHECK(coord_sum == 20);
+}
@@ -0,0 +1,165 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/sell.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/kernels/spmv.hpp>
+#include <xsparse/level_capabilities/co_iteration.hpp>
+
+namespace
+{
+    constexpr uintptr_t ROWS = 11;
+    constexpr uintptr_t COLS = 20;
+
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using sell_t = xsparse::levels::
+        sell<std::tuple<dense_t>, uintptr_t, uintptr_t, std::integral_constant<std::size_t, 4>>;
+
+    // rows of lengths 0 to 10 in a scrambled order, with every other column of a window
+    struct csr_matrix
+    {
+        std::vector<uintptr_t> pos{ 0 };
+        std::vector<uintptr_t> crd;
+        std::vector<double> data;
+
+        csr_matrix()
+        {
+            for (uintptr_t r = 0; r < ROWS; ++r)
+            {
+                uintptr_t const len = (r * 7) % ROWS;
+                for (uintptr_t j = 0; j < len; ++j)
+                {
+                    crd.push_back((r + 2 * j) % COLS);
+                    data.push_back(static_cast<double>(crd.size()));
+                }
+                std::sort(crd.end() - static_cast<std::ptrdiff_t>(len), crd.end());
+                pos.push_back(crd.size());
+            }
+        }
+    };
+}
+
+TEST_CASE("SELL-BaseCase")
+{
+    constexpr uint8_t ZERO = 0;
+    csr_matrix const m;
+    dense_t d{ ROWS };
+    csr_t c{ COLS, m.pos, m.crd };
+
+    for (std::size_t sigma : { 1, 4, 8, 64 })
+    {
+        sell_t s{ COLS, m.pos, m.crd, sigma };
+        auto const data = s.pack(m.data);
+        CHECK(s.num_slices() == 3);
+        CHECK(data.size() == s.get_crd().size());
+
+        // every row holds the same coordinates and values as in CSR
+        for (auto const [i1, p1] : d.iter_helper(std::make_tuple(), ZERO))
+        {
+            std::vector<std::pair<uintptr_t, double>> expected, result;
+            for (auto const [i2, p2] : c.iter_helper(std::make_tuple(i1), p1))
+            {
+                expected.emplace_back(i2, m.data[p2]);
+            }
+            auto const helper = s.iter_helper(std::make_tuple(i1), p1);
+            for (auto const [i2, p2] : helper)
+            {
+                result.emplace_back(i2, data[p2]);
+            }
+            CHECK(result == expected);
+            CHECK(helper.end() - helper.begin() == static_cast<std::ptrdiff_t>(expected.size()));
+        }
+    }
+
+    // sorting within windows of all rows removes the padding of the longest slice
+    sell_t unsorted{ COLS, m.pos, m.crd, 1 };
+    sell_t sorted{ COLS, m.pos, m.crd, 64 };
+    CHECK(sorted.get_crd().size() < unsorted.get_crd().size());
+}
+
+TEST_CASE("SELL-Seek-Coiterate")
+{
+    constexpr uint8_t ZERO = 0;
+    csr_matrix const m;
+    sell_t s{ COLS, m.pos, m.crd, 8 };
+    csr_t c{ COLS, m.pos, m.crd };
+
+    // row 3 has the coordinates 3, 5, ..., 19
+    auto const helper = s.iter_helper(std::make_tuple(uintptr_t{ 3 }), uintptr_t{ 3 });
+    auto it = helper.begin();
+    it.seek(10);
+    CHECK(std::get<0>(*it) == 11);
+    it.seek(20);
+    CHECK(it == helper.end());
+
+    // intersecting row 3 of the SELL matrix with row 5 of the CSR matrix
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) && std::get<1>(t); };
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<sell_t, csr_t>,
+        std::tuple<uintptr_t>,
+        std::tuple<uintptr_t, uintptr_t>>
+        coiter(fn, s, c);
+
+    std::vector<uintptr_t> result;
+    for (auto const [ik, pk_tuple] : coiter.coiter_helper(
+             std::make_tuple(uintptr_t{ 3 }), std::make_tuple(uintptr_t{ 3 }, uintptr_t{ 5 })))
+    {
+        result.push_back(ik);
+    }
+    std::vector<uintptr_t> expected;
+    for (uintptr_t p = m.pos[3]; p < m.pos[4]; ++p)
+    {
+        if (std::binary_search(m.crd.begin() + m.pos[5], m.crd.begin() + m.pos[6], m.crd[p]))
+        {
+            expected.push_back(m.crd[p]);
+        }
+    }
+    CHECK(!expected.empty());
+    CHECK(result == expected);
+    static_cast<void>(ZERO);
+}
+
+TEST_CASE("SELL-SpMV")
+{
+    csr_matrix m;
+    dense_t d1{ ROWS };
+    csr_t c2{ COLS, m.pos, m.crd };
+    sell_t s2{ COLS, m.pos, m.crd, 8 };
+    auto sell_data = s2.pack(m.data);
+
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> A(d1, c2, m.data);
+    xsparse::Tensor<std::tuple<dense_t, sell_t>, std::vector<double>> B(d1, s2, sell_data);
+
+    std::vector<double> x(COLS);
+    for (std::size_t i = 0; i < COLS; ++i)
+    {
+        x[i] = 1.0 + static_cast<double>(i % 3);
+    }
+    std::vector<double> y_csr(ROWS, -1.0), y_sell(ROWS, -1.0);
+    xsparse::kernels::spmv(A, x, y_csr);
+    xsparse::kernels::spmv(B, x, y_sell);
+    CHECK(y_sell == y_csr);
+
+    // `for_each` follows the interleaved positions as well
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> from_csr, from_sell;
+    A.for_each([&](auto const& ij, double v)
+               { from_csr.emplace_back(std::get<0>(ij), std::get<1>(ij), v); });
+    B.for_each([&](auto const& ij, double v)
+               { from_sell.emplace_back(std::get<0>(ij), std::get<1>(ij), v); });
+    CHECK(from_sell == from_csr);
+}
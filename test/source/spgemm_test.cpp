@@ -0,0 +1,168 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/kernels/spgemm.hpp>
+
+namespace
+{
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using tensor_t = xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>>;
+
+    // a random `rows x cols` matrix with small integer values in the first `used_cols` columns,
+    // also stored densely
+    struct random_matrix
+    {
+        std::size_t rows, cols;
+        std::vector<double> dense;
+        std::vector<uintptr_t> pos{ 0 };
+        std::vector<uintptr_t> crd;
+        std::vector<double> data;
+
+        random_matrix(std::size_t rows,
+                      std::size_t cols,
+                      double density,
+                      unsigned seed,
+                      std::size_t used_cols = 0)
+            : rows(rows)
+            , cols(cols)
+            , dense(rows * cols)
+        {
+            std::mt19937 rng(seed);
+            std::bernoulli_distribution present(density);
+            std::uniform_int_distribution<int> value(1, 9);
+            for (std::size_t r = 0; r < rows; ++r)
+            {
+                for (std::size_t c = 0; c < (used_cols == 0 ? cols : used_cols); ++c)
+                {
+                    if (present(rng))
+                    {
+                        dense[r * cols + c] = value(rng);
+                        crd.push_back(c);
+                        data.push_back(dense[r * cols + c]);
+                    }
+                }
+                pos.push_back(crd.size());
+            }
+        }
+    };
+
+    // multiplies `a` and `b` with `spgemm` and compares `C` to the dense product
+    void check_spgemm(random_matrix const& a,
+                      random_matrix const& b,
+                      xsparse::util::work_stealing_pool& pool)
+    {
+        dense_t rows_a{ a.rows }, rows_b{ b.rows }, rows_c{ a.rows };
+        csr_t cols_a{ a.cols, a.pos, a.crd }, cols_b{ b.cols, b.pos, b.crd }, cols_c{ b.cols };
+        auto data_a = a.data;
+        auto data_b = b.data;
+        std::vector<double> data_c;
+        tensor_t A(rows_a, cols_a, data_a), B(rows_b, cols_b, data_b), C(rows_c, cols_c, data_c);
+
+        xsparse::kernels::spgemm(A, B, C, pool);
+
+        std::vector<double> expected(a.rows * b.cols), result(a.rows * b.cols);
+        std::size_t expected_nnz = 0;
+        for (std::size_t r = 0; r < a.rows; ++r)
+        {
+            for (std::size_t c = 0; c < b.cols; ++c)
+            {
+                bool structural = false;
+                for (std::size_t k = 0; k < a.cols; ++k)
+                {
+                    if (a.dense[r * a.cols + k] != 0 && b.dense[k * b.cols + c] != 0)
+                    {
+                        structural = true;
+                        expected[r * b.cols + c]
+                            += a.dense[r * a.cols + k] * b.dense[k * b.cols + c];
+                    }
+                }
+                expected_nnz += structural;
+            }
+        }
+
+        CHECK(cols_c.get_pos().size() == a.rows + 1);
+        CHECK(data_c.size() == expected_nnz);
+        for (std::size_t r = 0; r < a.rows; ++r)
+        {
+            for (auto p = cols_c.get_pos()[r]; p < cols_c.get_pos()[r + 1]; ++p)
+            {
+                // sorted columns without duplicates
+                if (p > cols_c.get_pos()[r])
+                {
+                    CHECK(cols_c.get_crd()[p - 1] < cols_c.get_crd()[p]);
+                }
+                result[r * b.cols + cols_c.get_crd()[p]] = data_c[p];
+            }
+        }
+        CHECK(result == expected);
+    }
+}
+
+TEST_CASE("SpGEMM-Dense-Accumulator")
+{
+    // few columns, so that most rows have as many products as columns
+    xsparse::util::work_stealing_pool pool(3);
+    random_matrix const a(50, 40, 0.2, 1);
+    random_matrix const b(40, 30, 0.3, 2);
+    check_spgemm(a, b, pool);
+}
+
+TEST_CASE("SpGEMM-Dense-Accumulator-Sorted")
+{
+    // many products into a few of many columns, which are sorted rather than scanned
+    xsparse::util::work_stealing_pool pool(2);
+    random_matrix const a(30, 40, 0.5, 9);
+    random_matrix const b(40, 4000, 0.5, 10, 200);
+    check_spgemm(a, b, pool);
+}
+
+TEST_CASE("SpGEMM-Hash-Accumulator")
+{
+    // many columns and short rows, and a few empty rows of `A` and `B`
+    xsparse::util::work_stealing_pool pool(3);
+    random_matrix const a(60, 200, 0.01, 3);
+    random_matrix const b(200, 2000, 0.005, 4);
+    check_spgemm(a, b, pool);
+}
+
+TEST_CASE("SpGEMM-Serial-Empty")
+{
+    xsparse::util::work_stealing_pool pool(1);
+    random_matrix const a(20, 10, 0.3, 5);
+    random_matrix const b(10, 500, 0.02, 6);
+    check_spgemm(a, b, pool);
+
+    random_matrix const empty(10, 10, 0.0, 7);
+    check_spgemm(empty, empty, pool);
+}
+
+TEST_CASE("SpGEMM-Shapes")
+{
+    random_matrix const a(4, 5, 0.5, 8);
+    dense_t rows_a{ 4 }, rows_b{ 6 }, rows_c{ 4 };
+    csr_t cols_a{ 5, a.pos, a.crd }, cols_b{ 3 }, cols_c{ 3 };
+    auto data_a = a.data;
+    std::vector<double> data_b, data_c;
+    tensor_t A(rows_a, cols_a, data_a), B(rows_b, cols_b, data_b), C(rows_c, cols_c, data_c);
+    CHECK_THROWS_AS(xsparse::kernels::spgemm(A, B, C), std::invalid_argument);
+
+    // and a result that is not empty
+    dense_t rows_b5{ 5 };
+    std::vector<uintptr_t> pos_b(6, 0);
+    csr_t cols_b5{ 3, pos_b, {} };
+    tensor_t B5(rows_b5, cols_b5, data_b);
+    data_c.push_back(1.0);
+    CHECK_THROWS_AS(xsparse::kernels::spgemm(A, B5, C), std::invalid_argument);
+}
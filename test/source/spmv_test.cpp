@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/kernels/spmv.hpp>
+
+namespace
+{
+    // a random CSR matrix with rows of every length from 0 to `ROWS - 1`, so that the SIMD
+    // main loops and the scalar tails are all exercised
+    template <class IK, class V>
+    void check_spmv()
+    {
+        constexpr std::size_t ROWS = 40;
+        constexpr std::size_t COLS = 64;
+        constexpr uint8_t ZERO = 0;
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> value(-8, 8);
+
+        std::vector<IK> pos{ 0 };
+        std::vector<IK> crd;
+        std::vector<V> data;
+        for (std::size_t r = 0; r < ROWS; ++r)
+        {
+            for (std::size_t c = 0; c < r; ++c)
+            {
+                crd.push_back(static_cast<IK>((c * COLS) / ROWS + r % 2));
+                data.push_back(static_cast<V>(value(rng)));
+            }
+            pos.push_back(static_cast<IK>(crd.size()));
+        }
+
+        std::vector<V> x(COLS);
+        for (auto& xi : x)
+        {
+            xi = static_cast<V>(value(rng));
+        }
+
+        xsparse::levels::dense<std::tuple<>, IK, IK> d1{ ROWS };
+        xsparse::levels::compressed<std::tuple<decltype(d1)>, IK, IK> c2{ COLS, pos, crd };
+        xsparse::Tensor<std::tuple<decltype(d1), decltype(c2)>, std::vector<V>> A(d1, c2, data);
+
+        std::vector<V> expected(ROWS, 0);
+        for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+        {
+            for (auto const [i2, p2] : c2.iter_helper(std::make_tuple(i1), p1))
+            {
+                expected[i1] += data[p2] * x[i2];
+            }
+        }
+
+        std::vector<V> y(ROWS, -1);
+        xsparse::kernels::spmv(A, x, y);
+        // the values are small integers, so the sums are exact in any order
+        CHECK(y == expected);
+    }
+}
+
+TEST_CASE("SpMV-CSR")
+{
+    SUBCASE("double-uint64") { check_spmv<uint64_t, double>(); }
+    SUBCASE("double-uint32") { check_spmv<uint32_t, double>(); }
+    SUBCASE("float-uint32") { check_spmv<uint32_t, float>(); }
+    SUBCASE("int-uint16") { check_spmv<uint16_t, int>(); }
+}
@@ -0,0 +1,97 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/static_dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/version.h>
+#include <xsparse/level_properties.hpp>
+
+#include <xsparse/level_capabilities/assembly.hpp>
+#include <xsparse/level_capabilities/locate.hpp>
+
+namespace
+{
+    using four = std::integral_constant<std::size_t, 4>;
+}
+
+TEST_CASE("StaticDense-BaseCase")
+{
+    constexpr uintptr_t SIZE1 = 5;
+    constexpr uint8_t ZERO = 0;
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ SIZE1 };
+    xsparse::levels::dense<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> d2{ four::value };
+    xsparse::levels::static_dense<std::tuple<decltype(d1)>, uintptr_t, uintptr_t, four> s2;
+
+    // the same coordinates and positions as a runtime-size dense level
+    for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+    {
+        std::vector<std::pair<uintptr_t, uintptr_t>> expected, result;
+        for (auto const [i2, p2] : d2.iter_helper(std::make_tuple(i1), p1))
+        {
+            expected.emplace_back(i2, p2);
+        }
+        for (auto const [i2, p2] : s2.iter_helper(std::make_tuple(i1), p1))
+        {
+            result.emplace_back(i2, p2);
+        }
+        CHECK(result == expected);
+    }
+
+    // the size and positions are compile-time constants
+    static_assert(decltype(s2.size())::value == 4);
+    static_assert(decltype(s2)::SIZE == 4);
+    constexpr decltype(s2) cs2;
+    static_assert(cs2.coord_access(3, std::make_tuple(uintptr_t{ 0 }), 2).value() == 14);
+    static_assert(cs2.coord_bounds(std::make_tuple(uintptr_t{ 0 })).second == 4);
+    CHECK(s2.size() == d2.size());
+    CHECK(s2.size(SIZE1) == d2.size(SIZE1));
+
+    CHECK_NOTHROW(decltype(s2){ 4 });
+    CHECK_THROWS_AS(decltype(s2){ 3 }, std::invalid_argument);
+
+    static_assert(decltype(s2)::LevelProperties::is_full);
+    static_assert(!decltype(s2)::LevelProperties::is_branchless);
+    static_assert(decltype(s2)::LevelProperties::is_compact);
+    static_assert(!has_locate_v<decltype(s2)>);
+}
+
+TEST_CASE("StaticDense-Points")
+{
+    // three points of four components each below a compressed level
+    using points_t = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    using components_t
+        = xsparse::levels::static_dense<std::tuple<points_t>, uintptr_t, uintptr_t, four>;
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> entries;
+    for (uintptr_t point : { 2, 7, 9 })
+    {
+        for (uintptr_t c = 0; c < four::value; ++c)
+        {
+            entries.emplace_back(point, c, static_cast<double>(10 * point + c));
+        }
+    }
+
+    points_t l1{ 10 };
+    components_t l2;
+    std::vector<double> data;
+    xsparse::level_capabilities::Assemble<std::tuple<points_t, components_t>, decltype(data)>
+        assemble(l1, l2, data);
+    assemble.append(entries.begin(), entries.end());
+    assemble.finalize();
+    CHECK(data.size() == entries.size());
+
+    xsparse::Tensor<std::tuple<points_t, components_t>, std::vector<double>> A(l1, l2, data);
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> visited;
+    A.for_each([&](auto const& ij, double v)
+               { visited.emplace_back(std::get<0>(ij), std::get<1>(ij), v); });
+    CHECK(visited == entries);
+}
@@ -0,0 +1,231 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xsparse/coiterate.hpp>
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/version.h>
+
+namespace
+{
+    constexpr uintptr_t ROWS = 6;
+    constexpr uintptr_t COLS = 9;
+
+    using dense_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using csr_t = xsparse::levels::compressed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    using rows_t = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    using dcsr_t = xsparse::levels::compressed<std::tuple<rows_t>, uintptr_t, uintptr_t>;
+
+    using matrix = std::map<std::pair<uintptr_t, uintptr_t>, double>;
+
+    // row 1 only in A, row 4 only in B, and rows 0, 2 and 5 overlapping in some columns
+    matrix const a{ { { 0, 0 }, 1.0 }, { { 0, 3 }, 2.0 }, { { 1, 2 }, 3.0 }, { { 2, 1 }, 4.0 },
+                    { { 2, 8 }, 5.0 }, { { 5, 4 }, 6.0 } };
+    matrix const b{ { { 0, 3 }, 10.0 }, { { 0, 7 }, 20.0 }, { { 2, 1 }, 30.0 },
+                    { { 2, 5 }, 40.0 }, { { 4, 0 }, 50.0 }, { { 5, 4 }, 60.0 } };
+    matrix const c{ { { 1, 2 }, 100.0 }, { { 3, 3 }, 200.0 }, { { 5, 4 }, 300.0 } };
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> entries(matrix const& m)
+    {
+        std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+        for (auto const& [ij, v] : m)
+        {
+            result.emplace_back(ij.first, ij.second, v);
+        }
+        return result;
+    }
+
+    template <class Outer, class Inner>
+    struct stored_matrix
+    {
+        Outer l1{ ROWS };
+        Inner l2{ COLS };
+        std::vector<double> data;
+        xsparse::Tensor<std::tuple<Outer, Inner>, std::vector<double>> tensor{ l1, l2, data };
+
+        explicit stored_matrix(matrix const& m)
+        {
+            auto const e = entries(m);
+            tensor.assemble(e.begin(), e.end());
+        }
+    };
+}
+
+TEST_CASE("TensorCoiterate-Add")
+{
+    stored_matrix<dense_t, csr_t> A(a);
+    stored_matrix<rows_t, dcsr_t> B(b);
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) || std::get<1>(t); };
+    matrix result;
+    std::vector<std::pair<uintptr_t, uintptr_t>> order;
+    xsparse::coiterate(fn,
+                       [&](auto const& ij, auto const& values)
+                       {
+                           auto const& [va, vb] = values;
+                           auto const key = std::make_pair(std::get<0>(ij), std::get<1>(ij));
+                           CHECK((va.has_value() == (a.count(key) == 1)));
+                           CHECK((vb.has_value() == (b.count(key) == 1)));
+                           result[key] = (va ? va->get() : 0.0) + (vb ? vb->get() : 0.0);
+                           order.push_back(key);
+                       },
+                       A.tensor,
+                       B.tensor);
+
+    matrix expected = a;
+    for (auto const& [ij, v] : b)
+    {
+        expected[ij] += v;
+    }
+    CHECK(result == expected);
+    CHECK(order.size() == expected.size());
+    // in the order of the levels
+    CHECK(std::is_sorted(order.begin(), order.end()));
+}
+
+TEST_CASE("TensorCoiterate-Multiply")
+{
+    stored_matrix<dense_t, csr_t> A(a);
+    stored_matrix<rows_t, dcsr_t> B(b);
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) && std::get<1>(t); };
+    matrix result;
+    xsparse::coiterate(fn,
+                       [&](auto const& ij, auto const& values)
+                       {
+                           auto const& [va, vb] = values;
+                           REQUIRE(va.has_value());
+                           REQUIRE(vb.has_value());
+                           result[{ std::get<0>(ij), std::get<1>(ij) }] = va->get() * vb->get();
+                       },
+                       A.tensor,
+                       B.tensor);
+
+    matrix const expected{ { { 0, 3 }, 20.0 }, { { 2, 1 }, 120.0 }, { { 5, 4 }, 360.0 } };
+    CHECK(result == expected);
+
+    // and the values can be written through
+    xsparse::coiterate(
+        fn,
+        [](auto const&, auto const& values) { std::get<0>(values)->get() = -1.0; },
+        A.tensor,
+        B.tensor);
+    CHECK(A.data == std::vector<double>{ 1.0, -1.0, 3.0, -1.0, 5.0, -1.0 });
+}
+
+TEST_CASE("TensorCoiterate-Locate")
+{
+    // a conjunction with a hashed level locates the coordinates of the compressed one
+    using hashed_t = xsparse::levels::hashed<std::tuple<dense_t>, uintptr_t, uintptr_t>;
+    stored_matrix<dense_t, csr_t> A(a);
+    stored_matrix<dense_t, hashed_t> B(b);
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) && std::get<1>(t); };
+    matrix result;
+    xsparse::coiterate(
+        fn,
+        [&](auto const& ij, auto const& values)
+        {
+            result[{ std::get<0>(ij), std::get<1>(ij) }]
+                = std::get<0>(values)->get() * std::get<1>(values)->get();
+        },
+        A.tensor,
+        B.tensor);
+
+    matrix const expected{ { { 0, 3 }, 20.0 }, { { 2, 1 }, 120.0 }, { { 5, 4 }, 360.0 } };
+    CHECK(result == expected);
+}
+
+TEST_CASE("TensorCoiterate-Three")
+{
+    stored_matrix<dense_t, csr_t> A(a);
+    stored_matrix<rows_t, dcsr_t> B(b);
+    stored_matrix<rows_t, dcsr_t> C(c);
+
+    // A * B + C
+    auto fn = [](std::tuple<bool, bool, bool> t) constexpr
+    { return (std::get<0>(t) && std::get<1>(t)) || std::get<2>(t); };
+    matrix result;
+    xsparse::coiterate(fn,
+                       [&](auto const& ij, auto const& values)
+                       {
+                           auto const& [va, vb, vc] = values;
+                           double v = vc ? vc->get() : 0.0;
+                           if (va && vb)
+                           {
+                               v += va->get() * vb->get();
+                           }
+                           result[{ std::get<0>(ij), std::get<1>(ij) }] = v;
+                       },
+                       A.tensor,
+                       B.tensor,
+                       C.tensor);
+
+    matrix const expected{ { { 0, 3 }, 20.0 },
+                           { { 1, 2 }, 100.0 },
+                           { { 2, 1 }, 120.0 },
+                           { { 3, 3 }, 200.0 },
+                           { { 5, 4 }, 660.0 } };
+    CHECK(result == expected);
+}
+
+TEST_CASE("TensorCoiterate-Four")
+{
+    // the largest number of operands, in a disjunction, which visits every combination of them
+    stored_matrix<dense_t, csr_t> A(a);
+    stored_matrix<rows_t, dcsr_t> B(b);
+    stored_matrix<rows_t, dcsr_t> C(c);
+    stored_matrix<dense_t, csr_t> D(c);
+
+    auto fn = [](std::tuple<bool, bool, bool, bool> t) constexpr
+    { return std::get<0>(t) || std::get<1>(t) || std::get<2>(t) || std::get<3>(t); };
+    matrix result;
+    xsparse::coiterate(fn,
+                       [&](auto const& ij, auto const& values)
+                       {
+                           double v = 0.0;
+                           std::apply([&](auto const&... vs)
+                                      { ((v += vs ? vs->get() : 0.0), ...); },
+                                      values);
+                           result[{ std::get<0>(ij), std::get<1>(ij) }] = v;
+                       },
+                       A.tensor,
+                       B.tensor,
+                       C.tensor,
+                       D.tensor);
+
+    matrix expected = a;
+    for (auto const* m : { &b, &c, &c })
+    {
+        for (auto const& [ij, v] : *m)
+        {
+            expected[ij] += v;
+        }
+    }
+    CHECK(result == expected);
+}
+
+TEST_CASE("TensorCoiterate-Sizes")
+{
+    stored_matrix<dense_t, csr_t> A(a);
+    dense_t l1{ ROWS };
+    csr_t l2{ COLS + 1 };
+    std::vector<double> data;
+    xsparse::Tensor<std::tuple<dense_t, csr_t>, std::vector<double>> B(l1, l2, data);
+    auto const e = entries(b);
+    B.assemble(e.begin(), e.end());
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) || std::get<1>(t); };
+    CHECK_THROWS_AS(xsparse::coiterate(fn, [](auto const&, auto const&) {}, A.tensor, B),
+                    std::invalid_argument);
+}
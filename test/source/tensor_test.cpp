@@ -1,5 +1,11 @@
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <xsparse/version.h>
 #include <xsparse/tensor.hpp>
 
@@ -55,3 +61,81 @@ TEST_CASE("Multiple-levels-Tensor")
     CHECK(std::get<2>(t1.get_levels()).size() == SIZE1);
     CHECK(std::is_same_v<decltype(t1)::dtype, double>);
 }
+
+TEST_CASE("Tensor-ForEach")
+{
+    using entry = std::tuple<uintptr_t, uintptr_t, double>;
+
+    SUBCASE("CSR")
+    {
+        std::vector<uintptr_t> const pos{ 0, 2, 3, 3, 6 };
+        std::vector<uintptr_t> const crd{ 1, 7, 3, 0, 4, 9 };
+        std::vector<double> data{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+        xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ 4 };
+        xsparse::levels::compressed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> c2{ 10,
+                                                                                         pos,
+                                                                                         crd };
+        xsparse::Tensor<std::tuple<decltype(d1), decltype(c2)>, decltype(data)> t(d1, c2, data);
+
+        std::vector<entry> result;
+        t.for_each(
+            [&](auto const& coords, double& value)
+            {
+                result.emplace_back(std::get<0>(coords), std::get<1>(coords), value);
+                value *= 2;
+            });
+        std::vector<entry> const expected{ { 0, 1, 1.0 }, { 0, 7, 2.0 }, { 1, 3, 3.0 },
+                                           { 3, 0, 4.0 }, { 3, 4, 5.0 }, { 3, 9, 6.0 } };
+        CHECK(result == expected);
+        CHECK(data == std::vector<double>{ 2.0, 4.0, 6.0, 8.0, 10.0, 12.0 });
+    }
+
+    SUBCASE("COO-3D")
+    {
+        std::vector<uintptr_t> const pos{ 0, 4 };
+        std::vector<uintptr_t> const crd1{ 0, 0, 2, 3 };
+        std::vector<uintptr_t> const crd2{ 1, 4, 0, 0 };
+        std::vector<uintptr_t> const crd3{ 5, 2, 2, 7 };
+        std::vector<int> data{ 1, 2, 3, 4 };
+        xsparse::levels::compressed<std::tuple<>,
+                                    uintptr_t,
+                                    uintptr_t,
+                                    xsparse::util::container_traits<std::vector,
+                                                                    std::unordered_set,
+                                                                    std::unordered_map>,
+                                    xsparse::level_properties<true, true, false, false, true>>
+            c1{ 4, pos, crd1 };
+        xsparse::levels::singleton<std::tuple<decltype(c1)>, uintptr_t, uintptr_t> s2{ 5, crd2 };
+        xsparse::levels::singleton<std::tuple<decltype(s2), decltype(c1)>, uintptr_t, uintptr_t>
+            s3{ 8, crd3 };
+        xsparse::Tensor<std::tuple<decltype(c1), decltype(s2), decltype(s3)>, decltype(data)> t(
+            c1, s2, s3, data);
+
+        std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t, int>> result;
+        t.for_each([&](auto const& coords, int value)
+                   { result.emplace_back(std::tuple_cat(coords, std::make_tuple(value))); });
+        std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t, int>> const expected{
+            { 0, 1, 5, 1 }, { 0, 4, 2, 2 }, { 2, 0, 2, 3 }, { 3, 0, 7, 4 }
+        };
+        CHECK(result == expected);
+    }
+
+    SUBCASE("Dense-Hashed")
+    {
+        std::vector<std::unordered_map<uintptr_t, uintptr_t>> const crd{
+            { { 5, 2 }, { 1, 0 } }, {}, { { 3, 1 } }
+        };
+        std::vector<double> data{ 1.0, 2.0, 3.0 };
+        xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ 3 };
+        xsparse::levels::hashed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> h2{ 6, crd };
+        xsparse::Tensor<std::tuple<decltype(d1), decltype(h2)>, decltype(data)> t(d1, h2, data);
+
+        // hashed levels are unordered
+        std::vector<entry> result;
+        t.for_each([&](auto const& coords, double value)
+                   { result.emplace_back(std::get<0>(coords), std::get<1>(coords), value); });
+        std::sort(result.begin(), result.end());
+        std::vector<entry> const expected{ { 0, 1, 1.0 }, { 0, 5, 3.0 }, { 2, 3, 2.0 } };
+        CHECK(result == expected);
+    }
+}
@@ -0,0 +1,209 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/levels/hashed.hpp>
+#include <xsparse/levels/singleton.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/thread_pool.hpp>
+
+#include <xsparse/io/text.hpp>
+
+TEST_CASE("MatrixMarket-CSR")
+{
+    constexpr uint8_t ZERO = 0;
+
+    // MatrixMarket files list their entries column by column
+    std::string const text = "%%MatrixMarket matrix coordinate real general\n"
+                             "% a comment\n"
+                             "\n"
+                             "4 10 6\n"
+                             "4 1 4.0\n"
+                             "1 2 1\n"
+                             "2 4 +3e0\r\n"
+                             "  4 5 5.0\n"
+                             "1 8 2.0\n"
+                             "4 10 6.0";
+
+    auto list = xsparse::io::parse_matrix_market<uintptr_t, double>(text);
+    CHECK(list.shape == std::array<uintptr_t, 2>{ 4, 10 });
+    REQUIRE(list.entries.size() == 6);
+    CHECK(list.entries[0] == std::make_tuple(uintptr_t{ 3 }, uintptr_t{ 0 }, 4.0));
+    CHECK(list.entries[2] == std::make_tuple(uintptr_t{ 1 }, uintptr_t{ 3 }, 3.0));
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ list.shape[0] };
+    xsparse::levels::compressed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> c2{
+        list.shape[1]
+    };
+    std::vector<double> data;
+    xsparse::Tensor<std::tuple<decltype(d1), decltype(c2)>, decltype(data)> t(d1, c2, data);
+    xsparse::io::assemble(t, list);
+
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+    for (auto const [i1, p1] : d1.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : c2.iter_helper(std::make_tuple(i1), p1))
+        {
+            result.emplace_back(i1, i2, data[p2]);
+        }
+    }
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> const expected{
+        { 0, 1, 1.0 }, { 0, 7, 2.0 }, { 1, 3, 3.0 }, { 3, 0, 4.0 }, { 3, 4, 5.0 }, { 3, 9, 6.0 }
+    };
+    CHECK(result == expected);
+}
+
+TEST_CASE("MatrixMarket-Symmetry")
+{
+    SUBCASE("Symmetric-Pattern")
+    {
+        auto const list = xsparse::io::parse_matrix_market<uint32_t, int>(
+            "%%MatrixMarket matrix coordinate pattern symmetric\n"
+            "3 3 3\n"
+            "1 1\n"
+            "3 1\n"
+            "3 2\n");
+        std::vector<std::tuple<uint32_t, uint32_t, int>> const expected{
+            { 0, 0, 1 }, { 2, 0, 1 }, { 0, 2, 1 }, { 2, 1, 1 }, { 1, 2, 1 }
+        };
+        CHECK(list.entries == expected);
+    }
+
+    SUBCASE("Skew-Symmetric")
+    {
+        auto const list = xsparse::io::parse_matrix_market<uint32_t, double>(
+            "%%MatrixMarket MATRIX Coordinate Real Skew-Symmetric\n"
+            "2 2 1\n"
+            "2 1 -1.5\n");
+        std::vector<std::tuple<uint32_t, uint32_t, double>> const expected{ { 1, 0, -1.5 },
+                                                                            { 0, 1, 1.5 } };
+        CHECK(list.entries == expected);
+    }
+}
+
+TEST_CASE("FROSTT-COO-Chunked")
+{
+    constexpr uint8_t ZERO = 0;
+    constexpr uintptr_t SIZE = 50;
+    std::string const path = "xsparse_text_io_test.tns";
+
+    // enough lines to be parsed in several chunks, listed out of order, with blank and comment
+    // lines in between
+    std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t, double>> expected;
+    std::string text = "# a FROSTT tensor\n";
+    for (uintptr_t n = 0; n < 20000; ++n)
+    {
+        if (n % 997 == 0)
+        {
+            text += "\n# entry " + std::to_string(n) + "\n";
+        }
+        uintptr_t const i = (n * 7919) % SIZE;
+        uintptr_t const j = n % SIZE;
+        uintptr_t const k = n / (SIZE * SIZE);
+        expected.emplace_back(i, j, k, static_cast<double>(n));
+        text += std::to_string(i + 1) + "\t" + std::to_string(j + 1) + " " + std::to_string(k + 1)
+                + " " + std::to_string(n) + "\n";
+    }
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+
+    xsparse::util::work_stealing_pool pool(4);
+    auto list = xsparse::io::read_tns<3, uintptr_t, double>(path, pool);
+    std::remove(path.c_str());
+    CHECK(list.entries == expected);
+    CHECK(list.shape == std::array<uintptr_t, 3>{ SIZE, SIZE, 20000 / (SIZE * SIZE) });
+
+    xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t> c1{ list.shape[0] };
+    xsparse::levels::singleton<std::tuple<decltype(c1)>, uintptr_t, uintptr_t> s2{
+        list.shape[1]
+    };
+    xsparse::levels::singleton<std::tuple<decltype(s2), decltype(c1)>, uintptr_t, uintptr_t> s3{
+        list.shape[2]
+    };
+    std::vector<double> data;
+    xsparse::Tensor<std::tuple<decltype(c1), decltype(s2), decltype(s3)>, decltype(data)> t(
+        c1, s2, s3, data);
+    xsparse::io::assemble(t, list);
+
+    std::sort(expected.begin(), expected.end());
+    std::vector<std::tuple<uintptr_t, uintptr_t, uintptr_t, double>> result;
+    for (auto const [i1, p1] : c1.iter_helper(std::make_tuple(), ZERO))
+    {
+        for (auto const [i2, p2] : s2.iter_helper(std::make_tuple(i1), p1))
+        {
+            for (auto const [i3, p3] : s3.iter_helper(std::make_tuple(i2, i1), p2))
+            {
+                result.emplace_back(i1, i2, i3, data[p3]);
+            }
+        }
+    }
+    CHECK(result == expected);
+}
+
+TEST_CASE("FROSTT-Dense-Hashed")
+{
+    constexpr uint8_t ZERO = 0;
+
+    // hashed levels are inserted into, so the entries are not sorted
+    auto list = xsparse::io::parse_tns<2, uintptr_t, int>("3 5 1\n1 2 2\n3 1 3\n");
+    CHECK(list.shape == std::array<uintptr_t, 2>{ 3, 5 });
+
+    xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t> d1{ list.shape[0] };
+    xsparse::levels::hashed<std::tuple<decltype(d1)>, uintptr_t, uintptr_t> h2{ list.shape[1] };
+    std::vector<int> data;
+    xsparse::Tensor<std::tuple<decltype(d1), decltype(h2)>, decltype(data)> t(d1, h2, data);
+    xsparse::io::assemble(t, list);
+
+    CHECK(data[h2.locate(d1.coord_access(ZERO, std::make_tuple(), 2).value(), 4).value()] == 1);
+    CHECK(data[h2.locate(d1.coord_access(ZERO, std::make_tuple(), 0).value(), 1).value()] == 2);
+    CHECK(data[h2.locate(d1.coord_access(ZERO, std::make_tuple(), 2).value(), 0).value()] == 3);
+    CHECK(!h2.locate(d1.coord_access(ZERO, std::make_tuple(), 1).value(), 0).has_value());
+}
+
+TEST_CASE("TextIO-Invalid")
+{
+    using xsparse::io::parse_matrix_market;
+    using xsparse::io::parse_tns;
+
+    CHECK_THROWS_WITH((parse_matrix_market<uintptr_t, double>("%%MatrixMarket matrix array "
+                                                              "real general\n2 2\n")),
+                      "line 1: only the coordinate format is supported");
+    CHECK_THROWS_WITH((parse_matrix_market<uintptr_t, double>(
+                          "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n")),
+                      "line 3: coordinate out of range");
+    CHECK_THROWS_WITH((parse_matrix_market<uintptr_t, double>(
+                          "%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1.0\n")),
+                      "expected 2 entries");
+    // the number of entries is checked against the file rather than trusted
+    CHECK_THROWS_WITH((parse_matrix_market<uintptr_t, double>(
+                          "%%MatrixMarket matrix coordinate real symmetric\n"
+                          "2 2 18446744073709551615\n1 1 1.0\n")),
+                      "expected 18446744073709551615 entries");
+    CHECK_THROWS_WITH((parse_matrix_market<uintptr_t, int>(
+                          "%%MatrixMarket matrix coordinate integer general\n2 2 1\n1 1 1.5\n")),
+                      "line 3: expected a value");
+    CHECK_THROWS_WITH((parse_tns<3, uintptr_t, double>("1 1 1 1.0\n\n1 1 2.0\n")),
+                      "line 3: expected a coordinate for every dimension");
+    CHECK_THROWS_WITH((parse_tns<2, uintptr_t, double>("0 1 1.0\n")),
+                      "line 1: coordinate out of range");
+    // negative coordinates of a signed coordinate type are out of range as well
+    CHECK_THROWS_WITH((parse_tns<2, int, double>("1 1 1.0\n-3 2 1.0\n")),
+                      "line 2: coordinate out of range");
+    CHECK_THROWS_WITH((parse_matrix_market<int, double>(
+                          "%%MatrixMarket matrix coordinate integer general\n2 2 1\n-1 2 5\n")),
+                      "line 3: coordinate out of range");
+    CHECK_THROWS_AS((xsparse::io::read_tns<2, uintptr_t, double>("xsparse_no_such_file.tns")),
+                    std::runtime_error);
+}
@@ -0,0 +1,155 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xsparse/levels/compressed.hpp>
+#include <xsparse/levels/dense.hpp>
+#include <xsparse/tensor.hpp>
+#include <xsparse/util/template_utils.hpp>
+#include <xsparse/util/workspace.hpp>
+#include <xsparse/version.h>
+
+#include <xsparse/level_capabilities/co_iteration.hpp>
+
+namespace
+{
+    using entries_t = std::vector<std::pair<uintptr_t, double>>;
+
+    template <class IK, class V>
+    entries_t gather(xsparse::util::workspace<IK, V>& w)
+    {
+        entries_t result;
+        w.gather([&](IK ik, V v) { result.emplace_back(ik, v); });
+        return result;
+    }
+}
+
+TEST_CASE("Workspace-BaseCase")
+{
+    xsparse::util::workspace<uintptr_t, double> w(1000);
+    CHECK(w.size() == 1000);
+    CHECK(w.empty());
+
+    w.accumulate(700, 1.0);
+    w.accumulate(3, 2.0);
+    w.accumulate(700, 0.5);
+    w[42] += 4.0;
+    CHECK(w.nnz() == 3);
+    CHECK(w.contains(3));
+    CHECK(!w.contains(4));
+    CHECK(w.touched() == std::vector<uintptr_t>{ 700, 3, 42 });
+
+    // in the order of the first writes, and the values can be changed
+    entries_t visited;
+    w.for_each(
+        [&](uintptr_t ik, double& v)
+        {
+            visited.emplace_back(ik, v);
+            v *= 2;
+        });
+    CHECK(visited == entries_t{ { 700, 1.5 }, { 3, 2.0 }, { 42, 4.0 } });
+
+    // sorted, and cleared afterwards
+    CHECK(gather(w) == entries_t{ { 3, 4.0 }, { 42, 8.0 }, { 700, 3.0 } });
+    CHECK(w.empty());
+    CHECK(!w.contains(700));
+
+    // a reused coordinate starts from zero again
+    w[700] += 1.0;
+    CHECK(gather(w) == entries_t{ { 700, 1.0 } });
+
+    w.accumulate(5, 1.0);
+    w.clear();
+    CHECK(w.empty());
+    CHECK(gather(w).empty());
+}
+
+TEST_CASE("Workspace-Scan")
+{
+    // so many coordinates that they are scanned rather than sorted
+    xsparse::util::workspace<uint16_t, float> w(64);
+    entries_t expected;
+    for (uint16_t ik = 63; ik >= 20; ik -= 3)
+    {
+        w.accumulate(ik, static_cast<float>(ik));
+        expected.emplace(expected.begin(), ik, static_cast<double>(ik));
+    }
+    entries_t result;
+    w.gather([&](uint16_t ik, float v) { result.emplace_back(ik, v); });
+    CHECK(result == expected);
+    CHECK(w.empty());
+    for (uint16_t ik = 0; ik < 64; ++ik)
+    {
+        CHECK(!w.contains(ik));
+    }
+
+    w.resize(8);
+    CHECK(w.size() == 8);
+    w.accumulate(7, 1.0f);
+    CHECK(w.nnz() == 1);
+}
+
+TEST_CASE("Workspace-Coiterate-Append")
+{
+    // the sum of two rows, merged with `Coiterate`, appended as the rows of a CSR matrix
+    constexpr uintptr_t COLS = 10;
+    constexpr uint8_t ZERO = 0;
+    using compressed_t = xsparse::levels::compressed<std::tuple<>, uintptr_t, uintptr_t>;
+    std::vector<uintptr_t> const crd1{ 0, 4, 7 }, crd2{ 2, 4, 9 };
+    std::vector<double> const data1{ 1.0, 2.0, 3.0 }, data2{ 10.0, 20.0, 30.0 };
+    compressed_t c1{ COLS, { 0, 3 }, crd1 };
+    compressed_t c2{ COLS, { 0, 3 }, crd2 };
+
+    auto fn = [](std::tuple<bool, bool> t) constexpr { return std::get<0>(t) || std::get<1>(t); };
+    xsparse::level_capabilities::Coiterate<
+        xsparse::util::LambdaWrapper<decltype(fn)>::template apply,
+        decltype(fn),
+        uintptr_t,
+        uintptr_t,
+        std::tuple<compressed_t, compressed_t>,
+        std::tuple<>,
+        std::tuple<uint8_t, uint8_t>>
+        coiter(fn, c1, c2);
+
+    xsparse::util::workspace<uintptr_t, double> w(COLS);
+    auto const sum = [&](auto const& e)
+    {
+        auto const& [p1, p2] = std::get<1>(e);
+        return (p1 ? data1[*p1] : 0.0) + (p2 ? data2[*p2] : 0.0);
+    };
+
+    using rows_t = xsparse::levels::dense<std::tuple<>, uintptr_t, uintptr_t>;
+    using cols_t = xsparse::levels::compressed<std::tuple<rows_t>, uintptr_t, uintptr_t>;
+    rows_t rows{ 3 };
+    cols_t cols{ COLS };
+    std::vector<double> data;
+    cols.append_init(3);
+    for (uintptr_t r = 0; r < 3; ++r)
+    {
+        // the merged row, its double, and an empty row
+        if (r < 2)
+        {
+            w.scatter(coiter.coiter_helper(std::make_tuple(), std::make_tuple(ZERO, ZERO)), sum);
+        }
+        if (r == 1)
+        {
+            w.for_each([](uintptr_t, double& v) { v *= 2; });
+        }
+        w.append(cols, r, data);
+    }
+    cols.append_finalize(3);
+
+    CHECK(cols.get_pos() == std::vector<uintptr_t>{ 0, 5, 10, 10 });
+    xsparse::Tensor<std::tuple<rows_t, cols_t>, std::vector<double>> C(rows, cols, data);
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> result;
+    C.for_each([&](auto const& ij, double v)
+               { result.emplace_back(std::get<0>(ij), std::get<1>(ij), v); });
+    std::vector<std::tuple<uintptr_t, uintptr_t, double>> const expected{
+        { 0, 0, 1.0 },  { 0, 2, 10.0 }, { 0, 4, 22.0 }, { 0, 7, 3.0 },  { 0, 9, 30.0 },
+        { 1, 0, 2.0 },  { 1, 2, 20.0 }, { 1, 4, 44.0 }, { 1, 7, 6.0 },  { 1, 9, 60.0 }
+    };
+    CHECK(result == expected);
+}